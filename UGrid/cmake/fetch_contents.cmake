@@ -39,3 +39,37 @@ if(ENABLE_UNIT_TESTING)
 
   enable_testing()
 endif()
+
+if(ENABLE_BENCHMARKS)
+
+# Fetch google benchmark
+  set(benchmark_url "https://github.com/google/benchmark.git")
+  set(benchmark_tag "v1.9.0")
+  set(cmake_FetchContent_Populate_deprecation_version "3.30.0")
+
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL "${cmake_FetchContent_Populate_deprecation_version}")
+    FetchContent_Declare(
+      benchmark
+      GIT_REPOSITORY ${benchmark_url}
+      GIT_TAG ${benchmark_tag}
+      EXCLUDE_FROM_ALL # available from v3.28.0+
+    )
+    FetchContent_MakeAvailable(benchmark)
+  else()
+    FetchContent_Declare(
+      benchmark
+      GIT_REPOSITORY ${benchmark_url}
+      GIT_TAG ${benchmark_tag}
+    )
+    # deprecated
+    FetchContent_GetProperties(benchmark)
+    if(NOT benchmark_POPULATED)
+      FetchContent_Populate(benchmark)
+      add_subdirectory(${benchmark_SOURCE_DIR} ${benchmark_BINARY_DIR} EXCLUDE_FROM_ALL)
+    endif()
+  endif()
+endif()
@@ -83,6 +83,9 @@ check_runtime_dependency(hdf5_hl-shared SHARED_LIBRARY)
 check_runtime_dependency(ZLIB::ZLIB UNKNOWN_LIBRARY)
 check_runtime_dependency(CURL::libcurl SHARED_LIBRARY)
 
+# threads
+find_package(Threads REQUIRED)
+
 # cache the third-party runtime dependencies
 # It would be cool to use TARGET_RUNTIME_DLLS which is described here
 # https://cmake.org/cmake/help/latest/manual/cmake-generator-expressions.7.html#genex:TARGET_RUNTIME_DLLS
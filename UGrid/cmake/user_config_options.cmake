@@ -23,4 +23,25 @@ cmake_dependent_option(
   OFF
   "WIN32"
   OFF
-)
\ No newline at end of file
+)
+# netCDF thread-safety option
+option(
+  ENABLE_NETCDF_THREADSAFE
+  "Set when the netCDF library is built thread-safe, so that API calls on classic files are no longer serialized"
+  OFF
+)
+
+# benchmarks option
+option(
+  ENABLE_BENCHMARKS
+  "Enables building the benchmark executables"
+  OFF
+)
+
+# size of the largest synthetic mesh used by the benchmarks
+set(
+  BENCHMARKS_MAX_FACES
+  "1000000"
+  CACHE STRING
+  "The number of faces of the largest synthetic mesh used by the benchmarks (up to 100000000)"
+)
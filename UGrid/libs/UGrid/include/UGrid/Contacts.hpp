@@ -58,6 +58,7 @@ namespace ugrid
 
         /// @brief Defines the contact header (ug_write_mesh_arrays: ug_create_1d_mesh_v2, ug_def_mesh_ids)
         /// @param contacts [in] The contact api structure with the fields to write and all optional flags
+        /// @note The file is left in define mode, so several definitions can share one define phase
         void define(ugridapi::Contacts const& contacts);
 
         /// @brief Writes a contact to file
@@ -0,0 +1,113 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief A uniform bucket grid over the faces of a mesh2d, locating the face containing a point.
+    ///        Each bucket lists the faces whose bounding box overlaps it, so a query only tests the few faces of one bucket.
+    ///        In spherical coordinates the longitudes wrap around: the buckets span 360 degrees from the smallest node longitude,
+    ///        and faces crossing the wrap are registered in the buckets at both ends
+    class FaceLocator
+    {
+    public:
+        /// @brief Constructor, copies the mesh and builds the buckets in parallel
+        /// @param node_x [in] The node x coordinates (longitudes if spherical)
+        /// @param node_y [in] The node y coordinates (latitudes if spherical)
+        /// @param num_nodes [in] The number of nodes
+        /// @param face_nodes [in] The face nodes, num_face_nodes_max per face, padded with the fill value
+        /// @param num_faces [in] The number of faces
+        /// @param num_face_nodes_max [in] The maximum number of nodes per face
+        /// @param start_index [in] The start index of the face nodes, also used for the located faces
+        /// @param fill_value [in] The fill value of the face nodes, also returned for points outside the mesh
+        /// @param is_spherical [in] Whether the coordinates are longitudes and latitudes
+        /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+        FaceLocator(double const* node_x,
+                    double const* node_y,
+                    size_t num_nodes,
+                    int const* face_nodes,
+                    size_t num_faces,
+                    size_t num_face_nodes_max,
+                    int start_index,
+                    int fill_value,
+                    bool is_spherical,
+                    size_t max_threads);
+
+        /// @brief Locates the face containing a point
+        /// @param x [in] The point x coordinate
+        /// @param y [in] The point y coordinate
+        /// @return The face with the start index of the mesh, the fill value if no face contains the point.
+        ///         A point on an edge shared by two faces is located in one of them
+        [[nodiscard]] int locate(double x, double y) const;
+
+        /// @brief Locates the faces containing a batch of points in parallel
+        /// @param x [in] The point x coordinates
+        /// @param y [in] The point y coordinates
+        /// @param num_points [in] The number of points
+        /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+        /// @param faces [out] The located faces, as returned by \ref locate
+        void locate(double const* x, double const* y, size_t num_points, size_t max_threads, int* faces) const;
+
+    private:
+        /// @brief Gets the x coordinate of a node, shifted by whole turns to lie within half a turn of a reference in spherical coordinates
+        /// @param x [in] The x coordinate
+        /// @param reference [in] The reference x coordinate
+        /// @return The shifted x coordinate
+        [[nodiscard]] double unwrap(double x, double reference) const;
+
+        /// @brief Checks whether a face contains a point, with the crossing number algorithm
+        /// @param face [in] The 0-based face
+        /// @param x [in] The point x coordinate
+        /// @param y [in] The point y coordinate
+        /// @return True if the point lies inside the face
+        [[nodiscard]] bool contains(size_t face, double x, double y) const;
+
+        std::vector<double> m_node_x;      ///< The node x coordinates
+        std::vector<double> m_node_y;      ///< The node y coordinates
+        std::vector<int> m_face_nodes;     ///< The 0-based face nodes, padded with -1
+        std::vector<double> m_face_bounds; ///< The bounding box of each face (min x, min y, max x, max y), unwrapped around the first face node
+        std::vector<int> m_bucket_offsets; ///< The offsets of the faces of each bucket, row by row
+        std::vector<int> m_bucket_faces;   ///< The 0-based faces of each bucket, in ascending order
+        size_t m_num_face_nodes_max = 0;   ///< The maximum number of nodes per face
+        size_t m_num_columns = 1;          ///< The number of bucket columns
+        size_t m_num_rows = 1;             ///< The number of bucket rows
+        double m_min_x = 0.0;              ///< The x coordinate of the bucket grid origin
+        double m_min_y = 0.0;              ///< The y coordinate of the bucket grid origin
+        double m_bucket_width = 1.0;       ///< The width of a bucket
+        double m_bucket_height = 1.0;      ///< The height of a bucket
+        int m_start_index = 0;             ///< The start index of the located faces
+        int m_fill_value = 0;              ///< The value returned for points outside the mesh
+        bool m_is_spherical = false;       ///< Whether the x coordinates are longitudes wrapping around
+    };
+
+} // namespace ugrid
@@ -0,0 +1,52 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief Adds an offset to an array of indices, leaving the fill values untouched.
+    ///        Used to convert connectivity arrays between 0- and 1-based indexing, vectorized where SSE2 or AVX2 is available
+    /// @param offset [in] The offset to add (e.g. -1 to convert from 1-based to 0-based indexing)
+    /// @param fill_value [in] The fill value marking unused entries, which are not offset
+    /// @param size [in] The number of values
+    /// @param values [in,out] The indices
+    void add_index_offset(int offset, int fill_value, size_t size, int* values);
+
+    /// @brief Adds an offset to an array of 64-bit indices, leaving the fill values untouched
+    /// @param offset [in] The offset to add
+    /// @param fill_value [in] The fill value marking unused entries, which are not offset
+    /// @param size [in] The number of values
+    /// @param values [in,out] The indices
+    void add_index_offset(int64_t offset, int64_t fill_value, size_t size, int64_t* values);
+
+} // namespace ugrid
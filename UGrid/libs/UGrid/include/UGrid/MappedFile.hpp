@@ -0,0 +1,122 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief A fixed-size variable of a classic netCDF file, as laid out in the file
+    struct MappedVariable
+    {
+        int type = 0;                         ///< The netCDF type (NC_DOUBLE, NC_INT, ...)
+        std::vector<size_t> shape;            ///< The dimension lengths
+        size_t begin = 0;                     ///< The offset of the first value in the file
+        size_t num_values = 0;                ///< The number of values
+        bool is_record = false;               ///< If the variable is defined on the unlimited dimension, so its values are interleaved with other records
+        bool is_prepared = false;             ///< If the values were converted to the native byte order
+        std::vector<uint64_t> aligned_values; ///< The converted values, if they are not aligned to their type in the file
+        int64_t index_offset = 0;             ///< The offset added to the (index) values since mapping
+    };
+
+    /// @brief A classic format netCDF file (CDF-1, CDF-2 or CDF-5) mapped read-only into memory.
+    ///        The header is parsed once on construction. Fixed-size variables are contiguous in the file, so their values are served
+    ///        as views into the mapping instead of being copied through the netCDF buffers. The mapping is private (copy-on-write):
+    ///        a variable is converted in place from the big-endian file order on its first request, touching only the pages it spans,
+    ///        and the file itself is never modified. Variables not aligned to their type in the file are converted into an aligned copy instead
+    class MappedFile
+    {
+    public:
+        /// @brief Maps a file and parses its header
+        /// @param file_path [in] The path of the file
+        explicit MappedFile(std::string const& file_path);
+
+        /// @brief Unmaps the file, invalidating all views
+        ~MappedFile();
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        /// @brief Gets if a file starts with the magic number of a classic format netCDF file
+        /// @param file_path [in] The path of the file
+        /// @return True for CDF-1, CDF-2 and CDF-5 files
+        [[nodiscard]] static bool is_classic_format(std::string const& file_path);
+
+        /// @brief Gets a variable
+        /// @param name [in] The variable name
+        /// @return The variable, throws if the file has no such variable
+        [[nodiscard]] MappedVariable const& get_variable(std::string const& name) const;
+
+        /// @brief Gets a view of the values of a double variable
+        /// @param name [in] The variable name
+        /// @return The values, valid until the file is unmapped. Throws for record variables and other types
+        [[nodiscard]] double* get_doubles(std::string const& name);
+
+        /// @brief Gets a view of the values of an int index variable, offset to a start index. Fill values are not offset.
+        ///        All views of a variable share their memory: requesting another offset converts the earlier views as well
+        /// @param name [in] The variable name
+        /// @param offset [in] The offset to the start index stored in the file
+        /// @param fill_value [in] The fill value
+        /// @return The values, valid until the file is unmapped. Throws for record variables and other types
+        [[nodiscard]] int* get_indices(std::string const& name, int offset, int fill_value);
+
+        /// @brief Gets a view of the values of a 64-bit index variable (CDF-5 only), offset to a start index. Fill values are not offset
+        /// @param name [in] The variable name
+        /// @param offset [in] The offset to the start index stored in the file
+        /// @param fill_value [in] The fill value
+        /// @return The values, valid until the file is unmapped. Throws for record variables and other types
+        [[nodiscard]] int64_t* get_indices_long(std::string const& name, int offset, int64_t fill_value);
+
+    private:
+        /// @brief Unmaps the file, if mapped
+        void unmap();
+
+        /// @brief Reads the header, filling the variables
+        void parse_header();
+
+        /// @brief Gets the values of a variable in the native byte order
+        /// @param name [in] The variable name
+        /// @param type [in] The expected netCDF type
+        /// @return The variable and a pointer to its first value
+        std::pair<MappedVariable*, char*> get_native_values(std::string const& name, int type);
+
+        char* m_data = nullptr;                            ///< The start of the mapping
+        size_t m_size = 0;                                 ///< The size of the mapping
+        std::map<std::string, MappedVariable> m_variables; ///< The variables keyed by name
+    };
+} // namespace ugrid
@@ -57,6 +57,7 @@ namespace ugrid
 
         /// @brief Defines the mesh1d header (ug_write_mesh_arrays, ug_create_1d_mesh_v2, ug_def_mesh_ids)
         /// @param mesh1d The mesh1d api structure with the fields to write and all optional flags
+        /// @note The file is left in define mode, so several definitions can share one define phase
         void define(ugridapi::Mesh1D const& mesh1d);
 
         /// @brief Writes a mesh1d to file
@@ -27,14 +27,30 @@
 
 #pragma once
 
+#include <optional>
+
 #include <UGridAPI/Mesh2D.hpp>
 
+#include <UGrid/MappedFile.hpp>
+#include <UGrid/MeshConnectivity.hpp>
 #include <UGrid/UGridEntity.hpp>
 
 /// \namespace ugrid
 /// @brief Contains the logic of the C++ static library
 namespace ugrid
 {
+    /// @brief Gets a count of the mesh2d api struct: the 32-bit count, or the 64-bit count when the 32-bit count is negative
+    /// @param count [in] The 32-bit count (e.g. num_faces), negative (-1) to use the 64-bit count
+    /// @param count_long [in] The 64-bit count (e.g. num_faces_long)
+    /// @return The count
+    static size_t get_mesh2d_count(int count, int64_t count_long)
+    {
+        if (count < 0)
+        {
+            return count_long > 0 ? static_cast<size_t>(count_long) : 0;
+        }
+        return static_cast<size_t>(count);
+    }
 
     /// @brief A class implementing the methods for reading/writing a mesh2d in UGrid format
     struct Mesh2D : UGridEntity
@@ -58,6 +74,7 @@ namespace ugrid
 
         /// @brief Defines the mesh2d header
         /// @param mesh2d The mesh2d api structure with the fields to write and all optional flags
+        /// @note The file is left in define mode, so several definitions can share one define phase
         void define(ugridapi::Mesh2D const& mesh2d);
 
         /// @brief Writes a mesh2d to file
@@ -72,8 +89,70 @@ namespace ugrid
         /// @param mesh2d The mesh2d api structure with the fields where to assign the data
         void get(ugridapi::Mesh2D& mesh2d) const;
 
+        /// @brief Points the mesh2d arrays to views of the variables in a mapped file instead of copying them, see \ref MappedFile.
+        ///        Arrays the file does not store (including derived connectivity) are set to nullptr. Indices are offset to mesh2d.start_index
+        /// @param mapped_file The mapping of the file the mesh2d was read from
+        /// @param mesh2d The mesh2d api structure with the start index, where to assign the views
+        void get_mapped(MappedFile& mapped_file, ugridapi::Mesh2D& mesh2d) const;
+
+        /// @brief Gets the offsets of the faces in a ragged (compressed row) face connectivity, counting the nodes of each face.
+        ///        The face node connectivity is read in blocks of faces, so no padded copy of the whole array is made
+        /// @param face_offsets [out] The offsets, sized to the number of faces + 1. The last entry is the number of entries
+        void get_face_offsets(int* face_offsets) const;
+
+        /// @brief Reads a face connectivity in the ragged layout: the entries of face f are indices[face_offsets[f]] to indices[face_offsets[f + 1] - 1]
+        /// @param attribute_name The connectivity (face_node_connectivity, face_edge_connectivity or face_face_connectivity)
+        /// @param start_index The start index of the returned indices
+        /// @param face_offsets The face offsets, as returned by \ref get_face_offsets
+        /// @param indices [out] The flat indices. Missing neighbours (e.g. in the face face connectivity) keep the fill value
+        void get_ragged_face_connectivity(std::string const& attribute_name, int start_index, int const* face_offsets, int* indices) const;
+
+        /// @brief Writes a face connectivity given in the ragged layout, padding each face with the fill value
+        /// @param attribute_name The connectivity (face_node_connectivity, face_edge_connectivity or face_face_connectivity)
+        /// @param start_index The start index of the indices
+        /// @param face_offsets The face offsets, sized to the number of faces + 1
+        /// @param indices The flat indices
+        void put_ragged_face_connectivity(std::string const& attribute_name, int start_index, int const* face_offsets, int const* indices) const;
+
+        /// @brief Derives the edge_nodes, edge_faces, face_edges and face_faces connectivity from the face node connectivity.
+        ///        Afterwards, \ref inquire and \ref get return the derived connectivity where the file lacks it.
+        ///        If the file stores edges, the derived edges are numbered as those
+        /// @param max_threads The maximum number of threads, 0 to use the hardware concurrency
+        void derive_connectivity(size_t max_threads);
+
         /// @brief The dimensionality of a Mesh2D
         /// @return The dimensionality
         static int get_dimensionality() { return 2; }
+
+    private:
+        /// @brief Gets a face connectivity variable
+        /// @param attribute_name The connectivity attribute name
+        /// @return The variable, throws if the mesh does not have the connectivity
+        [[nodiscard]] netCDF::NcVar const& get_face_connectivity_variable(std::string const& attribute_name) const;
+
+        /// @brief Reads a connectivity into the 64-bit indices if given, into the 32-bit indices otherwise
+        /// @param var The connectivity variable
+        /// @param start_index The start index of the returned indices
+        /// @param size The number of indices
+        /// @param values The 32-bit indices
+        /// @param values_long The 64-bit indices
+        void get_connectivity(netCDF::NcVar const& var, int start_index, size_t size, int* values, int64_t* values_long) const;
+
+        /// @brief Writes a connectivity from the 64-bit indices if given, from the 32-bit indices otherwise
+        /// @param var The connectivity variable
+        /// @param start_index The start index of the indices
+        /// @param size The number of indices
+        /// @param values The 32-bit indices
+        /// @param values_long The 64-bit indices
+        void put_connectivity(netCDF::NcVar const& var, int start_index, size_t size, int const* values, int64_t const* values_long) const;
+
+        /// @brief Copies a derived connectivity into the 64-bit indices if given, into the 32-bit indices otherwise
+        /// @param derived The derived 0-based connectivity
+        /// @param start_index The start index of the returned indices
+        /// @param values The 32-bit indices
+        /// @param values_long The 64-bit indices
+        void get_derived_connectivity(std::vector<int> const& derived, int start_index, int* values, int64_t* values_long) const;
+
+        std::optional<DerivedConnectivity> m_derived_connectivity; ///< The connectivity derived from the face nodes, if derived
     };
 } // namespace ugrid
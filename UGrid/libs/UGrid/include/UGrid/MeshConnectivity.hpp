@@ -0,0 +1,91 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief The connectivity of a mesh2d derived from its face nodes, with 0-based indices
+    struct DerivedConnectivity
+    {
+        std::vector<int> edge_nodes; ///< The start and end node of each edge, oriented as in the first face containing the edge
+        std::vector<int> edge_faces; ///< The faces on both sides of each edge, the second one is the fill value on the boundary
+        std::vector<int> face_edges; ///< The edges of each face, padded with the fill value as the face nodes
+        std::vector<int> face_faces; ///< The neighbouring face across each face edge, the fill value on the boundary
+        int fill_value = 0;          ///< The fill value of the missing entries
+    };
+
+    /// @brief Derives the edge_nodes, edge_faces, face_edges and face_faces connectivity from the face nodes.
+    ///        The half edges of all faces are sorted by their node pair in parallel chunks and merged, after which
+    ///        every run of equal node pairs is one edge. The edges are numbered in the order of their sorted node pairs,
+    ///        so the result does not depend on the number of threads
+    /// @param face_nodes [in] The 0-based face nodes, num_face_nodes_max per face, padded with the fill value
+    /// @param num_faces [in] The number of faces
+    /// @param num_face_nodes_max [in] The maximum number of nodes per face
+    /// @param fill_value [in] The fill value of the face nodes, also used for the missing entries of the result
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The derived connectivity, throws if an edge is shared by more than two faces
+    [[nodiscard]] DerivedConnectivity derive_connectivity(int const* face_nodes,
+                                                          size_t num_faces,
+                                                          size_t num_face_nodes_max,
+                                                          int fill_value,
+                                                          size_t max_threads);
+
+    /// @brief Renumbers derived edges as a given set of edges (e.g. the edges already stored in a file)
+    /// @param connectivity [in,out] The derived connectivity
+    /// @param edge_nodes [in] The 0-based start and end node of each edge, throws if they are not the derived edges
+    void renumber_edges(DerivedConnectivity& connectivity, std::vector<int> const& edge_nodes);
+
+    /// @brief Builds the inverse of a connectivity in compressed row (CSR) format, e.g. the faces around each node from the face nodes.
+    ///        A parallel counting sort: each thread counts the targets of a contiguous chunk of entities, the counts are turned
+    ///        into write positions per chunk and target, and each thread scatters its chunk. The entities of each target are sorted.
+    ///        The number of chunks is capped so that the counts per chunk and target take no more memory than the connectivity
+    /// @param connectivity [in] The targets of each entity (e.g. the face nodes), entries_per_entity per entity
+    /// @param num_entities [in] The number of entities (e.g. faces)
+    /// @param entries_per_entity [in] The number of entries per entity, including the fill values
+    /// @param num_targets [in] The number of targets (e.g. nodes)
+    /// @param start_index [in] The start index of the connectivity, also used for the returned entity indices
+    /// @param fill_value [in] The fill value of the connectivity, these entries are skipped
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @param offsets [out] The offsets of the entities of each target, sized to num_targets + 1
+    /// @param indices [out] The entities of each target, sized to the number of entries that are not fill values
+    void build_inverse_connectivity(int const* connectivity,
+                                    size_t num_entities,
+                                    size_t entries_per_entity,
+                                    size_t num_targets,
+                                    int start_index,
+                                    int fill_value,
+                                    size_t max_threads,
+                                    int* offsets,
+                                    int* indices);
+
+} // namespace ugrid
@@ -0,0 +1,172 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <netcdf>
+
+#include <UGrid/Mesh2D.hpp>
+#include <UGrid/VariableStorage.hpp>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief The topology arrays of a mesh2d, with 0-based indices
+    struct Mesh2DArrays
+    {
+        std::vector<double> node_x;    ///< The node x coordinates
+        std::vector<double> node_y;    ///< The node y coordinates
+        std::vector<int> edge_nodes;   ///< The start and end node of each edge, empty if the mesh has no edges
+        std::vector<int> face_nodes;   ///< The nodes of each face, num_face_nodes_max per face, padded with the fill value
+        size_t num_face_nodes_max = 0; ///< The maximum number of nodes per face
+        int fill_value = 0;            ///< The fill value of the face nodes
+
+        /// @brief Gets the number of faces
+        /// @return The number of faces
+        [[nodiscard]] size_t get_num_faces() const
+        {
+            return num_face_nodes_max == 0 ? 0 : face_nodes.size() / num_face_nodes_max;
+        }
+    };
+
+    /// @brief A subset of the faces of a mesh2d, with the nodes and edges they use and their renumbered connectivity
+    struct Mesh2DSubset
+    {
+        std::vector<size_t> nodes;     ///< The 0-based selected nodes of the source mesh, ascending
+        std::vector<size_t> edges;     ///< The 0-based selected edges of the source mesh, ascending
+        std::vector<size_t> faces;     ///< The 0-based selected faces of the source mesh, ascending
+        std::vector<double> node_x;    ///< The x coordinates of the selected nodes
+        std::vector<double> node_y;    ///< The y coordinates of the selected nodes
+        std::vector<int> edge_nodes;   ///< The edge nodes of the selected edges, numbered in the subset
+        std::vector<int> face_nodes;   ///< The face nodes of the selected faces, numbered in the subset and padded with the fill value
+        size_t num_face_nodes_max = 0; ///< The maximum number of nodes per face
+        int fill_value = 0;            ///< The fill value of the face nodes
+    };
+
+    /// @brief An int variable written with a mesh2d subset on one of its locations, e.g. the global indices of its entities
+    struct Mesh2DSubsetVariable
+    {
+        std::string name;             ///< The variable name
+        UGridFileDimensions location; ///< The location dimension, node, edge or face
+        std::string long_name;        ///< The long_name attribute
+        std::vector<int> values;      ///< The value of each entity of the subset at the location
+    };
+
+    /// @brief Reads the node coordinates, edge nodes and face nodes of a mesh2d, with 0-based indices
+    /// @param mesh [in] The mesh2d
+    /// @return The arrays
+    [[nodiscard]] Mesh2DArrays read_mesh2d_arrays(Mesh2D const& mesh);
+
+    /// @brief Makes a subset of given faces and edges, with the nodes used by the faces
+    /// @param mesh [in] The source mesh arrays
+    /// @param faces [in] The 0-based faces, ascending
+    /// @param edges [in] The 0-based edges, ascending, their nodes must be nodes of the faces
+    /// @return The subset
+    [[nodiscard]] Mesh2DSubset make_mesh2d_subset(Mesh2DArrays const& mesh, std::vector<size_t> faces, std::vector<size_t> edges);
+
+    /// @brief Selects the faces with all their nodes inside a region, and the nodes and edges of these faces
+    /// @param mesh [in] The source mesh arrays
+    /// @param is_inside [in] Whether a point lies inside the region
+    /// @return The selection
+    [[nodiscard]] Mesh2DSubset select_mesh2d_faces(Mesh2DArrays const& mesh, std::function<bool(double, double)> const& is_inside);
+
+    /// @brief Checks whether a point lies inside a polygon, with the crossing number algorithm
+    /// @param x [in] The point x coordinate
+    /// @param y [in] The point y coordinate
+    /// @param polygon_x [in] The polygon node x coordinates, the polygon is closed implicitly
+    /// @param polygon_y [in] The polygon node y coordinates
+    /// @param num_polygon_nodes [in] The number of polygon nodes
+    /// @return True if the point lies inside the polygon
+    [[nodiscard]] bool is_point_in_polygon(double x, double y, double const* polygon_x, double const* polygon_y, size_t num_polygon_nodes);
+
+    /// @brief Defines a variable in another file like a data variable of a mesh, with the location dimension replaced.
+    ///        The other dimensions are taken by name from the target file, or added with the size of the source dimension.
+    ///        The attributes are copied
+    /// @param source_variable [in] The source data variable
+    /// @param source_location_dimension [in] The location dimension of the source mesh
+    /// @param target_location_dimension [in] The location dimension of the target mesh
+    /// @param target [in] The target file, in define mode
+    /// @return The target variable, throws for string and user-defined types
+    netCDF::NcVar define_variable_on_location(netCDF::NcVar const& source_variable,
+                                              netCDF::NcDim const& source_location_dimension,
+                                              netCDF::NcDim const& target_location_dimension,
+                                              netCDF::NcFile& target);
+
+    /// @brief Defines in another file the coordinate variables (e.g. time) of the dimensions of a data variable, other than its location dimension.
+    ///        A coordinate variable is a one-dimensional variable named after its dimension. Variables already in the target are skipped
+    /// @param source_variable [in] The source data variable, whose dimensions were carried over by \ref define_variable_on_location
+    /// @param location_dimension [in] The position of the location dimension in the variable dimensions
+    /// @param source [in] The source file
+    /// @param target [in] The target file, in define mode
+    /// @return The source and target coordinate variables, to be copied with \ref copy_coordinate_variable
+    std::vector<std::pair<netCDF::NcVar, netCDF::NcVar>> define_coordinate_variables(netCDF::NcVar const& source_variable,
+                                                                                    size_t location_dimension,
+                                                                                    netCDF::NcFile const& source,
+                                                                                    netCDF::NcFile& target);
+
+    /// @brief Copies the values of a coordinate variable, all records for an unlimited dimension
+    /// @param source_variable [in] The source coordinate variable
+    /// @param target_variable [in] The target coordinate variable, in data mode
+    void copy_coordinate_variable(netCDF::NcVar const& source_variable, netCDF::NcVar const& target_variable);
+
+    /// @brief Writes a subset of a mesh2d to another file, with the data variables on its nodes, edges and faces,
+    ///        and the coordinate variables of their other dimensions (e.g. time). The data variables are streamed with one hyperslab per window of selected entities separated by small gaps
+    ///        and per index of the dimensions preceding the location dimension, so they are never loaded whole
+    /// @param mesh [in] The source mesh2d
+    /// @param source [in] The file containing the source mesh2d
+    /// @param subset [in] The subset, with at least one face
+    /// @param subset_variables [in] Additional int variables to write on the subset, replacing data variables of the same name
+    /// @param target [in] The file to write to, in define mode. It is left in data mode
+    /// @param padding [in] The padding applied when the target leaves define mode
+    void write_mesh2d_subset(Mesh2D& mesh,
+                             std::shared_ptr<netCDF::NcFile> const& source,
+                             Mesh2DSubset subset,
+                             std::vector<Mesh2DSubsetVariable> const& subset_variables,
+                             std::shared_ptr<netCDF::NcFile> const& target,
+                             HeaderPadding const& padding);
+
+    /// @brief Writes the part of a mesh2d inside a region to another file, with the data variables on its nodes, edges and faces.
+    ///        The topology is read once, see \ref write_mesh2d_subset for the data variables
+    /// @param mesh [in] The source mesh2d
+    /// @param source [in] The file containing the source mesh2d
+    /// @param is_inside [in] Whether a point lies inside the region
+    /// @param target [in] The file to write to, in define mode. It is left in data mode
+    /// @param padding [in] The padding applied when the target leaves define mode
+    /// @return The number of extracted faces, throws if no face lies inside the region
+    size_t extract_mesh2d(Mesh2D& mesh,
+                          std::shared_ptr<netCDF::NcFile> const& source,
+                          std::function<bool(double, double)> const& is_inside,
+                          std::shared_ptr<netCDF::NcFile> const& target,
+                          HeaderPadding const& padding);
+
+} // namespace ugrid
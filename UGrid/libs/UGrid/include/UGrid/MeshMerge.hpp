@@ -0,0 +1,67 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <netcdf>
+
+#include <UGrid/Mesh2D.hpp>
+#include <UGrid/VariableStorage.hpp>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief Merges the domains of a partitioned mesh2d, one per file, into one mesh2d with the data variables on its nodes, edges and faces.
+    ///        - Nodes are merged by their <mesh>_node_global_number variable when every domain has it, by coordinates within a tolerance otherwise.
+    ///        - Faces owned by another domain (<mesh>_face_domain_number, when present) are dropped as ghost faces. The remaining faces are
+    ///          merged by <mesh>_face_global_number when every domain has it, by their merged nodes otherwise.
+    ///        - Edges are merged by <mesh>_edge_global_number when every domain has it, by their merged nodes otherwise.
+    ///          They are left out when a domain has no edges.
+    ///        With global numbers the merged entities are in global number order, otherwise in order of first appearance.
+    ///        Each data variable is streamed one index of its dimensions preceding the location dimension at a time
+    ///        (e.g. one time step), so only one merged slab and one slab per reading thread are held in memory.
+    ///        These dimensions must have the same size in every domain, and their coordinate variables (e.g. time) are copied from the first domain
+    /// @param domains [in] The mesh2d of each domain, the index of a domain is its domain number
+    /// @param sources [in] The file of each domain
+    /// @param tolerance [in] The distance within which nodes are merged, must be positive when nodes are merged by coordinates
+    /// @param target [in] The file to write to, in define mode. It is left in data mode
+    /// @param padding [in] The padding applied when the target leaves define mode
+    /// @param max_read_threads [in] The maximum number of threads reading domain files concurrently,
+    ///                             1 unless the netCDF library is thread-safe for the files
+    /// @return The number of merged faces
+    size_t merge_mesh2d_partitions(std::vector<Mesh2D>& domains,
+                                   std::vector<std::shared_ptr<netCDF::NcFile>> const& sources,
+                                   double tolerance,
+                                   std::shared_ptr<netCDF::NcFile> const& target,
+                                   HeaderPadding const& padding,
+                                   size_t max_read_threads);
+
+} // namespace ugrid
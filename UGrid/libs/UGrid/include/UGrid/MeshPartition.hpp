@@ -0,0 +1,74 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <netcdf>
+
+#include <UGrid/Mesh2D.hpp>
+#include <UGrid/MeshExtraction.hpp>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief Partitions the faces of a mesh2d into domains of (nearly) equal size, by cutting the Hilbert curve
+    ///        through the face centres into contiguous pieces. See \ref partition_along_hilbert_curve
+    /// @param mesh [in] The mesh arrays
+    /// @param num_domains [in] The number of domains, at least 1
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The 0-based domain of each face
+    [[nodiscard]] std::vector<int> partition_mesh2d_faces(Mesh2DArrays const& mesh, size_t num_domains, size_t max_threads);
+
+    /// @brief Writes one file per domain of a partitioned mesh2d, with the faces of the domain and layers of ghost faces around them,
+    ///        the nodes and edges of these faces and the data variables on them (see \ref write_mesh2d_subset).
+    ///        Each file also gets the 1-based global numbers of its nodes, edges and faces in the source mesh
+    ///        (<mesh>_node_global_number, <mesh>_edge_global_number, <mesh>_face_global_number)
+    ///        and the 0-based domain owning each face (<mesh>_face_domain_number), which tells the ghost faces apart.
+    ///        The ghost layers grow across the face edges: layer k holds the faces neighbouring layer k - 1 that are in no earlier layer
+    /// @param mesh [in] The source mesh2d
+    /// @param source [in] The file containing the source mesh2d
+    /// @param face_domains [in] The 0-based domain of each face, e.g. from \ref partition_mesh2d_faces
+    /// @param num_domains [in] The number of domains, every domain must own at least one face
+    /// @param num_ghost_layers [in] The number of ghost face layers
+    /// @param create_file [in] Creates the file of a domain, in define mode
+    /// @param padding [in] The padding applied when the file of a domain leaves define mode
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    void write_mesh2d_partitions(Mesh2D& mesh,
+                                 std::shared_ptr<netCDF::NcFile> const& source,
+                                 std::vector<int> const& face_domains,
+                                 size_t num_domains,
+                                 size_t num_ghost_layers,
+                                 std::function<std::shared_ptr<netCDF::NcFile>(size_t)> const& create_file,
+                                 HeaderPadding const& padding,
+                                 size_t max_threads);
+
+} // namespace ugrid
@@ -0,0 +1,89 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <UGridAPI/Mesh2D.hpp>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief A renumbering of the entities of a mesh2d. Each permutation gives, for each new entity, the index of the entity it was before
+    struct Mesh2DPermutations
+    {
+        std::vector<size_t> nodes; ///< The old index of each new node
+        std::vector<size_t> edges; ///< The old index of each new edge
+        std::vector<size_t> faces; ///< The old index of each new face
+    };
+
+    /// @brief Orders the entities of a mesh2d along a Hilbert curve, so that entities close in space get close indices.
+    ///        Nodes are sorted by their coordinates, edges by their midpoints and faces by the mean of their nodes, all on the grid of the node bounding box.
+    ///        Edges and faces without connectivity fall back to edge_x/edge_y and face_x/face_y, and keep their order if these are not set either
+    /// @param mesh2d [in] The mesh2d, node_x and node_y are required
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The permutations
+    [[nodiscard]] Mesh2DPermutations compute_mesh2d_hilbert_order(ugridapi::Mesh2D const& mesh2d, size_t max_threads);
+
+    /// @brief Renumbers the entities of a mesh2d in place: every coordinate and connectivity array set in the api structure is reordered,
+    ///        and the connectivity values are mapped to the new indices. All indices are checked before any array is modified
+    /// @param permutations [in] The permutations, of the sizes of the mesh2d counts
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @param mesh2d [in,out] The mesh2d
+    void renumber_mesh2d(Mesh2DPermutations const& permutations, size_t max_threads, ugridapi::Mesh2D& mesh2d);
+
+    /// @brief Checks a permutation and inverts it
+    /// @param permutation [in] The old index of each new entity
+    /// @return The new index of each old entity, throws if the permutation does not contain every index exactly once
+    [[nodiscard]] std::vector<size_t> invert_permutation(std::vector<size_t> const& permutation);
+
+    /// @brief Reorders the values of entities in place, for instance a data variable after its mesh was renumbered
+    /// @tparam T The value type
+    /// @param permutation [in] The old index of each new entity, checked by \ref invert_permutation
+    /// @param num_values_per_entity [in] The number of consecutive values of each entity
+    /// @param values [in,out] The values, permutation.size() * num_values_per_entity of them
+    template <typename T>
+    void permute_values(std::vector<size_t> const& permutation, size_t num_values_per_entity, T* values)
+    {
+        if (values == nullptr || num_values_per_entity == 0)
+        {
+            return;
+        }
+        std::vector<T> const old_values(values, values + permutation.size() * num_values_per_entity);
+        for (size_t i = 0; i < permutation.size(); ++i)
+        {
+            auto const old_begin = old_values.begin() + static_cast<std::ptrdiff_t>(permutation[i] * num_values_per_entity);
+            std::copy(old_begin, old_begin + static_cast<std::ptrdiff_t>(num_values_per_entity), values + i * num_values_per_entity);
+        }
+    }
+
+} // namespace ugrid
@@ -54,8 +54,26 @@ namespace ugrid
             std::map<std::string, std::vector<std::string>> const& entity_attribute_names,
             std::map<UGridFileDimensions, netCDF::NcDim> const& entity_dimensions);
 
+        /// @brief Constructor setting nc_file and all internal state, using a snapshot of the file variables and dimensions
+        /// @param nc_file The nc file pointer
+        /// @param topology_variable The network topology variable
+        /// @param entity_attributes The topological attributes (key value pair with key the attribute name and value the associated vector of variables)
+        /// @param entity_attribute_names The topological attributes names (key value pair with key the attribute name and value the associated vector of variables names)
+        /// @param entity_dimensions The dimensions associated with the mesh2d (key value pair with key the dimension enumeration and value the associated NetCDF dimension)
+        /// @param file_variables All variables in the file
+        /// @param file_dimensions All dimensions in the file
+        Network1D(
+            std::shared_ptr<netCDF::NcFile> nc_file,
+            netCDF::NcVar const& topology_variable,
+            std::map<std::string, std::vector<netCDF::NcVar>> const& entity_attributes,
+            std::map<std::string, std::vector<std::string>> const& entity_attribute_names,
+            std::map<UGridFileDimensions, netCDF::NcDim> const& entity_dimensions,
+            std::multimap<std::string, netCDF::NcVar> const& file_variables,
+            std::multimap<std::string, netCDF::NcDim> const& file_dimensions);
+
         /// @brief Defines the network1d header (ug_create_1d_network_v1)
         /// @param mesh2d The network1d api structure with the fields to write and all optional flags
+        /// @note The file is left in define mode, so several definitions can share one define phase
         void define(ugridapi::Network1D const& mesh2d);
 
         /// @brief Writes a network1d to file
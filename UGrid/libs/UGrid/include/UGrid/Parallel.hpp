@@ -0,0 +1,181 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief Gets the number of worker threads to use for a number of independent tasks
+    /// @param num_tasks [in] The number of tasks
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The number of threads, at least one
+    static size_t get_num_threads(size_t num_tasks, size_t max_threads)
+    {
+        size_t num_threads = max_threads == 0 ? std::thread::hardware_concurrency() : max_threads;
+        num_threads = std::min(num_threads, num_tasks);
+        return std::max<size_t>(num_threads, 1);
+    }
+
+    /// @brief Runs a function for every index in [0, num_tasks) on a pool of threads.
+    ///        Tasks are handed out dynamically, so uneven tasks are balanced over the threads.
+    ///        The calling thread takes part in the work. The first exception thrown by a task is rethrown after all threads joined.
+    /// @tparam F The function type, callable with a size_t index
+    /// @param num_tasks [in] The number of tasks
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @param function [in] The function to run for each task index
+    template <typename F>
+    void parallel_for(size_t num_tasks, size_t max_threads, F const& function)
+    {
+        size_t const num_threads = get_num_threads(num_tasks, max_threads);
+        if (num_threads <= 1)
+        {
+            for (size_t i = 0; i < num_tasks; ++i)
+            {
+                function(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next_task{0};
+        std::vector<std::exception_ptr> exceptions(num_threads);
+        auto const worker = [&](size_t thread_index)
+        {
+            try
+            {
+                for (size_t i = next_task++; i < num_tasks; i = next_task++)
+                {
+                    function(i);
+                }
+            }
+            catch (...)
+            {
+                exceptions[thread_index] = std::current_exception();
+                next_task = num_tasks;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads - 1);
+        for (size_t t = 1; t < num_threads; ++t)
+        {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (auto const& exception : exceptions)
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+
+    /// @brief Gets the first item of a chunk, when [0, num_items) is split in num_chunks contiguous chunks of equal size
+    /// @param num_items [in] The number of items
+    /// @param num_chunks [in] The number of chunks, at least one
+    /// @param chunk [in] The chunk, num_chunks gives the end of the last chunk
+    /// @return The first item of the chunk
+    static size_t get_chunk_begin(size_t num_items, size_t num_chunks, size_t chunk)
+    {
+        auto const chunk_size = (num_items + num_chunks - 1) / num_chunks;
+        return std::min(num_items, chunk * chunk_size);
+    }
+
+    /// @brief Splits [0, num_items) in contiguous chunks of equal size and runs a function for every chunk in parallel
+    /// @tparam F The function type, callable with the chunk index and the begin and end of its items
+    /// @param num_items [in] The number of items
+    /// @param num_chunks [in] The number of chunks, at least one. Callers keeping data per chunk size it with this number
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @param function [in] The function to run for each chunk
+    template <typename F>
+    void parallel_for_chunks(size_t num_items, size_t num_chunks, size_t max_threads, F const& function)
+    {
+        parallel_for(num_chunks, max_threads, [&](size_t chunk)
+                     { function(chunk, get_chunk_begin(num_items, num_chunks, chunk), get_chunk_begin(num_items, num_chunks, chunk + 1)); });
+    }
+
+    /// @brief Runs a function for every index in [0, num_items), in one contiguous chunk of indices per thread
+    /// @tparam F The function type, callable with a size_t index
+    /// @param num_items [in] The number of indices
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @param function [in] The function to run for each index
+    template <typename F>
+    void parallel_for_each_index(size_t num_items, size_t max_threads, F const& function)
+    {
+        parallel_for_chunks(num_items, get_num_threads(num_items, max_threads), max_threads, [&](size_t, size_t begin, size_t end)
+                            {
+                                for (auto i = begin; i < end; ++i)
+                                {
+                                    function(i);
+                                }
+                            });
+    }
+
+    /// @brief Sorts a vector in parallel: one contiguous chunk per thread is sorted, then pairs of sorted ranges are merged in rounds.
+    ///        For the result not to depend on the number of threads, no two different elements may compare equivalent
+    /// @tparam T The element type, ordered by operator<
+    /// @param values [in,out] The values to sort
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    template <typename T>
+    void parallel_sort(std::vector<T>& values, size_t max_threads)
+    {
+        auto const size = values.size();
+        auto const num_chunks = get_num_threads(size, max_threads);
+        auto const chunk_begin = [&values, size, num_chunks](size_t chunk)
+        {
+            return values.begin() + static_cast<std::ptrdiff_t>(get_chunk_begin(size, num_chunks, chunk));
+        };
+
+        parallel_for(num_chunks, max_threads, [&](size_t chunk)
+                     { std::sort(chunk_begin(chunk), chunk_begin(chunk + 1)); });
+        for (size_t width = 1; width < num_chunks; width *= 2)
+        {
+            auto const num_merges = (num_chunks + 2 * width - 1) / (2 * width);
+            parallel_for(num_merges, max_threads, [&](size_t merge)
+                         {
+                             auto const first = merge * 2 * width;
+                             std::inplace_merge(chunk_begin(first),
+                                                chunk_begin(std::min(first + width, num_chunks)),
+                                                chunk_begin(std::min(first + 2 * width, num_chunks)));
+                         });
+        }
+    }
+} // namespace ugrid
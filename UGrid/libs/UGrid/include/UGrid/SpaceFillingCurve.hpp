@@ -0,0 +1,100 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief The number of bits per coordinate of the Hilbert curve, giving a 2^21 x 2^21 grid over the bounding box of the points
+    static constexpr unsigned hilbert_order = 21;
+
+    /// @brief Gets the distance along the Hilbert curve of a cell of a 2^order x 2^order grid
+    /// @param x [in] The cell column, below 2^order
+    /// @param y [in] The cell row, below 2^order
+    /// @param order [in] The number of bits per coordinate, at most 32
+    /// @return The distance along the curve, below 4^order
+    [[nodiscard]] uint64_t get_hilbert_index(uint32_t x, uint32_t y, unsigned order);
+
+    /// @brief The square grid of 2^\ref hilbert_order cells per side the Hilbert curve is laid over
+    struct HilbertGrid
+    {
+        double min_x = 0.0; ///< The x coordinate of the lower left corner
+        double min_y = 0.0; ///< The y coordinate of the lower left corner
+        double scale = 0.0; ///< The number of cells per unit of length
+    };
+
+    /// @brief Gets the Hilbert grid covering the bounding box of points
+    /// @param x [in] The point x coordinates
+    /// @param y [in] The point y coordinates
+    /// @param num_points [in] The number of points
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The grid, throws if a coordinate is not finite
+    [[nodiscard]] HilbertGrid get_hilbert_grid(double const* x, double const* y, size_t num_points, size_t max_threads);
+
+    /// @brief Computes the Hilbert index of each point on a grid. Points outside the grid get the index of the nearest cell
+    /// @param x [in] The point x coordinates
+    /// @param y [in] The point y coordinates
+    /// @param num_points [in] The number of points
+    /// @param grid [in] The grid
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The Hilbert index of each point
+    [[nodiscard]] std::vector<uint64_t> compute_hilbert_indices(double const* x, double const* y, size_t num_points, HilbertGrid const& grid, size_t max_threads);
+
+    /// @brief Orders points along the Hilbert curve on a grid. Points in the same cell keep their relative order, so the result does not
+    ///        depend on the number of threads
+    /// @param x [in] The point x coordinates
+    /// @param y [in] The point y coordinates
+    /// @param num_points [in] The number of points
+    /// @param grid [in] The grid
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The points in curve order
+    [[nodiscard]] std::vector<size_t> sort_along_hilbert_curve(double const* x, double const* y, size_t num_points, HilbertGrid const& grid, size_t max_threads);
+
+    /// @brief Orders points along the Hilbert curve on the grid covering their bounding box
+    /// @param x [in] The point x coordinates
+    /// @param y [in] The point y coordinates
+    /// @param num_points [in] The number of points
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The points in curve order
+    [[nodiscard]] std::vector<size_t> sort_along_hilbert_curve(double const* x, double const* y, size_t num_points, size_t max_threads);
+
+    /// @brief Partitions points into domains of (nearly) equal size by cutting the Hilbert curve through them into contiguous pieces
+    /// @param x [in] The point x coordinates
+    /// @param y [in] The point y coordinates
+    /// @param num_points [in] The number of points
+    /// @param num_domains [in] The number of domains, at least 1
+    /// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+    /// @return The 0-based domain of each point
+    [[nodiscard]] std::vector<int> partition_along_hilbert_curve(double const* x, double const* y, size_t num_points, size_t num_domains, size_t max_threads);
+
+} // namespace ugrid
@@ -0,0 +1,129 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <netcdf>
+#include <type_traits>
+
+#include <UGrid/Contacts.hpp>
+#include <UGrid/Mesh1D.hpp>
+#include <UGrid/Mesh2D.hpp>
+#include <UGrid/Network1D.hpp>
+#include <UGrid/Operations.hpp>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief A class classifying all topology variables of a file in a single pass.
+    ///        The file variables and dimensions are read once and shared by the construction of all entity types,
+    ///        replacing one scan per type with \ref UGridEntity::create
+    class TopologyScanner
+    {
+    public:
+        /// @brief Constructor, reads the file variables and dimensions and classifies the topology variables
+        /// @param nc_file [in] A pointer to NcFile, containing the id of an opened file
+        explicit TopologyScanner(std::shared_ptr<netCDF::NcFile> const& nc_file);
+
+        /// @brief Creates the entities of one type from the classified topology variables
+        /// @tparam T The entity type (Mesh1D, Mesh2D, Network1D or Contacts)
+        /// @return A vector of T class instances
+        template <typename T>
+        [[nodiscard]] std::vector<T> create() const
+        {
+            std::vector<T> result;
+            for (auto const& variable : get_topology_variables<T>())
+            {
+                auto const [entity_attribute_variables, entity_attribute_names, entity_dimensions] = get_ugrid_entity(variable, m_file_dimensions, m_file_variables);
+                if constexpr (std::is_same_v<T, Network1D>)
+                {
+                    result.emplace_back(m_nc_file,
+                                        variable,
+                                        entity_attribute_variables,
+                                        entity_attribute_names,
+                                        entity_dimensions,
+                                        m_file_variables,
+                                        m_file_dimensions);
+                }
+                else
+                {
+                    result.emplace_back(m_nc_file,
+                                        variable,
+                                        entity_attribute_variables,
+                                        entity_attribute_names,
+                                        entity_dimensions);
+                }
+            }
+            return result;
+        }
+
+    private:
+        /// @brief Gets the topology variables classified as a given entity type
+        /// @tparam T The entity type
+        /// @return The topology variables, in the order of the file variables
+        template <typename T>
+        [[nodiscard]] std::vector<netCDF::NcVar> const& get_topology_variables() const
+        {
+            if constexpr (std::is_same_v<T, Mesh1D>)
+            {
+                return m_mesh1d_variables;
+            }
+            else if constexpr (std::is_same_v<T, Mesh2D>)
+            {
+                return m_mesh2d_variables;
+            }
+            else if constexpr (std::is_same_v<T, Network1D>)
+            {
+                return m_network1d_variables;
+            }
+            else
+            {
+                static_assert(std::is_same_v<T, Contacts>, "TopologyScanner: Unsupported entity type.");
+                return m_contacts_variables;
+            }
+        }
+
+        /// @brief Determines if a variable is a topology variable of a given entity type
+        /// @tparam T The entity type
+        /// @param attributes [in] The variable attributes
+        /// @return True if the variable is a topology variable of type T
+        template <typename T>
+        [[nodiscard]] static bool is_topology_variable_of_type(std::map<std::string, netCDF::NcVarAtt> const& attributes)
+        {
+            return T::is_topology_variable(attributes) && T::has_matching_dimensionality(attributes, T::get_dimensionality());
+        }
+
+        std::shared_ptr<netCDF::NcFile> m_nc_file;                   ///< A pointer to the scanned file
+        std::multimap<std::string, netCDF::NcVar> m_file_variables;  ///< All variables in the file
+        std::multimap<std::string, netCDF::NcDim> m_file_dimensions; ///< All dimensions in the file
+        std::vector<netCDF::NcVar> m_mesh1d_variables;               ///< The Mesh1D topology variables
+        std::vector<netCDF::NcVar> m_mesh2d_variables;               ///< The Mesh2D topology variables
+        std::vector<netCDF::NcVar> m_network1d_variables;            ///< The Network1D topology variables
+        std::vector<netCDF::NcVar> m_contacts_variables;             ///< The Contacts topology variables
+    };
+} // namespace ugrid
@@ -27,10 +27,13 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <netcdf>
 
 #include <UGrid/Constants.hpp>
 #include <UGrid/Operations.hpp>
+#include <UGrid/VariableStorage.hpp>
 
 /// \namespace ugrid
 /// @brief Contains the logic of the C++ static library
@@ -99,6 +102,17 @@ namespace ugrid
             return result;
         }
 
+        /// @brief A function to determine if a variable is a topology variable (this function might get overwritten in derived if necessary)
+        /// @param attributes [in] The variable attributes
+        /// @return True if the variable is a topology variable
+        static bool is_topology_variable(std::map<std::string, netCDF::NcVarAtt> const& attributes);
+
+        /// @brief A function to determine if a topology variable has a matching dimensionality
+        /// @param attributes [in] The variable attributes
+        /// @param entity_dimensionality [in] The sought dimensionality
+        /// @return If The topology variable has a matching functionality
+        static bool has_matching_dimensionality(std::map<std::string, netCDF::NcVarAtt> const& attributes, int entity_dimensionality);
+
         /// @brief Get the number of topological attributes
         /// @return The number of topological attributes
         [[nodiscard]] auto get_num_attributes() const
@@ -143,36 +157,56 @@ namespace ugrid
             return m_dimensions.at(dimension);
         }
 
+        /// @brief Sets the chunking and compression settings used when defining the entity variables
+        /// @param variable_storage [in] The settings, keyed by the full variable name
+        void set_variable_storage(std::map<std::string, VariableStorage> const& variable_storage)
+        {
+            m_variable_storage = variable_storage;
+        }
+
         /// @brief Gets the names of all data variables associated with a specific location
         /// @param location_string The location string (e.g. node, edge or face)
         /// @return The variables names
         [[nodiscard]] std::vector<std::string> get_data_variables_names(std::string const& location_string);
 
-        /// @brief This function adjusts the values in an input array based on the difference between the provided `start_index`
-        /// and the `start_index` stored in the specified NetCDF variable's attribute named "start_index". If the attribute is not found, no adjustments are made to the array.
-        /// @tparam T The data type of the input array `values`.
-        /// @param[in] var The NetCDF variable from which to retrieve the "start_index" attribute.
-        /// @param[in] start_index The desired start index for the array.
-        /// @param[in] values_size The size of the input array `values`.
-        /// @param[in,out] values The input array to which the offset is applied.
-        template <typename T>
-        static void apply_start_index_offset(const netCDF::NcVar& var, int start_index, int values_size, T* values)
-        {
-            const auto varAtt = var.getAtts();
-            std::string start_index_att_name{"start_index"};
-            if (varAtt.find(start_index_att_name) != varAtt.end())
-            {
-                int variable_start_index;
-                varAtt.at(start_index_att_name).getValues(&variable_start_index);
-                const int offset = start_index - variable_start_index;
-                for (int i = 0; i < values_size; ++i)
-                {
-                    values[i] += offset;
-                }
-            }
-        }
-
     protected:
+        /// @brief Reads an index variable (e.g. a connectivity), converting the values to the requested start index.
+        ///        Fill values are left untouched
+        /// @param[in] var The index variable
+        /// @param[in] start_index The start index of the returned values
+        /// @param[in] values_size The number of values
+        /// @param[out] values The values
+        void get_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int* values) const;
+
+        /// @brief Writes an index variable (e.g. a connectivity), converting the values from the given start index
+        ///        to the start index of the variable. Fill values are left untouched
+        /// @param[in] var The index variable
+        /// @param[in] start_index The start index of the values
+        /// @param[in] values_size The number of values
+        /// @param[in] values The values
+        void put_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int const* values) const;
+
+        /// @brief Reads an index variable into 64-bit indices, converting the values to the requested start index
+        /// @param[in] var The index variable
+        /// @param[in] start_index The start index of the returned values
+        /// @param[in] values_size The number of values
+        /// @param[out] values The values
+        void get_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int64_t* values) const;
+
+        /// @brief Writes 64-bit indices to an index variable, converting the values to the start index of the variable
+        /// @param[in] var The index variable
+        /// @param[in] start_index The start index of the values
+        /// @param[in] values_size The number of values
+        /// @param[in] values The values
+        void put_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int64_t const* values) const;
+
+        /// @brief Gets the offset to add to the values of an index variable to obtain a given start index
+        /// @param var [in] The index variable
+        /// @param start_index [in] The requested start index
+        /// @param fill_value [out] The fill value of the variable
+        /// @return The offset, 0 if the variable has no "start_index" attribute
+        int get_index_offset(netCDF::NcVar const& var, int start_index, int& fill_value) const;
+
         /// @brief Method collecting common operations for defining a UGrid entity to file
         /// @param entity_name [in] The entity name
         /// @param start_index [in] The start_index of indices arrays
@@ -182,17 +216,6 @@ namespace ugrid
         /// @param grid_mapping [in] The name of the variable that defines the coordinate system
         void define(char const* const entity_name, int start_index, std::string const& long_name, int topology_dimension, int is_spherical, char const* const grid_mapping);
 
-        /// @brief A function to determine if a variable is a topology variable (this function might get overwritten in derived if necessary)
-        /// @param attributes [in] The variable attributes
-        /// @return True if the variable is a topology variable
-        static bool is_topology_variable(std::map<std::string, netCDF::NcVarAtt> const& attributes);
-
-        /// @brief A function to determine if a topology variable has a matching dimensionality
-        /// @param attributes [in] The variable attributes
-        /// @param entity_dimensionality [in] The sought dimensionality
-        /// @return If The topology variable has a matching functionality
-        static bool has_matching_dimensionality(std::map<std::string, netCDF::NcVarAtt> const& attributes, int entity_dimensionality);
-
         /// @brief Find the names aliases (e.g. previous naming convention used plurals)
         /// @param variable_name [in] The variable name
         /// @return An iterator to \ref m_topology_attribute_variables
@@ -284,6 +307,7 @@ namespace ugrid
         std::map<std::string, netCDF::NcVarAtt> m_topology_attributes; ///< The attributes of the topology variable
         std::map<std::string, netCDF::NcVar> m_related_variables;      ///< Additional variables related to the entity (for example defined on node, edge or face)
         std::string m_entity_name = "";                                ///< The name of the entity
+        std::map<std::string, VariableStorage> m_variable_storage;     ///< The chunking and compression settings of the variables to define
 
         std::string m_grid_mapping = "";                   ///< The name of the variable that defines the coordinate system
         bool m_spherical_coordinates = false;              ///< If it is a spherical entity
@@ -293,6 +317,22 @@ namespace ugrid
         int m_epsg_code = 0;                               ///< The epsg code
 
     private:
+        /// @brief The indexing convention of an index variable, read once from its attributes
+        struct IndexConvention
+        {
+            int start_index = 0;                ///< The "start_index" attribute value
+            int fill_value = int_missing_value; ///< The "_FillValue" attribute value, marking unused entries
+        };
+
+        /// @brief Reads the indexing conventions of the index variables of an entity read from file
+        void read_index_conventions();
+
+        std::map<int, IndexConvention> m_index_conventions; ///< The indexing conventions of the index variables with a "start_index" attribute, keyed by variable id
+
+        /// @brief Applies the chunking and compression settings registered for a newly defined variable, if any
+        /// @param variable [in] The newly defined variable
+        void apply_registered_variable_storage(netCDF::NcVar const& variable) const;
+
         /// @brief Produces the coordinate variable names, standard names, long names and units for a given location
         /// @param location [in] The entity location (node, edge or face) for which the names are produced
         /// @param long_name_pattern [in] The string pattern to use for producing the long name string
@@ -0,0 +1,109 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <netcdf>
+
+#include <stdexcept>
+#include <string>
+
+/// \namespace ugrid
+/// @brief Contains the logic of the C++ static library
+namespace ugrid
+{
+    /// @brief The chunking and compression settings of a variable, only supported by NetCDF-4 files
+    struct VariableStorage
+    {
+        int deflate_level = 0;           ///< The deflate level (0 disables compression, 9 is the strongest compression)
+        bool shuffle = true;             ///< If the shuffle filter is applied before deflating
+        std::vector<size_t> chunk_sizes; ///< The chunk shape, one entry per variable dimension (empty for the library default)
+    };
+
+    /// @brief The header and variable layout knobs applied when a classic file leaves define mode (see nc__enddef)
+    struct HeaderPadding
+    {
+        size_t header_free_space = 0;   ///< The free space reserved at the end of the header (h_minfree)
+        size_t variable_alignment = 4;  ///< The alignment of the start of the fixed-size variables (v_align)
+        size_t variable_free_space = 0; ///< The free space reserved after the fixed-size variables (v_minfree)
+        size_t record_alignment = 4;    ///< The alignment of the start of the record variables (r_align)
+    };
+
+    /// @brief Leaves define mode with the given padding, a file already in data mode is left as is
+    /// @param nc_file [in] The file
+    /// @param padding [in] The header and variable layout knobs
+    /// @param caller [in] The name of the calling function, used in the error message
+    static void end_define(netCDF::NcFile const& nc_file, HeaderPadding const& padding, std::string const& caller)
+    {
+        auto const status = nc__enddef(nc_file.getId(),
+                                       padding.header_free_space,
+                                       padding.variable_alignment,
+                                       padding.variable_free_space,
+                                       padding.record_alignment);
+        if (status != NC_NOERR && status != NC_ENOTINDEFINE)
+        {
+            throw std::runtime_error(caller + ": " + nc_strerror(status));
+        }
+    }
+
+    /// @brief Determines if a file uses the NetCDF-4 (HDF5) storage format
+    /// @param nc_file [in] The file
+    /// @return True if the file supports chunking and compression
+    static bool is_netcdf4_format(netCDF::NcFile const& nc_file)
+    {
+        int format = 0;
+        if (nc_inq_format(nc_file.getId(), &format) != NC_NOERR)
+        {
+            return false;
+        }
+        return format == NC_FORMAT_NETCDF4 || format == NC_FORMAT_NETCDF4_CLASSIC;
+    }
+
+    /// @brief Applies chunking and compression settings to a variable in define mode
+    /// @param variable [in] The variable
+    /// @param storage [in] The chunking and compression settings
+    static void apply_variable_storage(netCDF::NcVar const& variable, VariableStorage const& storage)
+    {
+        if (!storage.chunk_sizes.empty())
+        {
+            if (storage.chunk_sizes.size() != static_cast<size_t>(variable.getDimCount()))
+            {
+                throw std::invalid_argument("apply_variable_storage: The chunk shape of " + variable.getName() +
+                                            " does not match the number of dimensions of the variable.");
+            }
+            auto chunk_sizes = storage.chunk_sizes;
+            variable.setChunking(netCDF::NcVar::nc_CHUNKED, chunk_sizes);
+        }
+
+        if (storage.deflate_level > 0)
+        {
+            variable.setCompression(storage.shuffle, true, storage.deflate_level);
+        }
+    }
+
+} // namespace ugrid
@@ -156,8 +156,6 @@ void Contacts::define(ugridapi::Contacts const& contacts)
                                 netCDF::NcType::nc_CHAR,
                                 {UGridFileDimensions::node, UGridFileDimensions::long_name},
                                 {{"long_name", "long names of the contact"}});
-
-    m_nc_file->enddef();
 }
 
 void Contacts::put(ugridapi::Contacts const& contacts)
@@ -0,0 +1,291 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <UGrid/FaceLocator.hpp>
+#include <UGrid/Parallel.hpp>
+
+/// @brief The number of degrees of a full turn of longitude
+static constexpr double full_turn = 360.0;
+
+/// @brief The number of points located by one task of a batched query
+static constexpr size_t points_per_task = 4096;
+
+ugrid::FaceLocator::FaceLocator(double const* node_x,
+                                double const* node_y,
+                                size_t num_nodes,
+                                int const* face_nodes,
+                                size_t num_faces,
+                                size_t num_face_nodes_max,
+                                int start_index,
+                                int fill_value,
+                                bool is_spherical,
+                                size_t max_threads)
+    : m_node_x(node_x, node_x + num_nodes),
+      m_node_y(node_y, node_y + num_nodes),
+      m_face_nodes(num_faces * num_face_nodes_max, -1),
+      m_face_bounds(4 * num_faces),
+      m_num_face_nodes_max(num_face_nodes_max),
+      m_start_index(start_index),
+      m_fill_value(fill_value),
+      m_is_spherical(is_spherical)
+{
+    if (num_faces > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::overflow_error("FaceLocator: The number of faces exceeds the int range.");
+    }
+
+    // Convert the face nodes to 0-based indices and compute the face bounds
+    parallel_for_each_index(num_faces, max_threads, [&](size_t face)
+                            {
+                                double bounds[4] = {std::numeric_limits<double>::max(),
+                                                    std::numeric_limits<double>::max(),
+                                                    std::numeric_limits<double>::lowest(),
+                                                    std::numeric_limits<double>::lowest()};
+                                double reference = 0.0;
+                                bool is_first_node = true;
+                                for (size_t k = 0; k < num_face_nodes_max; ++k)
+                                {
+                                    auto const position = face * num_face_nodes_max + k;
+                                    if (face_nodes[position] == fill_value)
+                                    {
+                                        continue;
+                                    }
+                                    auto const node = static_cast<long long>(face_nodes[position]) - start_index;
+                                    if (node < 0 || static_cast<size_t>(node) >= num_nodes)
+                                    {
+                                        throw std::invalid_argument("FaceLocator: Invalid node index in face " + std::to_string(face) + ".");
+                                    }
+                                    m_face_nodes[position] = static_cast<int>(node);
+
+                                    // In spherical coordinates the face is unwrapped around its first node
+                                    auto const x = is_first_node ? m_node_x[node] : unwrap(m_node_x[node], reference);
+                                    reference = is_first_node ? x : reference;
+                                    is_first_node = false;
+                                    bounds[0] = std::min(bounds[0], x);
+                                    bounds[1] = std::min(bounds[1], m_node_y[node]);
+                                    bounds[2] = std::max(bounds[2], x);
+                                    bounds[3] = std::max(bounds[3], m_node_y[node]);
+                                }
+                                std::copy(bounds, bounds + 4, m_face_bounds.begin() + 4 * face);
+                            });
+
+    // The bucket grid covers all faces, with about one bucket per face
+    double max_x = std::numeric_limits<double>::lowest();
+    double max_y = std::numeric_limits<double>::lowest();
+    m_min_x = std::numeric_limits<double>::max();
+    m_min_y = std::numeric_limits<double>::max();
+    for (size_t face = 0; face < num_faces; ++face)
+    {
+        m_min_x = std::min(m_min_x, m_face_bounds[4 * face]);
+        m_min_y = std::min(m_min_y, m_face_bounds[4 * face + 1]);
+        max_x = std::max(max_x, m_face_bounds[4 * face + 2]);
+        max_y = std::max(max_y, m_face_bounds[4 * face + 3]);
+    }
+    if (m_min_x > max_x || m_min_y > max_y)
+    {
+        m_min_x = m_min_y = 0.0;
+        max_x = max_y = 0.0;
+    }
+    if (m_is_spherical)
+    {
+        // Longitudes span a full turn from the smallest node longitude
+        m_min_x = m_node_x.empty() ? 0.0 : *std::min_element(m_node_x.begin(), m_node_x.end());
+        max_x = m_min_x + full_turn;
+    }
+    auto const extent_x = std::max(max_x - m_min_x, std::numeric_limits<double>::epsilon());
+    auto const extent_y = std::max(max_y - m_min_y, std::numeric_limits<double>::epsilon());
+    auto const num_buckets_target = static_cast<double>(std::max<size_t>(num_faces, 1));
+    m_num_columns = static_cast<size_t>(std::clamp(std::round(std::sqrt(num_buckets_target * extent_x / extent_y)), 1.0, num_buckets_target));
+    m_num_rows = static_cast<size_t>(std::clamp(std::ceil(num_buckets_target / static_cast<double>(m_num_columns)), 1.0, num_buckets_target));
+    m_bucket_width = extent_x / static_cast<double>(m_num_columns);
+    m_bucket_height = extent_y / static_cast<double>(m_num_rows);
+
+    // Calls a function for each bucket overlapped by the bounding box of a face
+    auto const for_each_bucket = [this](size_t face, auto const& function)
+    {
+        auto const* const bounds = &m_face_bounds[4 * face];
+        if (bounds[0] > bounds[2])
+        {
+            return;
+        }
+        auto const num_columns = static_cast<long long>(m_num_columns);
+        auto const num_rows = static_cast<long long>(m_num_rows);
+        auto first_column = static_cast<long long>(std::floor((bounds[0] - m_min_x) / m_bucket_width));
+        auto last_column = static_cast<long long>(std::floor((bounds[2] - m_min_x) / m_bucket_width));
+        if (!m_is_spherical)
+        {
+            first_column = std::clamp(first_column, 0LL, num_columns - 1);
+            last_column = std::clamp(last_column, 0LL, num_columns - 1);
+        }
+        else if (last_column - first_column + 1 >= num_columns)
+        {
+            first_column = 0;
+            last_column = num_columns - 1;
+        }
+        auto const first_row = std::clamp(static_cast<long long>(std::floor((bounds[1] - m_min_y) / m_bucket_height)), 0LL, num_rows - 1);
+        auto const last_row = std::clamp(static_cast<long long>(std::floor((bounds[3] - m_min_y) / m_bucket_height)), 0LL, num_rows - 1);
+
+        for (auto row = first_row; row <= last_row; ++row)
+        {
+            for (auto column = first_column; column <= last_column; ++column)
+            {
+                // Columns beyond the wrap continue at the other end of the grid
+                auto const wrapped_column = (column % num_columns + num_columns) % num_columns;
+                function(static_cast<size_t>(row * num_columns + wrapped_column));
+            }
+        }
+    };
+
+    // Count the faces of each bucket, then scatter them
+    auto const num_buckets = m_num_columns * m_num_rows;
+    std::vector<std::atomic<int>> bucket_counts(num_buckets);
+    parallel_for_each_index(num_faces, max_threads, [&](size_t face)
+                            {
+                                for_each_bucket(face, [&bucket_counts](size_t bucket)
+                                                { bucket_counts[bucket].fetch_add(1, std::memory_order_relaxed); });
+                            });
+
+    m_bucket_offsets.resize(num_buckets + 1, 0);
+    size_t num_entries = 0;
+    for (size_t bucket = 0; bucket < num_buckets; ++bucket)
+    {
+        num_entries += static_cast<size_t>(bucket_counts[bucket].load());
+        if (num_entries > static_cast<size_t>(std::numeric_limits<int>::max()))
+        {
+            throw std::overflow_error("FaceLocator: The number of bucket entries exceeds the int range.");
+        }
+        m_bucket_offsets[bucket + 1] = static_cast<int>(num_entries);
+        bucket_counts[bucket].store(0);
+    }
+
+    m_bucket_faces.resize(num_entries);
+    parallel_for_each_index(num_faces, max_threads, [&](size_t face)
+                            {
+                                for_each_bucket(face, [&](size_t bucket)
+                                                {
+                                                    auto const slot = bucket_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+                                                    m_bucket_faces[static_cast<size_t>(m_bucket_offsets[bucket] + slot)] = static_cast<int>(face);
+                                                });
+                            });
+
+    // The scatter order depends on the threads, sorting the buckets makes the queries deterministic
+    parallel_for_each_index(num_buckets, max_threads, [&](size_t bucket)
+                            {
+                                std::sort(m_bucket_faces.begin() + m_bucket_offsets[bucket], m_bucket_faces.begin() + m_bucket_offsets[bucket + 1]);
+                            });
+}
+
+double ugrid::FaceLocator::unwrap(double x, double reference) const
+{
+    if (!m_is_spherical)
+    {
+        return x;
+    }
+    return x - full_turn * std::round((x - reference) / full_turn);
+}
+
+bool ugrid::FaceLocator::contains(size_t face, double x, double y) const
+{
+    auto const* const nodes = &m_face_nodes[face * m_num_face_nodes_max];
+    auto const num_nodes = static_cast<size_t>(std::count_if(nodes, nodes + m_num_face_nodes_max, [](int node)
+                                                             { return node >= 0; }));
+    if (num_nodes < 3)
+    {
+        return false;
+    }
+
+    // Valid nodes precede the padding
+    bool inside = false;
+    auto const reference = m_face_bounds[4 * face];
+    for (size_t i = 0, j = num_nodes - 1; i < num_nodes; j = i++)
+    {
+        auto const xi = unwrap(m_node_x[nodes[i]], reference);
+        auto const yi = m_node_y[nodes[i]];
+        auto const xj = unwrap(m_node_x[nodes[j]], reference);
+        auto const yj = m_node_y[nodes[j]];
+        if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi)
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+int ugrid::FaceLocator::locate(double x, double y) const
+{
+    if (m_is_spherical)
+    {
+        x = m_min_x + std::fmod(std::fmod(x - m_min_x, full_turn) + full_turn, full_turn);
+    }
+
+    // Points on the upper boundary belong to the last bucket
+    auto const column = std::floor((x - m_min_x) / m_bucket_width);
+    auto const row = std::floor((y - m_min_y) / m_bucket_height);
+    if (!(column >= 0.0 && row >= 0.0 && column <= static_cast<double>(m_num_columns) && row <= static_cast<double>(m_num_rows)))
+    {
+        return m_fill_value;
+    }
+    auto const bucket_column = std::min(static_cast<size_t>(column), m_num_columns - 1);
+    auto const bucket_row = std::min(static_cast<size_t>(row), m_num_rows - 1);
+
+    auto const bucket = bucket_row * m_num_columns + bucket_column;
+    for (auto i = m_bucket_offsets[bucket]; i < m_bucket_offsets[bucket + 1]; ++i)
+    {
+        auto const face = static_cast<size_t>(m_bucket_faces[i]);
+        auto const* const bounds = &m_face_bounds[4 * face];
+        auto const face_x = unwrap(x, 0.5 * (bounds[0] + bounds[2]));
+        if (face_x < bounds[0] || face_x > bounds[2] || y < bounds[1] || y > bounds[3])
+        {
+            continue;
+        }
+        if (contains(face, face_x, y))
+        {
+            return static_cast<int>(face) + m_start_index;
+        }
+    }
+    return m_fill_value;
+}
+
+void ugrid::FaceLocator::locate(double const* x, double const* y, size_t num_points, size_t max_threads, int* faces) const
+{
+    auto const num_tasks = (num_points + points_per_task - 1) / points_per_task;
+    parallel_for(num_tasks, max_threads, [&](size_t task)
+                 {
+                     auto const end = std::min(num_points, (task + 1) * points_per_task);
+                     for (auto point = task * points_per_task; point < end; ++point)
+                     {
+                         faces[point] = locate(x[point], y[point]);
+                     }
+                 });
+}
@@ -0,0 +1,93 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <UGrid/IndexOffset.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UGRID_INDEX_OFFSET_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UGRID_INDEX_OFFSET_SSE2
+#endif
+
+void ugrid::add_index_offset(int offset, int fill_value, size_t size, int* values)
+{
+    if (offset == 0 || values == nullptr)
+    {
+        return;
+    }
+
+    size_t i = 0;
+
+#if defined(UGRID_INDEX_OFFSET_AVX2)
+    // Eight indices at a time: the offset is masked out where a value equals the fill value
+    __m256i const offset_vector = _mm256_set1_epi32(offset);
+    __m256i const fill_vector = _mm256_set1_epi32(fill_value);
+    for (; i + 8 <= size; i += 8)
+    {
+        auto* const address = reinterpret_cast<__m256i*>(values + i);
+        __m256i const indices = _mm256_loadu_si256(address);
+        __m256i const is_fill = _mm256_cmpeq_epi32(indices, fill_vector);
+        _mm256_storeu_si256(address, _mm256_add_epi32(indices, _mm256_andnot_si256(is_fill, offset_vector)));
+    }
+#elif defined(UGRID_INDEX_OFFSET_SSE2)
+    // Four indices at a time: the offset is masked out where a value equals the fill value
+    __m128i const offset_vector = _mm_set1_epi32(offset);
+    __m128i const fill_vector = _mm_set1_epi32(fill_value);
+    for (; i + 4 <= size; i += 4)
+    {
+        auto* const address = reinterpret_cast<__m128i*>(values + i);
+        __m128i const indices = _mm_loadu_si128(address);
+        __m128i const is_fill = _mm_cmpeq_epi32(indices, fill_vector);
+        _mm_storeu_si128(address, _mm_add_epi32(indices, _mm_andnot_si128(is_fill, offset_vector)));
+    }
+#endif
+
+    // Remaining values, or all values without SIMD support
+    for (; i < size; ++i)
+    {
+        if (values[i] != fill_value)
+        {
+            values[i] += offset;
+        }
+    }
+}
+
+void ugrid::add_index_offset(int64_t offset, int64_t fill_value, size_t size, int64_t* values)
+{
+    if (offset == 0 || values == nullptr)
+    {
+        return;
+    }
+
+    // Branch-free, so the compiler can vectorize it for the enabled instruction set
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] += values[i] == fill_value ? 0 : offset;
+    }
+}
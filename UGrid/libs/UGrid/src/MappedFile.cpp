@@ -0,0 +1,555 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <UGrid/MappedFile.hpp>
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <netcdf.h>
+
+#include <UGrid/IndexOffset.hpp>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UGRID_BYTE_SWAP_AVX2
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define UGRID_BYTE_SWAP_SSSE3
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UGRID_BYTE_SWAP_SSE2
+#endif
+
+using ugrid::MappedFile;
+using ugrid::MappedVariable;
+
+namespace
+{
+    // The tags of the header lists, see the classic format specification
+    constexpr uint32_t absent_tag = 0x00;
+    constexpr uint32_t dimension_tag = 0x0A;
+    constexpr uint32_t variable_tag = 0x0B;
+    constexpr uint32_t attribute_tag = 0x0C;
+
+    /// @brief Gets the size in bytes of a value of a classic netCDF type
+    /// @param type [in] The netCDF type
+    /// @return The size, throws for types the classic formats do not have
+    size_t get_type_size(int type)
+    {
+        switch (type)
+        {
+        case NC_BYTE:
+        case NC_CHAR:
+        case NC_UBYTE:
+            return 1;
+        case NC_SHORT:
+        case NC_USHORT:
+            return 2;
+        case NC_INT:
+        case NC_FLOAT:
+        case NC_UINT:
+            return 4;
+        case NC_DOUBLE:
+        case NC_INT64:
+        case NC_UINT64:
+            return 8;
+        default:
+            throw std::runtime_error("MappedFile: Unknown type " + std::to_string(type) + " in the header.");
+        }
+    }
+
+    /// @brief Reads the big-endian header fields of a classic netCDF file
+    class HeaderReader
+    {
+    public:
+        /// @brief Constructor
+        /// @param data [in] The start of the file
+        /// @param size [in] The size of the file
+        /// @param version [in] The format version: 1 (CDF-1), 2 (CDF-2, 64-bit offsets) or 5 (CDF-5, 64-bit data)
+        HeaderReader(char const* data, size_t size, int version) : m_data(data), m_size(size), m_version(version)
+        {
+        }
+
+        /// @brief Reads a 4-byte tag or type
+        /// @return The value
+        uint32_t read_uint32()
+        {
+            return static_cast<uint32_t>(read_big_endian(4));
+        }
+
+        /// @brief Reads a count or length, 8 bytes in CDF-5 and 4 bytes otherwise
+        /// @return The value
+        size_t read_count()
+        {
+            return static_cast<size_t>(read_big_endian(m_version == 5 ? 8 : 4));
+        }
+
+        /// @brief Reads a variable offset, 4 bytes in CDF-1 and 8 bytes otherwise
+        /// @return The value
+        size_t read_offset()
+        {
+            return static_cast<size_t>(read_big_endian(m_version == 1 ? 4 : 8));
+        }
+
+        /// @brief Reads a name, padded to 4 bytes
+        /// @return The name
+        std::string read_name()
+        {
+            auto const length = read_count();
+            check_available(length);
+            std::string name(m_data + m_position, length);
+            skip(length);
+            return name;
+        }
+
+        /// @brief Skips values, padded to 4 bytes
+        /// @param num_bytes [in] The number of bytes of the values
+        void skip(size_t num_bytes)
+        {
+            auto const padded = (num_bytes + 3) / 4 * 4;
+            check_available(padded);
+            m_position += padded;
+        }
+
+        /// @brief Reads the tag and length of a list, which is absent if both are zero
+        /// @param expected_tag [in] The tag of the list
+        /// @return The number of elements
+        size_t read_list_header(uint32_t expected_tag)
+        {
+            auto const tag = read_uint32();
+            auto const num_elements = read_count();
+            if (tag != expected_tag && !(tag == absent_tag && num_elements == 0))
+            {
+                throw std::runtime_error("MappedFile: Unexpected tag in the header.");
+            }
+            return num_elements;
+        }
+
+        /// @brief Skips a list of attributes
+        void skip_attributes()
+        {
+            auto const num_attributes = read_list_header(attribute_tag);
+            for (size_t i = 0; i < num_attributes; ++i)
+            {
+                read_name();
+                auto const type = static_cast<int>(read_uint32());
+                auto const num_values = read_count();
+                skip(num_values * get_type_size(type));
+            }
+        }
+
+    private:
+        /// @brief Throws if the header is shorter than needed
+        /// @param num_bytes [in] The number of bytes to read
+        void check_available(size_t num_bytes) const
+        {
+            if (num_bytes > m_size - m_position)
+            {
+                throw std::runtime_error("MappedFile: The header is truncated.");
+            }
+        }
+
+        /// @brief Reads a big-endian unsigned integer
+        /// @param num_bytes [in] The number of bytes, 4 or 8
+        /// @return The value
+        uint64_t read_big_endian(size_t num_bytes)
+        {
+            check_available(num_bytes);
+            uint64_t value = 0;
+            for (size_t i = 0; i < num_bytes; ++i)
+            {
+                value = value << 8 | static_cast<unsigned char>(m_data[m_position + i]);
+            }
+            m_position += num_bytes;
+            return value;
+        }
+
+        char const* m_data;    ///< The start of the file
+        size_t m_size;         ///< The size of the file
+        int m_version;         ///< The format version
+        size_t m_position = 0; ///< The current position
+    };
+
+    /// @brief Gets the format version from the magic number at the start of a file
+    /// @param magic [in] The first four bytes of the file
+    /// @return 1, 2 or 5 for the classic formats, 0 otherwise
+    int get_classic_version(char const* magic)
+    {
+        if (magic[0] != 'C' || magic[1] != 'D' || magic[2] != 'F')
+        {
+            return 0;
+        }
+        auto const version = static_cast<int>(magic[3]);
+        return version == 1 || version == 2 || version == 5 ? version : 0;
+    }
+
+    /// @brief Reverses the byte order of 4-byte values in place
+    /// @param size [in] The number of values
+    /// @param values [in,out] The values
+    void swap_bytes_4(size_t size, char* values)
+    {
+        size_t i = 0;
+
+#if defined(UGRID_BYTE_SWAP_AVX2)
+        // Eight values at a time, reversing the bytes within each 4-byte lane
+        __m256i const mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        for (; i + 8 <= size; i += 8)
+        {
+            auto* const address = reinterpret_cast<__m256i*>(values + i * 4);
+            _mm256_storeu_si256(address, _mm256_shuffle_epi8(_mm256_loadu_si256(address), mask));
+        }
+#elif defined(UGRID_BYTE_SWAP_SSSE3)
+        // Four values at a time, reversing the bytes within each 4-byte lane
+        __m128i const mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        for (; i + 4 <= size; i += 4)
+        {
+            auto* const address = reinterpret_cast<__m128i*>(values + i * 4);
+            _mm_storeu_si128(address, _mm_shuffle_epi8(_mm_loadu_si128(address), mask));
+        }
+#elif defined(UGRID_BYTE_SWAP_SSE2)
+        // Four values at a time: the bytes of each 16-bit word are swapped, then the words of each value
+        for (; i + 4 <= size; i += 4)
+        {
+            auto* const address = reinterpret_cast<__m128i*>(values + i * 4);
+            __m128i const words = _mm_loadu_si128(address);
+            __m128i const swapped = _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+            _mm_storeu_si128(address, _mm_shufflehi_epi16(_mm_shufflelo_epi16(swapped, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+#endif
+
+        // Remaining values, or all values without SIMD support
+        for (; i < size; ++i)
+        {
+            uint32_t value = 0;
+            std::memcpy(&value, values + i * 4, 4);
+            value = (value >> 24) | ((value >> 8) & 0x0000ff00U) | ((value << 8) & 0x00ff0000U) | (value << 24);
+            std::memcpy(values + i * 4, &value, 4);
+        }
+    }
+
+    /// @brief Reverses the byte order of 8-byte values in place
+    /// @param size [in] The number of values
+    /// @param values [in,out] The values
+    void swap_bytes_8(size_t size, char* values)
+    {
+        size_t i = 0;
+
+#if defined(UGRID_BYTE_SWAP_AVX2)
+        // Four values at a time, reversing the bytes within each 8-byte lane
+        __m256i const mask = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                              7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        for (; i + 4 <= size; i += 4)
+        {
+            auto* const address = reinterpret_cast<__m256i*>(values + i * 8);
+            _mm256_storeu_si256(address, _mm256_shuffle_epi8(_mm256_loadu_si256(address), mask));
+        }
+#elif defined(UGRID_BYTE_SWAP_SSSE3)
+        // Two values at a time, reversing the bytes within each 8-byte lane
+        __m128i const mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        for (; i + 2 <= size; i += 2)
+        {
+            auto* const address = reinterpret_cast<__m128i*>(values + i * 8);
+            _mm_storeu_si128(address, _mm_shuffle_epi8(_mm_loadu_si128(address), mask));
+        }
+#elif defined(UGRID_BYTE_SWAP_SSE2)
+        // Two values at a time: the bytes of each 16-bit word are swapped, then the words of each value are reversed
+        for (; i + 2 <= size; i += 2)
+        {
+            auto* const address = reinterpret_cast<__m128i*>(values + i * 8);
+            __m128i const words = _mm_loadu_si128(address);
+            __m128i const swapped = _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+            _mm_storeu_si128(address, _mm_shufflehi_epi16(_mm_shufflelo_epi16(swapped, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+#endif
+
+        // Remaining values, or all values without SIMD support. Compilers turn the masks into a single byte swap instruction
+        for (; i < size; ++i)
+        {
+            uint64_t value = 0;
+            std::memcpy(&value, values + i * 8, 8);
+            value = (value >> 32) | (value << 32);
+            value = ((value & 0xffff0000ffff0000ULL) >> 16) | ((value & 0x0000ffff0000ffffULL) << 16);
+            value = ((value & 0xff00ff00ff00ff00ULL) >> 8) | ((value & 0x00ff00ff00ff00ffULL) << 8);
+            std::memcpy(values + i * 8, &value, 8);
+        }
+    }
+} // namespace
+
+MappedFile::MappedFile(std::string const& file_path)
+{
+#if defined(_WIN32)
+    HANDLE const file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("MappedFile: Could not open " + file_path + ".");
+    }
+    LARGE_INTEGER file_size{};
+    if (GetFileSizeEx(file, &file_size) == 0 || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("MappedFile: Could not get the size of " + file_path + " or it is empty.");
+    }
+    m_size = static_cast<size_t>(file_size.QuadPart);
+
+    // A copy-on-write view: pages written by the in-place conversion become private to the process
+    HANDLE const mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        throw std::runtime_error("MappedFile: Could not map " + file_path + ".");
+    }
+    m_data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+    CloseHandle(mapping);
+    if (m_data == nullptr)
+    {
+        throw std::runtime_error("MappedFile: Could not map " + file_path + ".");
+    }
+#else
+    auto const file = open(file_path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        throw std::runtime_error("MappedFile: Could not open " + file_path + ".");
+    }
+    struct stat file_status
+    {
+    };
+    if (fstat(file, &file_status) != 0 || file_status.st_size == 0)
+    {
+        close(file);
+        throw std::runtime_error("MappedFile: Could not get the size of " + file_path + " or it is empty.");
+    }
+    m_size = static_cast<size_t>(file_status.st_size);
+
+    // A copy-on-write view: pages written by the in-place conversion become private to the process
+    auto* const data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("MappedFile: Could not map " + file_path + ".");
+    }
+    m_data = static_cast<char*>(data);
+#endif
+
+    try
+    {
+        parse_header();
+    }
+    catch (...)
+    {
+        unmap();
+        throw;
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+void MappedFile::unmap()
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+#else
+    munmap(m_data, m_size);
+#endif
+    m_data = nullptr;
+}
+
+bool MappedFile::is_classic_format(std::string const& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    std::array<char, 4> magic{};
+    if (!file.read(magic.data(), magic.size()))
+    {
+        return false;
+    }
+    return get_classic_version(magic.data()) != 0;
+}
+
+void MappedFile::parse_header()
+{
+    if (m_size < 4 || get_classic_version(m_data) == 0)
+    {
+        throw std::invalid_argument("MappedFile: Only classic format (CDF-1, CDF-2 and CDF-5) files can be mapped.");
+    }
+    HeaderReader reader(m_data, m_size, get_classic_version(m_data));
+    reader.skip(4);
+    reader.read_count();
+
+    // The record dimension has length zero in the header
+    auto const num_dimensions = reader.read_list_header(dimension_tag);
+    std::vector<size_t> dimension_lengths(num_dimensions);
+    for (auto& length : dimension_lengths)
+    {
+        reader.read_name();
+        length = reader.read_count();
+    }
+
+    reader.skip_attributes();
+
+    auto const num_variables = reader.read_list_header(variable_tag);
+    for (size_t v = 0; v < num_variables; ++v)
+    {
+        auto const name = reader.read_name();
+        MappedVariable variable;
+        auto const num_variable_dimensions = reader.read_count();
+        variable.num_values = 1;
+        for (size_t d = 0; d < num_variable_dimensions; ++d)
+        {
+            auto const dimension = reader.read_count();
+            if (dimension >= dimension_lengths.size())
+            {
+                throw std::runtime_error("MappedFile: The variable " + name + " refers to an unknown dimension.");
+            }
+            variable.shape.emplace_back(dimension_lengths[dimension]);
+            if (dimension_lengths[dimension] == 0 && d == 0)
+            {
+                variable.is_record = true;
+            }
+            else
+            {
+                variable.num_values *= dimension_lengths[dimension];
+            }
+        }
+        reader.skip_attributes();
+        variable.type = static_cast<int>(reader.read_uint32());
+        reader.read_count();
+        variable.begin = reader.read_offset();
+
+        auto const num_bytes = variable.num_values * get_type_size(variable.type);
+        if (!variable.is_record && (variable.begin > m_size || num_bytes > m_size - variable.begin))
+        {
+            throw std::runtime_error("MappedFile: The values of " + name + " lie beyond the end of the file.");
+        }
+        m_variables.emplace(name, std::move(variable));
+    }
+}
+
+MappedVariable const& MappedFile::get_variable(std::string const& name) const
+{
+    auto const it = m_variables.find(name);
+    if (it == m_variables.end())
+    {
+        throw std::invalid_argument("MappedFile: The variable " + name + " does not exist.");
+    }
+    return it->second;
+}
+
+std::pair<MappedVariable*, char*> MappedFile::get_native_values(std::string const& name, int type)
+{
+    auto const it = m_variables.find(name);
+    if (it == m_variables.end())
+    {
+        throw std::invalid_argument("MappedFile: The variable " + name + " does not exist.");
+    }
+    auto& variable = it->second;
+    if (variable.type != type)
+    {
+        throw std::invalid_argument("MappedFile: The variable " + name + " does not have the requested type.");
+    }
+    if (variable.is_record)
+    {
+        throw std::invalid_argument("MappedFile: The variable " + name + " is a record variable, its values are not contiguous.");
+    }
+
+    auto const type_size = get_type_size(type);
+    auto* values = m_data + variable.begin;
+    if (!variable.is_prepared)
+    {
+        // The classic formats align variables to 4 bytes only, so 8-byte values may need an aligned copy
+        if (reinterpret_cast<uintptr_t>(values) % type_size != 0)
+        {
+            variable.aligned_values.resize((variable.num_values * type_size + 7) / 8);
+            std::memcpy(variable.aligned_values.data(), values, variable.num_values * type_size);
+        }
+        if (!variable.aligned_values.empty())
+        {
+            values = reinterpret_cast<char*>(variable.aligned_values.data());
+        }
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (type_size == 4)
+            {
+                swap_bytes_4(variable.num_values, values);
+            }
+            else
+            {
+                swap_bytes_8(variable.num_values, values);
+            }
+        }
+        variable.is_prepared = true;
+    }
+    if (!variable.aligned_values.empty())
+    {
+        values = reinterpret_cast<char*>(variable.aligned_values.data());
+    }
+    return {&variable, values};
+}
+
+double* MappedFile::get_doubles(std::string const& name)
+{
+    return reinterpret_cast<double*>(get_native_values(name, NC_DOUBLE).second);
+}
+
+int* MappedFile::get_indices(std::string const& name, int offset, int fill_value)
+{
+    auto const [variable, data] = get_native_values(name, NC_INT);
+    auto* const values = reinterpret_cast<int*>(data);
+    add_index_offset(static_cast<int>(offset - variable->index_offset), fill_value, variable->num_values, values);
+    variable->index_offset = offset;
+    return values;
+}
+
+int64_t* MappedFile::get_indices_long(std::string const& name, int offset, int64_t fill_value)
+{
+    auto const [variable, data] = get_native_values(name, NC_INT64);
+    auto* const values = reinterpret_cast<int64_t*>(data);
+    add_index_offset(offset - variable->index_offset, fill_value, variable->num_values, values);
+    variable->index_offset = offset;
+    return values;
+}
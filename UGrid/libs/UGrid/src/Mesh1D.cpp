@@ -176,8 +176,6 @@ void Mesh1D::define(ugridapi::Mesh1D const& mesh1d)
             define_topology_coordinates(UGridEntityLocations::edge, "{} of mesh edge");
         }
     }
-
-    m_nc_file->enddef();
 }
 
 void Mesh1D::put(ugridapi::Mesh1D const& mesh1d)
@@ -204,7 +202,7 @@ void Mesh1D::put(ugridapi::Mesh1D const& mesh1d)
     }
     if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); mesh1d.edge_nodes != nullptr && it != m_topology_attribute_variables.end())
     {
-        it->second.at(0).putVar(mesh1d.edge_nodes);
+        put_indices(it->second.at(0), mesh1d.start_index, static_cast<size_t>(mesh1d.num_edges) * 2, mesh1d.edge_nodes);
     }
 }
 
@@ -247,8 +245,6 @@ void Mesh1D::get(ugridapi::Mesh1D& mesh1d) const
     }
     if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); mesh1d.edge_nodes != nullptr && it != m_topology_attribute_variables.end())
     {
-        const auto var = it->second.at(0);
-        var.getVar(mesh1d.edge_nodes);
-        apply_start_index_offset(var, mesh1d.start_index, mesh1d.num_edges * 2, mesh1d.edge_nodes);
+        get_indices(it->second.at(0), mesh1d.start_index, static_cast<size_t>(mesh1d.num_edges) * 2, mesh1d.edge_nodes);
     }
 }
@@ -25,12 +25,28 @@
 //
 //------------------------------------------------------------------------------
 
+#include <limits>
+
+#include <netcdf.h>
+
+#include <UGrid/IndexOffset.hpp>
 #include <UGrid/Mesh2D.hpp>
 #include <UGrid/Operations.hpp>
 #include <UGrid/UGridVarAttributeStringBuilder.hpp>
 
 using ugrid::Mesh2D;
 
+/// @brief The number of faces read or written at once when converting between the ragged and the padded face connectivity
+static constexpr size_t faces_per_block = 65536;
+
+/// @brief Narrows a dimension size to a 32-bit count
+/// @param size The dimension size
+/// @return The count, -1 if it exceeds the int range
+static int narrow_count(size_t size)
+{
+    return size > static_cast<size_t>(std::numeric_limits<int>::max()) ? -1 : static_cast<int>(size);
+}
+
 Mesh2D::Mesh2D(std::shared_ptr<netCDF::NcFile> nc_file) : UGridEntity(nc_file)
 {
 }
@@ -55,13 +71,18 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
     UGridEntity::define(mesh2d.name, mesh2d.start_index, "Topology data of 2D mesh", 2, mesh2d.is_spherical, mesh2d.grid_mapping);
     auto string_builder = UGridVarAttributeStringBuilder(m_entity_name);
 
+    auto const num_nodes = get_mesh2d_count(mesh2d.num_nodes, mesh2d.num_nodes_long);
+    auto const num_edges = get_mesh2d_count(mesh2d.num_edges, mesh2d.num_edges_long);
+    auto const num_faces = get_mesh2d_count(mesh2d.num_faces, mesh2d.num_faces_long);
+    netCDF::NcType const index_type = mesh2d.connectivity_int64 != 0 ? netCDF::NcType::nc_INT64 : netCDF::NcType::nc_INT;
+
     // node variables
-    if (mesh2d.num_nodes > 0)
+    if (num_nodes > 0)
     {
         // Define node dimensions
         string_builder.clear();
         string_builder << "_nNodes";
-        m_dimensions.insert({UGridFileDimensions::node, m_nc_file->addDim(string_builder.str(), mesh2d.num_nodes)});
+        m_dimensions.insert({UGridFileDimensions::node, m_nc_file->addDim(string_builder.str(), num_nodes)});
         m_topology_attributes.insert({"node_dimension", m_topology_variable.putAtt("node_dimension", string_builder.str())});
 
         // Define coordinates
@@ -80,12 +101,12 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
     }
 
     // edge variables
-    if (mesh2d.num_edges)
+    if (num_edges > 0)
     {
         // Define edge dimensions
         string_builder.clear();
         string_builder << "_nEdges";
-        m_dimensions.insert({UGridFileDimensions::edge, m_nc_file->addDim(string_builder.str(), mesh2d.num_edges)});
+        m_dimensions.insert({UGridFileDimensions::edge, m_nc_file->addDim(string_builder.str(), num_edges)});
 
         // Define edge_dimension topology attribute
         define_topological_attribute("edge_dimension", string_builder.str());
@@ -96,7 +117,7 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
         define_topological_attribute("edge_node_connectivity", string_builder.str());
         define_topological_variable("edge_node_connectivity",
                                     "edge_nodes",
-                                    netCDF::NcType::nc_INT,
+                                    index_type,
                                     {UGridFileDimensions::edge, UGridFileDimensions::Two},
                                     {{"long_name", "Start and end node of mesh edge"}}, true);
 
@@ -108,12 +129,12 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
     }
 
     // face variables
-    if (mesh2d.num_faces > 0)
+    if (num_faces > 0)
     {
         // Define face dimensions
         string_builder.clear();
         string_builder << "_nFaces";
-        m_dimensions.insert({UGridFileDimensions::face, m_nc_file->addDim(string_builder.str(), mesh2d.num_faces)});
+        m_dimensions.insert({UGridFileDimensions::face, m_nc_file->addDim(string_builder.str(), num_faces)});
         define_topological_attribute("face_dimension", string_builder.str());
 
         string_builder.clear();
@@ -127,7 +148,7 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
         define_topological_attribute("face_node_connectivity", string_builder.str());
         define_topological_variable("face_node_connectivity",
                                     "face_nodes",
-                                    netCDF::NcType::nc_INT,
+                                    index_type,
                                     {UGridFileDimensions::face, UGridFileDimensions::max_face_node},
                                     {{"long_name", "Vertex node of mesh face(counterclockwise)"}}, true, true);
 
@@ -149,7 +170,7 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
         }
 
         // Define optional variables
-        if (mesh2d.face_edges != nullptr)
+        if (mesh2d.face_edges != nullptr || mesh2d.face_edges_long != nullptr)
         {
             // Define face_edges topology attribute and variable
             string_builder.clear();
@@ -157,11 +178,11 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
             define_topological_attribute("face_edge_connectivity", string_builder.str());
             define_topological_variable("face_edge_connectivity",
                                         "face_edges",
-                                        netCDF::NcType::nc_INT,
+                                        index_type,
                                         {UGridFileDimensions::face, UGridFileDimensions::max_face_node},
                                         {{"long_name", "Side edge of mesh face (counterclockwise)"}}, true, true);
         }
-        if (mesh2d.face_faces != nullptr)
+        if (mesh2d.face_faces != nullptr || mesh2d.face_faces_long != nullptr)
         {
             // Define face_links topology attribute and variable
             string_builder.clear();
@@ -169,11 +190,11 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
             define_topological_attribute("face_face_connectivity", string_builder.str());
             define_topological_variable("face_face_connectivity",
                                         "face_links",
-                                        netCDF::NcType::nc_INT,
+                                        index_type,
                                         {UGridFileDimensions::face, UGridFileDimensions::max_face_node},
                                         {{"long_name", "Neighboring face of mesh face (counterclockwise)"}}, true, true);
         }
-        if (mesh2d.edge_faces != nullptr)
+        if (mesh2d.edge_faces != nullptr || mesh2d.edge_faces_long != nullptr)
         {
             // Define edge_face topology attribute variable and variable
             string_builder.clear();
@@ -181,13 +202,11 @@ void Mesh2D::define(ugridapi::Mesh2D const& mesh2d)
             define_topological_attribute("edge_face_connectivity", string_builder.str());
             define_topological_variable("edge_face_connectivity",
                                         "edge_faces",
-                                        netCDF::NcType::nc_INT,
+                                        index_type,
                                         {UGridFileDimensions::edge, UGridFileDimensions::Two},
                                         {{"long_name", "Neighboring face of mesh edge"}}, true, true);
         }
     }
-
-    m_nc_file->enddef();
 }
 
 void Mesh2D::put(ugridapi::Mesh2D const& mesh2d)
@@ -197,6 +216,10 @@ void Mesh2D::put(ugridapi::Mesh2D const& mesh2d)
         throw std::invalid_argument("Mesh2D::put invalid mesh name");
     }
 
+    auto const num_edges = get_mesh2d_count(mesh2d.num_edges, mesh2d.num_edges_long);
+    auto const num_faces = get_mesh2d_count(mesh2d.num_faces, mesh2d.num_faces_long);
+    auto const num_face_nodes_max = static_cast<size_t>(std::max(mesh2d.num_face_nodes_max, 0));
+
     // Nodes
     if (auto const it = m_topology_attribute_variables.find("node_coordinates"); mesh2d.node_x != nullptr && it != m_topology_attribute_variables.end())
     {
@@ -212,13 +235,13 @@ void Mesh2D::put(ugridapi::Mesh2D const& mesh2d)
     }
 
     // Edges
-    if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); mesh2d.edge_nodes != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); (mesh2d.edge_nodes != nullptr || mesh2d.edge_nodes_long != nullptr) && it != m_topology_attribute_variables.end())
     {
-        it->second.at(0).putVar(mesh2d.edge_nodes);
+        put_connectivity(it->second.at(0), mesh2d.start_index, num_edges * 2, mesh2d.edge_nodes, mesh2d.edge_nodes_long);
     }
-    if (auto const it = m_topology_attribute_variables.find("edge_face_connectivity"); mesh2d.edge_faces != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("edge_face_connectivity"); (mesh2d.edge_faces != nullptr || mesh2d.edge_faces_long != nullptr) && it != m_topology_attribute_variables.end())
     {
-        it->second.at(0).putVar(mesh2d.edge_faces);
+        put_connectivity(it->second.at(0), mesh2d.start_index, num_edges * 2, mesh2d.edge_faces, mesh2d.edge_faces_long);
     }
     if (auto const it = m_topology_attribute_variables.find("edge_coordinates"); mesh2d.edge_x != nullptr && it != m_topology_attribute_variables.end())
     {
@@ -230,17 +253,17 @@ void Mesh2D::put(ugridapi::Mesh2D const& mesh2d)
     }
 
     // Faces
-    if (auto const it = m_topology_attribute_variables.find("face_node_connectivity"); mesh2d.face_nodes != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("face_node_connectivity"); (mesh2d.face_nodes != nullptr || mesh2d.face_nodes_long != nullptr) && it != m_topology_attribute_variables.end())
     {
-        it->second.at(0).putVar(mesh2d.face_nodes);
+        put_connectivity(it->second.at(0), mesh2d.start_index, num_faces * num_face_nodes_max, mesh2d.face_nodes, mesh2d.face_nodes_long);
     }
-    if (auto const it = m_topology_attribute_variables.find("face_edge_connectivity"); mesh2d.face_edges != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("face_edge_connectivity"); (mesh2d.face_edges != nullptr || mesh2d.face_edges_long != nullptr) && it != m_topology_attribute_variables.end())
     {
-        it->second.at(0).putVar(mesh2d.face_edges);
+        put_connectivity(it->second.at(0), mesh2d.start_index, num_faces * num_face_nodes_max, mesh2d.face_edges, mesh2d.face_edges_long);
     }
-    if (auto const it = m_topology_attribute_variables.find("face_face_connectivity"); mesh2d.face_faces != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("face_face_connectivity"); (mesh2d.face_faces != nullptr || mesh2d.face_faces_long != nullptr) && it != m_topology_attribute_variables.end())
     {
-        it->second.at(0).putVar(mesh2d.face_faces);
+        put_connectivity(it->second.at(0), mesh2d.start_index, num_faces * num_face_nodes_max, mesh2d.face_faces, mesh2d.face_faces_long);
     }
     if (auto const it = m_topology_attribute_variables.find("face_coordinates"); mesh2d.face_x != nullptr && it != m_topology_attribute_variables.end())
     {
@@ -268,15 +291,23 @@ void Mesh2D::inquire(ugridapi::Mesh2D& mesh2d) const
 {
     if (m_dimensions.find(UGridFileDimensions::node) != m_dimensions.end())
     {
-        mesh2d.num_nodes = static_cast<int>(m_dimensions.at(UGridFileDimensions::node).getSize());
+        mesh2d.num_nodes_long = static_cast<int64_t>(m_dimensions.at(UGridFileDimensions::node).getSize());
+        mesh2d.num_nodes = narrow_count(m_dimensions.at(UGridFileDimensions::node).getSize());
     }
     if (m_dimensions.find(UGridFileDimensions::edge) != m_dimensions.end())
     {
-        mesh2d.num_edges = static_cast<int>(m_dimensions.at(UGridFileDimensions::edge).getSize());
+        mesh2d.num_edges_long = static_cast<int64_t>(m_dimensions.at(UGridFileDimensions::edge).getSize());
+        mesh2d.num_edges = narrow_count(m_dimensions.at(UGridFileDimensions::edge).getSize());
+    }
+    else if (m_derived_connectivity.has_value())
+    {
+        mesh2d.num_edges_long = static_cast<int64_t>(m_derived_connectivity->edge_nodes.size() / 2);
+        mesh2d.num_edges = narrow_count(m_derived_connectivity->edge_nodes.size() / 2);
     }
     if (m_dimensions.find(UGridFileDimensions::face) != m_dimensions.end())
     {
-        mesh2d.num_faces = static_cast<int>(m_dimensions.at(UGridFileDimensions::face).getSize());
+        mesh2d.num_faces_long = static_cast<int64_t>(m_dimensions.at(UGridFileDimensions::face).getSize());
+        mesh2d.num_faces = narrow_count(m_dimensions.at(UGridFileDimensions::face).getSize());
     }
     if (m_dimensions.find(UGridFileDimensions::max_face_node) != m_dimensions.end())
     {
@@ -288,6 +319,10 @@ void Mesh2D::get(ugridapi::Mesh2D& mesh2d) const
 {
     string_to_char_array(m_entity_name, name_long_length, mesh2d.name);
 
+    auto const num_edges = get_mesh2d_count(mesh2d.num_edges, mesh2d.num_edges_long);
+    auto const num_faces = get_mesh2d_count(mesh2d.num_faces, mesh2d.num_faces_long);
+    auto const num_face_nodes_max = static_cast<size_t>(std::max(mesh2d.num_face_nodes_max, 0));
+
     // Nodes
     if (auto const it = m_topology_attribute_variables.find("node_coordinates"); mesh2d.node_x != nullptr && it != m_topology_attribute_variables.end())
     {
@@ -305,15 +340,21 @@ void Mesh2D::get(ugridapi::Mesh2D& mesh2d) const
     }
 
     // Edges
-    if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); mesh2d.edge_nodes != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); (mesh2d.edge_nodes != nullptr || mesh2d.edge_nodes_long != nullptr) && it != m_topology_attribute_variables.end())
     {
-        const auto var = it->second.at(0);
-        var.getVar(mesh2d.edge_nodes);
-        apply_start_index_offset(var, mesh2d.start_index, mesh2d.num_edges * 2, mesh2d.edge_nodes);
+        get_connectivity(it->second.at(0), mesh2d.start_index, num_edges * 2, mesh2d.edge_nodes, mesh2d.edge_nodes_long);
     }
-    if (auto const it = m_topology_attribute_variables.find("edge_face_connectivity"); mesh2d.edge_faces != nullptr && it != m_topology_attribute_variables.end())
+    else if ((mesh2d.edge_nodes != nullptr || mesh2d.edge_nodes_long != nullptr) && m_derived_connectivity.has_value())
     {
-        it->second.at(0).getVar(mesh2d.edge_faces);
+        get_derived_connectivity(m_derived_connectivity->edge_nodes, mesh2d.start_index, mesh2d.edge_nodes, mesh2d.edge_nodes_long);
+    }
+    if (auto const it = m_topology_attribute_variables.find("edge_face_connectivity"); (mesh2d.edge_faces != nullptr || mesh2d.edge_faces_long != nullptr) && it != m_topology_attribute_variables.end())
+    {
+        get_connectivity(it->second.at(0), mesh2d.start_index, num_edges * 2, mesh2d.edge_faces, mesh2d.edge_faces_long);
+    }
+    else if ((mesh2d.edge_faces != nullptr || mesh2d.edge_faces_long != nullptr) && m_derived_connectivity.has_value())
+    {
+        get_derived_connectivity(m_derived_connectivity->edge_faces, mesh2d.start_index, mesh2d.edge_faces, mesh2d.edge_faces_long);
     }
     if (auto const it = m_topology_attribute_variables.find("edge_coordinates"); mesh2d.edge_x != nullptr && it != m_topology_attribute_variables.end())
     {
@@ -325,23 +366,25 @@ void Mesh2D::get(ugridapi::Mesh2D& mesh2d) const
     }
 
     // Faces
-    if (auto const it = m_topology_attribute_variables.find("face_node_connectivity"); mesh2d.face_nodes != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("face_node_connectivity"); (mesh2d.face_nodes != nullptr || mesh2d.face_nodes_long != nullptr) && it != m_topology_attribute_variables.end())
+    {
+        get_connectivity(it->second.at(0), mesh2d.start_index, num_faces * num_face_nodes_max, mesh2d.face_nodes, mesh2d.face_nodes_long);
+    }
+    if (auto const it = m_topology_attribute_variables.find("face_edge_connectivity"); (mesh2d.face_edges != nullptr || mesh2d.face_edges_long != nullptr) && it != m_topology_attribute_variables.end())
+    {
+        get_connectivity(it->second.at(0), mesh2d.start_index, num_faces * num_face_nodes_max, mesh2d.face_edges, mesh2d.face_edges_long);
+    }
+    else if ((mesh2d.face_edges != nullptr || mesh2d.face_edges_long != nullptr) && m_derived_connectivity.has_value())
     {
-        const auto var = it->second.at(0);
-        var.getVar(mesh2d.face_nodes);
-        apply_start_index_offset(var, mesh2d.start_index, mesh2d.num_faces * mesh2d.num_face_nodes_max, mesh2d.face_nodes);
+        get_derived_connectivity(m_derived_connectivity->face_edges, mesh2d.start_index, mesh2d.face_edges, mesh2d.face_edges_long);
     }
-    if (auto const it = m_topology_attribute_variables.find("face_edge_connectivity"); mesh2d.face_edges != nullptr && it != m_topology_attribute_variables.end())
+    if (auto const it = m_topology_attribute_variables.find("face_face_connectivity"); (mesh2d.face_faces != nullptr || mesh2d.face_faces_long != nullptr) && it != m_topology_attribute_variables.end())
     {
-        const auto var = it->second.at(0);
-        var.getVar(mesh2d.face_edges);
-        apply_start_index_offset(var, mesh2d.start_index, mesh2d.num_faces * mesh2d.num_face_nodes_max, mesh2d.face_edges);
+        get_connectivity(it->second.at(0), mesh2d.start_index, num_faces * num_face_nodes_max, mesh2d.face_faces, mesh2d.face_faces_long);
     }
-    if (auto const it = m_topology_attribute_variables.find("face_face_connectivity"); mesh2d.face_faces != nullptr && it != m_topology_attribute_variables.end())
+    else if ((mesh2d.face_faces != nullptr || mesh2d.face_faces_long != nullptr) && m_derived_connectivity.has_value())
     {
-        const auto var = it->second.at(0);
-        var.getVar(mesh2d.face_faces);
-        apply_start_index_offset(var, mesh2d.start_index, mesh2d.num_faces * mesh2d.num_face_nodes_max, mesh2d.face_faces);
+        get_derived_connectivity(m_derived_connectivity->face_faces, mesh2d.start_index, mesh2d.face_faces, mesh2d.face_faces_long);
     }
     if (auto const it = m_topology_attribute_variables.find("face_coordinates"); mesh2d.face_x != nullptr && it != m_topology_attribute_variables.end())
     {
@@ -364,3 +407,228 @@ void Mesh2D::get(ugridapi::Mesh2D& mesh2d) const
         // to complete
     }
 }
+
+void Mesh2D::get_mapped(MappedFile& mapped_file, ugridapi::Mesh2D& mesh2d) const
+{
+    if (mesh2d.name != nullptr)
+    {
+        string_to_char_array(m_entity_name, name_long_length, mesh2d.name);
+    }
+
+    auto const get_coordinates = [this, &mapped_file](std::string const& attribute_name, size_t index) -> double*
+    {
+        auto const it = m_topology_attribute_variables.find(attribute_name);
+        if (it == m_topology_attribute_variables.end() || it->second.size() <= index)
+        {
+            return nullptr;
+        }
+        return mapped_file.get_doubles(it->second[index].getName());
+    };
+    auto const get_related = [this, &mapped_file](std::string const& name) -> double*
+    {
+        auto const it = m_related_variables.find(name);
+        return it == m_related_variables.end() ? nullptr : mapped_file.get_doubles(it->second.getName());
+    };
+    auto const get_connectivity = [this, &mapped_file, start_index = mesh2d.start_index](std::string const& attribute_name, int*& values, int64_t*& values_long)
+    {
+        values = nullptr;
+        values_long = nullptr;
+        auto const it = m_topology_attribute_variables.find(attribute_name);
+        if (it == m_topology_attribute_variables.end() || it->second.empty())
+        {
+            return;
+        }
+        auto const& variable = it->second.front();
+        auto const name = variable.getName();
+        int fill_value = 0;
+        auto const offset = get_index_offset(variable, start_index, fill_value);
+        if (mapped_file.get_variable(name).type == NC_INT64)
+        {
+            values_long = mapped_file.get_indices_long(name, offset, int64_t{fill_value});
+            return;
+        }
+        values = mapped_file.get_indices(name, offset, fill_value);
+    };
+
+    // Nodes
+    mesh2d.node_x = get_coordinates("node_coordinates", 0);
+    mesh2d.node_y = get_coordinates("node_coordinates", 1);
+    mesh2d.node_z = get_related("node_z");
+
+    // Edges
+    get_connectivity("edge_node_connectivity", mesh2d.edge_nodes, mesh2d.edge_nodes_long);
+    get_connectivity("edge_face_connectivity", mesh2d.edge_faces, mesh2d.edge_faces_long);
+    mesh2d.edge_x = get_coordinates("edge_coordinates", 0);
+    mesh2d.edge_y = get_coordinates("edge_coordinates", 1);
+
+    // Faces
+    get_connectivity("face_node_connectivity", mesh2d.face_nodes, mesh2d.face_nodes_long);
+    get_connectivity("face_edge_connectivity", mesh2d.face_edges, mesh2d.face_edges_long);
+    get_connectivity("face_face_connectivity", mesh2d.face_faces, mesh2d.face_faces_long);
+    mesh2d.face_x = get_coordinates("face_coordinates", 0);
+    mesh2d.face_y = get_coordinates("face_coordinates", 1);
+    mesh2d.face_x_bnd = get_related("face_x_bnd");
+    mesh2d.face_y_bnd = get_related("face_y_bnd");
+}
+
+netCDF::NcVar const& Mesh2D::get_face_connectivity_variable(std::string const& attribute_name) const
+{
+    auto const it = m_topology_attribute_variables.find(attribute_name);
+    if (it == m_topology_attribute_variables.end() || it->second.empty())
+    {
+        throw std::invalid_argument("Mesh2D: The mesh " + m_entity_name + " has no " + attribute_name + ".");
+    }
+    return it->second.front();
+}
+
+void Mesh2D::get_face_offsets(int* face_offsets) const
+{
+    auto const& variable = get_face_connectivity_variable("face_node_connectivity");
+    auto const num_faces = get_dimension(UGridFileDimensions::face).getSize();
+    auto const num_face_nodes_max = get_dimension(UGridFileDimensions::max_face_node).getSize();
+
+    int fill_value = 0;
+    get_index_offset(variable, 0, fill_value);
+
+    std::vector<int> block(std::min(faces_per_block, num_faces) * num_face_nodes_max);
+    face_offsets[0] = 0;
+    for (size_t first_face = 0; first_face < num_faces; first_face += faces_per_block)
+    {
+        auto const block_faces = std::min(faces_per_block, num_faces - first_face);
+        variable.getVar({first_face, 0}, {block_faces, num_face_nodes_max}, block.data());
+
+        for (size_t f = 0; f < block_faces; ++f)
+        {
+            auto const* const row = &block[f * num_face_nodes_max];
+            auto const num_nodes = std::count_if(row, row + num_face_nodes_max, [fill_value](int node)
+                                                 { return node != fill_value; });
+            auto const face_offset = static_cast<size_t>(face_offsets[first_face + f]) + static_cast<size_t>(num_nodes);
+            if (face_offset > static_cast<size_t>(std::numeric_limits<int>::max()))
+            {
+                throw std::overflow_error("Mesh2D::get_face_offsets: The number of face nodes exceeds the range of the offsets.");
+            }
+            face_offsets[first_face + f + 1] = static_cast<int>(face_offset);
+        }
+    }
+}
+
+void Mesh2D::get_ragged_face_connectivity(std::string const& attribute_name, int start_index, int const* face_offsets, int* indices) const
+{
+    auto const& variable = get_face_connectivity_variable(attribute_name);
+    auto const num_faces = get_dimension(UGridFileDimensions::face).getSize();
+    auto const num_face_nodes_max = get_dimension(UGridFileDimensions::max_face_node).getSize();
+
+    int fill_value = 0;
+    auto const offset = get_index_offset(variable, start_index, fill_value);
+
+    std::vector<int> block(std::min(faces_per_block, num_faces) * num_face_nodes_max);
+    for (size_t first_face = 0; first_face < num_faces; first_face += faces_per_block)
+    {
+        auto const block_faces = std::min(faces_per_block, num_faces - first_face);
+        variable.getVar({first_face, 0}, {block_faces, num_face_nodes_max}, block.data());
+
+        // Compact the rows, then convert the whole block at once
+        auto* const block_indices = indices + face_offsets[first_face];
+        for (size_t f = 0; f < block_faces; ++f)
+        {
+            auto const row_start = static_cast<size_t>(face_offsets[first_face + f]);
+            auto const row_size = static_cast<size_t>(face_offsets[first_face + f + 1]) - row_start;
+            if (row_size > num_face_nodes_max)
+            {
+                throw std::invalid_argument("Mesh2D::get_ragged_face_connectivity: A face has more entries than the maximum number of face nodes.");
+            }
+            std::copy_n(&block[f * num_face_nodes_max], row_size, indices + row_start);
+        }
+        auto const block_size = static_cast<size_t>(face_offsets[first_face + block_faces] - face_offsets[first_face]);
+        add_index_offset(offset, fill_value, block_size, block_indices);
+    }
+}
+
+void Mesh2D::put_ragged_face_connectivity(std::string const& attribute_name, int start_index, int const* face_offsets, int const* indices) const
+{
+    auto const& variable = get_face_connectivity_variable(attribute_name);
+    auto const num_faces = get_dimension(UGridFileDimensions::face).getSize();
+    auto const num_face_nodes_max = get_dimension(UGridFileDimensions::max_face_node).getSize();
+
+    int fill_value = 0;
+    auto const offset = get_index_offset(variable, start_index, fill_value);
+
+    std::vector<int> block(std::min(faces_per_block, num_faces) * num_face_nodes_max);
+    for (size_t first_face = 0; first_face < num_faces; first_face += faces_per_block)
+    {
+        auto const block_faces = std::min(faces_per_block, num_faces - first_face);
+
+        std::fill(block.begin(), block.end(), fill_value);
+        for (size_t f = 0; f < block_faces; ++f)
+        {
+            auto const row_start = face_offsets[first_face + f];
+            auto const row_end = face_offsets[first_face + f + 1];
+            if (row_end < row_start || static_cast<size_t>(row_end - row_start) > num_face_nodes_max)
+            {
+                throw std::invalid_argument("Mesh2D::put_ragged_face_connectivity: Invalid offsets for face " + std::to_string(first_face + f) + ".");
+            }
+            std::copy(indices + row_start, indices + row_end, &block[f * num_face_nodes_max]);
+        }
+
+        // Convert to the start index of the file, the padding is left untouched
+        auto const block_size = block_faces * num_face_nodes_max;
+        add_index_offset(-offset, fill_value, block_size, block.data());
+        variable.putVar({first_face, 0}, {block_faces, num_face_nodes_max}, block.data());
+    }
+}
+
+void Mesh2D::get_connectivity(netCDF::NcVar const& var, int start_index, size_t size, int* values, int64_t* values_long) const
+{
+    if (values_long != nullptr)
+    {
+        get_indices(var, start_index, size, values_long);
+        return;
+    }
+    get_indices(var, start_index, size, values);
+}
+
+void Mesh2D::put_connectivity(netCDF::NcVar const& var, int start_index, size_t size, int const* values, int64_t const* values_long) const
+{
+    if (values_long != nullptr)
+    {
+        put_indices(var, start_index, size, values_long);
+        return;
+    }
+    put_indices(var, start_index, size, values);
+}
+
+void Mesh2D::get_derived_connectivity(std::vector<int> const& derived, int start_index, int* values, int64_t* values_long) const
+{
+    auto const fill_value = m_derived_connectivity->fill_value;
+    if (values_long != nullptr)
+    {
+        std::copy(derived.begin(), derived.end(), values_long);
+        add_index_offset(int64_t{start_index}, int64_t{fill_value}, derived.size(), values_long);
+        return;
+    }
+    std::copy(derived.begin(), derived.end(), values);
+    add_index_offset(start_index, fill_value, derived.size(), values);
+}
+
+void Mesh2D::derive_connectivity(size_t max_threads)
+{
+    auto const& variable = get_face_connectivity_variable("face_node_connectivity");
+    auto const num_faces = get_dimension(UGridFileDimensions::face).getSize();
+    auto const num_face_nodes_max = get_dimension(UGridFileDimensions::max_face_node).getSize();
+
+    std::vector<int> face_nodes(num_faces * num_face_nodes_max);
+    get_indices(variable, 0, face_nodes.size(), face_nodes.data());
+    int fill_value = 0;
+    get_index_offset(variable, 0, fill_value);
+
+    auto derived_connectivity = ugrid::derive_connectivity(face_nodes.data(), num_faces, num_face_nodes_max, fill_value, max_threads);
+
+    // Keep the numbering of the edges stored in the file
+    if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); it != m_topology_attribute_variables.end())
+    {
+        std::vector<int> edge_nodes(get_dimension(UGridFileDimensions::edge).getSize() * 2);
+        get_indices(it->second.at(0), 0, edge_nodes.size(), edge_nodes.data());
+        renumber_edges(derived_connectivity, edge_nodes);
+    }
+    m_derived_connectivity = std::move(derived_connectivity);
+}
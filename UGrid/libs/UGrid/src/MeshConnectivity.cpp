@@ -0,0 +1,319 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <UGrid/MeshConnectivity.hpp>
+#include <UGrid/Parallel.hpp>
+
+/// @brief A half edge of a face, keyed by its unordered node pair
+struct HalfEdge
+{
+    uint64_t key;    ///< The smallest node in the high and the largest node in the low 32 bits
+    size_t position; ///< The position of the first node of the half edge in the face nodes
+
+    bool operator<(HalfEdge const& other) const
+    {
+        return key != other.key ? key < other.key : position < other.position;
+    }
+};
+
+/// @brief The key of the padding entries of the face nodes, sorted after all half edges
+static constexpr uint64_t padding_key = std::numeric_limits<uint64_t>::max();
+
+/// @brief Gets the key of an edge, its smallest node in the high and its largest node in the low 32 bits
+/// @param first The first node
+/// @param second The second node
+/// @return The key
+static uint64_t get_edge_key(int first, int second)
+{
+    return (static_cast<uint64_t>(std::min(first, second)) << 32) | static_cast<uint64_t>(std::max(first, second));
+}
+
+/// @brief Gets the position of the face node following a face node, wrapping around after the last valid node of the face
+/// @param face_nodes The face nodes
+/// @param num_face_nodes_max The maximum number of nodes per face
+/// @param fill_value The fill value of the face nodes
+/// @param position The position of the face node
+/// @return The position of the next face node
+static size_t get_next_node_position(int const* face_nodes, size_t num_face_nodes_max, int fill_value, size_t position)
+{
+    auto const row_start = position - position % num_face_nodes_max;
+    auto const next = position + 1;
+    if (next == row_start + num_face_nodes_max || face_nodes[next] == fill_value)
+    {
+        return row_start;
+    }
+    return next;
+}
+
+ugrid::DerivedConnectivity ugrid::derive_connectivity(int const* face_nodes,
+                                                      size_t num_faces,
+                                                      size_t num_face_nodes_max,
+                                                      int fill_value,
+                                                      size_t max_threads)
+{
+    DerivedConnectivity result;
+    result.fill_value = fill_value;
+    if (num_faces == 0 || num_face_nodes_max == 0)
+    {
+        return result;
+    }
+    if (num_faces > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::overflow_error("derive_connectivity: The number of faces exceeds the int range.");
+    }
+
+    // Work is split in one contiguous chunk per thread
+    auto const size = num_faces * num_face_nodes_max;
+    auto const num_chunks = get_num_threads(num_faces, max_threads);
+
+    // Collect the half edges
+    std::vector<HalfEdge> half_edges(size);
+    parallel_for_chunks(size, num_chunks, max_threads, [&](size_t, size_t begin, size_t end)
+                        {
+                            for (auto position = begin; position < end; ++position)
+                            {
+                                auto const first = face_nodes[position];
+                                if (first == fill_value)
+                                {
+                                    half_edges[position] = {padding_key, position};
+                                    continue;
+                                }
+                                auto const second = face_nodes[get_next_node_position(face_nodes, num_face_nodes_max, fill_value, position)];
+                                if (first < 0 || second < 0)
+                                {
+                                    throw std::invalid_argument("derive_connectivity: Invalid node index in face " + std::to_string(position / num_face_nodes_max) + ".");
+                                }
+                                half_edges[position] = {get_edge_key(first, second), position};
+                            }
+                        });
+
+    parallel_sort(half_edges, max_threads);
+
+    // Drop the padding, sorted at the end
+    auto const padding = std::lower_bound(half_edges.begin(), half_edges.end(), HalfEdge{padding_key, 0});
+    half_edges.erase(padding, half_edges.end());
+    auto const num_half_edges = half_edges.size();
+    auto const is_first_of_edge = [&half_edges](size_t i)
+    {
+        return i == 0 || half_edges[i].key != half_edges[i - 1].key;
+    };
+
+    // Number the edges: count the edges starting in each chunk, the prefix sum gives the first edge of each chunk
+    std::vector<size_t> chunk_edges(num_chunks + 1, 0);
+    parallel_for_chunks(num_half_edges, num_chunks, max_threads, [&](size_t chunk, size_t begin, size_t end)
+                        {
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                chunk_edges[chunk + 1] += is_first_of_edge(i) ? 1 : 0;
+                            }
+                        });
+    std::partial_sum(chunk_edges.begin(), chunk_edges.end(), chunk_edges.begin());
+    auto const num_edges = chunk_edges.back();
+    if (num_edges > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::overflow_error("derive_connectivity: The number of edges exceeds the int range.");
+    }
+
+    result.edge_nodes.resize(2 * num_edges);
+    result.edge_faces.assign(2 * num_edges, fill_value);
+    result.face_edges.assign(size, fill_value);
+    result.face_faces.assign(size, fill_value);
+
+    // Each half edge only writes its own face entries, and the entries of its edge if it is the first of the edge
+    parallel_for_chunks(num_half_edges, num_chunks, max_threads, [&](size_t chunk, size_t begin, size_t end)
+                        {
+                            auto edge_count = chunk_edges[chunk];
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                auto const& half_edge = half_edges[i];
+                                auto const face = static_cast<int>(half_edge.position / num_face_nodes_max);
+                                if (is_first_of_edge(i))
+                                {
+                                    ++edge_count;
+                                }
+                                auto const edge = edge_count - 1;
+                                result.face_edges[half_edge.position] = static_cast<int>(edge);
+
+                                if (!is_first_of_edge(i))
+                                {
+                                    if (i >= 2 && half_edges[i - 2].key == half_edge.key)
+                                    {
+                                        throw std::invalid_argument("derive_connectivity: An edge of face " + std::to_string(face) + " is shared by more than two faces.");
+                                    }
+                                    result.face_faces[half_edge.position] = static_cast<int>(half_edges[i - 1].position / num_face_nodes_max);
+                                    continue;
+                                }
+
+                                result.edge_nodes[2 * edge] = face_nodes[half_edge.position];
+                                result.edge_nodes[2 * edge + 1] = face_nodes[get_next_node_position(face_nodes, num_face_nodes_max, fill_value, half_edge.position)];
+                                result.edge_faces[2 * edge] = face;
+                                if (i + 1 < num_half_edges && half_edges[i + 1].key == half_edge.key)
+                                {
+                                    auto const neighbour = static_cast<int>(half_edges[i + 1].position / num_face_nodes_max);
+                                    result.edge_faces[2 * edge + 1] = neighbour;
+                                    result.face_faces[half_edge.position] = neighbour;
+                                }
+                            }
+                        });
+
+    return result;
+}
+
+void ugrid::renumber_edges(DerivedConnectivity& connectivity, std::vector<int> const& edge_nodes)
+{
+    auto const num_edges = connectivity.edge_nodes.size() / 2;
+    if (edge_nodes.size() != 2 * num_edges)
+    {
+        throw std::invalid_argument("renumber_edges: The number of edges differs from the number of derived edges.");
+    }
+
+    // The derived edges are sorted by key, so sorting the given edges by key pairs them up
+    std::vector<std::pair<uint64_t, int>> keys(num_edges);
+    for (size_t e = 0; e < num_edges; ++e)
+    {
+        keys[e] = {get_edge_key(edge_nodes[2 * e], edge_nodes[2 * e + 1]), static_cast<int>(e)};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<int> edge_faces(connectivity.edge_faces.size());
+    for (size_t e = 0; e < num_edges; ++e)
+    {
+        if (keys[e].first != get_edge_key(connectivity.edge_nodes[2 * e], connectivity.edge_nodes[2 * e + 1]))
+        {
+            throw std::invalid_argument("renumber_edges: The edges differ from the derived edges.");
+        }
+        auto const edge = static_cast<size_t>(keys[e].second);
+        edge_faces[2 * edge] = connectivity.edge_faces[2 * e];
+        edge_faces[2 * edge + 1] = connectivity.edge_faces[2 * e + 1];
+    }
+
+    for (auto& face_edge : connectivity.face_edges)
+    {
+        if (face_edge != connectivity.fill_value)
+        {
+            face_edge = keys[static_cast<size_t>(face_edge)].second;
+        }
+    }
+    connectivity.edge_faces = std::move(edge_faces);
+    connectivity.edge_nodes = edge_nodes;
+}
+
+void ugrid::build_inverse_connectivity(int const* connectivity,
+                                       size_t num_entities,
+                                       size_t entries_per_entity,
+                                       size_t num_targets,
+                                       int start_index,
+                                       int fill_value,
+                                       size_t max_threads,
+                                       int* offsets,
+                                       int* indices)
+{
+    if (num_entities > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::overflow_error("build_inverse_connectivity: The number of entities exceeds the int range.");
+    }
+
+    // Each chunk keeps a count per target. The number of chunks is capped so these counts take no more memory than the
+    // connectivity itself, otherwise many threads and targets (e.g. 64 threads and 10^8 nodes) would need gigabytes
+    auto const num_entries = num_entities * entries_per_entity;
+    auto const max_chunks = std::max<size_t>(1, num_entries / std::max<size_t>(1, num_targets));
+    auto const num_chunks = std::min(get_num_threads(num_entities, max_threads), max_chunks);
+    auto const get_target = [&](size_t position)
+    {
+        auto const target = static_cast<long long>(connectivity[position]) - start_index;
+        if (target < 0 || static_cast<size_t>(target) >= num_targets)
+        {
+            throw std::invalid_argument("build_inverse_connectivity: Invalid index in entity " + std::to_string(position / entries_per_entity) + ".");
+        }
+        return static_cast<size_t>(target);
+    };
+
+    // Count the entries of each target per chunk of entities
+    std::vector<int> chunk_counts(num_chunks * num_targets, 0);
+    parallel_for_chunks(num_entities, num_chunks, max_threads, [&](size_t chunk, size_t begin, size_t end)
+                        {
+                            auto* const counts = chunk_counts.data() + chunk * num_targets;
+                            for (auto position = begin * entries_per_entity; position < end * entries_per_entity; ++position)
+                            {
+                                if (connectivity[position] != fill_value)
+                                {
+                                    ++counts[get_target(position)];
+                                }
+                            }
+                        });
+
+    // Turn the counts into the first write position of each chunk within each target, and the number of entries per target
+    std::vector<size_t> totals(num_targets + 1, 0);
+    parallel_for_each_index(num_targets, max_threads, [&](size_t target)
+                            {
+                                int running = 0;
+                                for (size_t chunk = 0; chunk < num_chunks; ++chunk)
+                                {
+                                    auto& count = chunk_counts[chunk * num_targets + target];
+                                    auto const chunk_count = count;
+                                    count = running;
+                                    running += chunk_count;
+                                }
+                                totals[target + 1] = static_cast<size_t>(running);
+                            });
+
+    std::partial_sum(totals.begin(), totals.end(), totals.begin());
+    if (totals.back() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::overflow_error("build_inverse_connectivity: The number of entries exceeds the int range.");
+    }
+    for (size_t target = 0; target <= num_targets; ++target)
+    {
+        offsets[target] = static_cast<int>(totals[target]);
+    }
+
+    // Scatter the entities, in entity order within each chunk
+    parallel_for_chunks(num_entities, num_chunks, max_threads, [&](size_t chunk, size_t begin, size_t end)
+                        {
+                            auto* const positions = chunk_counts.data() + chunk * num_targets;
+                            for (auto entity = begin; entity < end; ++entity)
+                            {
+                                for (size_t entry = 0; entry < entries_per_entity; ++entry)
+                                {
+                                    auto const position = entity * entries_per_entity + entry;
+                                    if (connectivity[position] == fill_value)
+                                    {
+                                        continue;
+                                    }
+                                    auto const target = get_target(position);
+                                    indices[totals[target] + static_cast<size_t>(positions[target]++)] = static_cast<int>(entity) + start_index;
+                                }
+                            }
+                        });
+}
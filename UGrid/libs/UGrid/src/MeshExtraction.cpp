@@ -0,0 +1,488 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include <UGrid/Constants.hpp>
+#include <UGrid/MeshExtraction.hpp>
+#include <UGrid/Operations.hpp>
+
+/// @brief The maximum number of consecutive entities read by one hyperslab when extracting a data variable
+static constexpr size_t max_entities_per_read = 65536;
+
+/// @brief The largest gap between selected entities read through when extracting a data variable.
+///        Reading a few unselected entities is cheaper than another netCDF call, which matters for meshes in arbitrary order
+static constexpr size_t max_entities_gap_per_read = 64;
+
+/// @brief Gets the key of an edge, its smallest node in the high and its largest node in the low 32 bits
+/// @param first The first node
+/// @param second The second node
+/// @return The key
+static uint64_t get_edge_key(int first, int second)
+{
+    return (static_cast<uint64_t>(std::min(first, second)) << 32) | static_cast<uint64_t>(std::max(first, second));
+}
+
+ugrid::Mesh2DArrays ugrid::read_mesh2d_arrays(Mesh2D const& mesh)
+{
+    ugridapi::Mesh2D mesh2d;
+    mesh.inquire(mesh2d);
+    Mesh2DArrays arrays;
+    std::vector<char> name(name_long_length);
+    arrays.node_x.resize(static_cast<size_t>(mesh2d.num_nodes));
+    arrays.node_y.resize(static_cast<size_t>(mesh2d.num_nodes));
+    arrays.edge_nodes.resize(2 * static_cast<size_t>(mesh2d.num_edges));
+    arrays.face_nodes.resize(static_cast<size_t>(mesh2d.num_faces) * static_cast<size_t>(mesh2d.num_face_nodes_max));
+    arrays.num_face_nodes_max = static_cast<size_t>(mesh2d.num_face_nodes_max);
+    mesh2d.name = name.data();
+    mesh2d.node_x = arrays.node_x.data();
+    mesh2d.node_y = arrays.node_y.data();
+    mesh2d.edge_nodes = arrays.edge_nodes.empty() ? nullptr : arrays.edge_nodes.data();
+    mesh2d.face_nodes = arrays.face_nodes.data();
+    mesh.get(mesh2d);
+
+    arrays.fill_value = int_missing_value;
+    if (auto const attributes = mesh.get_topology_attribute_variable("face_node_connectivity").at(0).getAtts(); attributes.contains("_FillValue"))
+    {
+        attributes.at("_FillValue").getValues(&arrays.fill_value);
+    }
+    return arrays;
+}
+
+ugrid::Mesh2DSubset ugrid::make_mesh2d_subset(Mesh2DArrays const& mesh, std::vector<size_t> faces, std::vector<size_t> edges)
+{
+    Mesh2DSubset subset;
+    subset.faces = std::move(faces);
+    subset.edges = std::move(edges);
+    subset.num_face_nodes_max = mesh.num_face_nodes_max;
+    subset.fill_value = mesh.fill_value;
+
+    // The selected nodes are the nodes of the selected faces, numbered in ascending order
+    auto const num_face_nodes_max = mesh.num_face_nodes_max;
+    for (auto const face : subset.faces)
+    {
+        for (size_t k = 0; k < num_face_nodes_max; ++k)
+        {
+            auto const node = mesh.face_nodes[face * num_face_nodes_max + k];
+            if (node == mesh.fill_value)
+            {
+                break;
+            }
+            if (node < 0 || static_cast<size_t>(node) >= mesh.node_x.size())
+            {
+                throw std::invalid_argument("make_mesh2d_subset: Invalid node index in face " + std::to_string(face) + ".");
+            }
+            subset.nodes.push_back(static_cast<size_t>(node));
+        }
+    }
+    std::sort(subset.nodes.begin(), subset.nodes.end());
+    subset.nodes.erase(std::unique(subset.nodes.begin(), subset.nodes.end()), subset.nodes.end());
+
+    subset.node_x.reserve(subset.nodes.size());
+    subset.node_y.reserve(subset.nodes.size());
+    for (auto const node : subset.nodes)
+    {
+        subset.node_x.push_back(mesh.node_x[node]);
+        subset.node_y.push_back(mesh.node_y[node]);
+    }
+
+    auto const get_subset_node = [&subset](int node)
+    {
+        auto const it = std::lower_bound(subset.nodes.begin(), subset.nodes.end(), static_cast<size_t>(node));
+        if (node < 0 || it == subset.nodes.end() || *it != static_cast<size_t>(node))
+        {
+            throw std::invalid_argument("make_mesh2d_subset: Edge node " + std::to_string(node) + " is not a node of the selected faces.");
+        }
+        return static_cast<int>(it - subset.nodes.begin());
+    };
+
+    subset.face_nodes.reserve(subset.faces.size() * num_face_nodes_max);
+    for (auto const face : subset.faces)
+    {
+        for (size_t k = 0; k < num_face_nodes_max; ++k)
+        {
+            auto const node = mesh.face_nodes[face * num_face_nodes_max + k];
+            subset.face_nodes.push_back(node == mesh.fill_value ? mesh.fill_value : get_subset_node(node));
+        }
+    }
+
+    subset.edge_nodes.reserve(2 * subset.edges.size());
+    for (auto const edge : subset.edges)
+    {
+        subset.edge_nodes.push_back(get_subset_node(mesh.edge_nodes[2 * edge]));
+        subset.edge_nodes.push_back(get_subset_node(mesh.edge_nodes[2 * edge + 1]));
+    }
+
+    return subset;
+}
+
+ugrid::Mesh2DSubset ugrid::select_mesh2d_faces(Mesh2DArrays const& mesh, std::function<bool(double, double)> const& is_inside)
+{
+    auto const num_nodes = mesh.node_x.size();
+    auto const num_face_nodes_max = mesh.num_face_nodes_max;
+
+    // Classify each node once
+    std::vector<bool> node_inside(num_nodes);
+    for (size_t node = 0; node < num_nodes; ++node)
+    {
+        node_inside[node] = is_inside(mesh.node_x[node], mesh.node_y[node]);
+    }
+
+    // Select the faces with all nodes inside, and collect their sides
+    std::vector<size_t> faces;
+    std::vector<uint64_t> side_keys;
+    for (size_t face = 0; face < mesh.get_num_faces(); ++face)
+    {
+        auto const* const nodes = &mesh.face_nodes[face * num_face_nodes_max];
+        auto const num_face_nodes = static_cast<size_t>(std::find(nodes, nodes + num_face_nodes_max, mesh.fill_value) - nodes);
+        bool const selected = num_face_nodes > 0 && std::all_of(nodes, nodes + num_face_nodes, [&](int node)
+                                                                { return node >= 0 && static_cast<size_t>(node) < num_nodes && node_inside[node]; });
+        if (!selected)
+        {
+            continue;
+        }
+
+        faces.push_back(face);
+        for (size_t k = 0; k < num_face_nodes; ++k)
+        {
+            side_keys.push_back(get_edge_key(nodes[k], nodes[(k + 1) % num_face_nodes]));
+        }
+    }
+    std::sort(side_keys.begin(), side_keys.end());
+
+    // The selected edges are the sides of the selected faces
+    std::vector<size_t> edges;
+    for (size_t edge = 0; edge < mesh.edge_nodes.size() / 2; ++edge)
+    {
+        auto const first = mesh.edge_nodes[2 * edge];
+        auto const second = mesh.edge_nodes[2 * edge + 1];
+        if (first >= 0 && second >= 0 && std::binary_search(side_keys.begin(), side_keys.end(), get_edge_key(first, second)))
+        {
+            edges.push_back(edge);
+        }
+    }
+
+    return make_mesh2d_subset(mesh, std::move(faces), std::move(edges));
+}
+
+bool ugrid::is_point_in_polygon(double x, double y, double const* polygon_x, double const* polygon_y, size_t num_polygon_nodes)
+{
+    bool inside = false;
+    for (size_t i = 0, j = num_polygon_nodes - 1; i < num_polygon_nodes; j = i++)
+    {
+        if ((polygon_y[i] > y) != (polygon_y[j] > y) &&
+            x < (polygon_x[j] - polygon_x[i]) * (y - polygon_y[i]) / (polygon_y[j] - polygon_y[i]) + polygon_x[i])
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+netCDF::NcVar ugrid::define_variable_on_location(netCDF::NcVar const& source_variable,
+                                                 netCDF::NcDim const& source_location_dimension,
+                                                 netCDF::NcDim const& target_location_dimension,
+                                                 netCDF::NcFile& target)
+{
+    auto const type_class = source_variable.getType().getTypeClass();
+    if (type_class == netCDF::NcType::nc_STRING || type_class == netCDF::NcType::nc_VLEN || type_class == netCDF::NcType::nc_OPAQUE ||
+        type_class == netCDF::NcType::nc_ENUM || type_class == netCDF::NcType::nc_COMPOUND)
+    {
+        throw std::invalid_argument("define_variable_on_location: The type of variable " + source_variable.getName() + " is not supported.");
+    }
+
+    // Other dimensions are carried over, with their size
+    std::vector<netCDF::NcDim> dimensions;
+    for (auto const& dimension : source_variable.getDims())
+    {
+        if (dimension == source_location_dimension)
+        {
+            dimensions.emplace_back(target_location_dimension);
+            continue;
+        }
+        auto target_dimension = target.getDim(dimension.getName());
+        if (target_dimension.isNull())
+        {
+            target_dimension = dimension.isUnlimited() ? target.addDim(dimension.getName()) : target.addDim(dimension.getName(), dimension.getSize());
+        }
+        dimensions.emplace_back(target_dimension);
+    }
+    auto const target_variable = target.addVar(source_variable.getName(), source_variable.getType(), dimensions);
+
+    for (auto const& [name, attribute] : source_variable.getAtts())
+    {
+        std::vector<unsigned char> values(attribute.getAttLength() * attribute.getType().getSize());
+        attribute.getValues(values.data());
+        target_variable.putAtt(name, attribute.getType(), attribute.getAttLength(), values.data());
+    }
+    return target_variable;
+}
+
+std::vector<std::pair<netCDF::NcVar, netCDF::NcVar>> ugrid::define_coordinate_variables(netCDF::NcVar const& source_variable,
+                                                                                        size_t location_dimension,
+                                                                                        netCDF::NcFile const& source,
+                                                                                        netCDF::NcFile& target)
+{
+    std::vector<std::pair<netCDF::NcVar, netCDF::NcVar>> coordinate_variables;
+    auto const dimensions = source_variable.getDims();
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+        if (i == location_dimension)
+        {
+            continue;
+        }
+        auto const name = dimensions[i].getName();
+        auto const source_coordinate_variable = source.getVar(name);
+        if (source_coordinate_variable.isNull() ||
+            source_coordinate_variable.getDimCount() != 1 ||
+            !(source_coordinate_variable.getDim(0) == dimensions[i]) ||
+            !target.getVar(name).isNull())
+        {
+            continue;
+        }
+        auto const target_coordinate_variable = define_variable_on_location(source_coordinate_variable, dimensions[i], target.getDim(name), target);
+        coordinate_variables.emplace_back(source_coordinate_variable, target_coordinate_variable);
+    }
+    return coordinate_variables;
+}
+
+void ugrid::copy_coordinate_variable(netCDF::NcVar const& source_variable, netCDF::NcVar const& target_variable)
+{
+    std::vector<size_t> const start{0};
+    std::vector<size_t> const count{source_variable.getDim(0).getSize()};
+    if (count[0] == 0)
+    {
+        return;
+    }
+    std::vector<unsigned char> values(count[0] * source_variable.getType().getSize());
+    source_variable.getVar(start, count, values.data());
+    target_variable.putVar(start, count, values.data());
+}
+
+/// @brief Copies the selected entities of a data variable, per index of the dimensions preceding the location dimension.
+///        Selected entities separated by small gaps are read as one window, up to max_entities_per_read entities, and gathered in memory
+/// @param source_variable The source data variable
+/// @param target_variable The target data variable
+/// @param location_dimension The position of the location dimension in the variable dimensions
+/// @param selection The selected entities, ascending
+static void copy_extracted_variable(netCDF::NcVar const& source_variable,
+                                    netCDF::NcVar const& target_variable,
+                                    size_t location_dimension,
+                                    std::vector<size_t> const& selection)
+{
+    auto const dimensions = source_variable.getDims();
+    std::vector<size_t> start(dimensions.size(), 0);
+    std::vector<size_t> count(dimensions.size(), 1);
+    size_t num_leading = 1;
+    for (size_t i = 0; i < location_dimension; ++i)
+    {
+        num_leading *= dimensions[i].getSize();
+    }
+    size_t trailing_size = 1;
+    for (auto i = location_dimension + 1; i < dimensions.size(); ++i)
+    {
+        count[i] = dimensions[i].getSize();
+        trailing_size *= count[i];
+    }
+
+    // The windows do not depend on the leading index
+    std::vector<std::pair<size_t, size_t>> windows;
+    for (size_t first = 0; first < selection.size();)
+    {
+        auto last = first + 1;
+        while (last < selection.size() &&
+               selection[last] - selection[last - 1] <= max_entities_gap_per_read &&
+               selection[last] - selection[first] < max_entities_per_read)
+        {
+            ++last;
+        }
+        windows.emplace_back(first, last);
+        first = last;
+    }
+
+    auto const entity_size = trailing_size * source_variable.getType().getSize();
+    std::vector<unsigned char> window_buffer;
+    std::vector<unsigned char> buffer;
+    for (size_t leading = 0; leading < num_leading; ++leading)
+    {
+        auto remainder = leading;
+        for (auto i = location_dimension; i > 0; --i)
+        {
+            start[i - 1] = remainder % dimensions[i - 1].getSize();
+            remainder /= dimensions[i - 1].getSize();
+        }
+
+        for (auto const& [first, last] : windows)
+        {
+            auto const window_begin = selection[first];
+            auto const window_size = selection[last - 1] - window_begin + 1;
+            count[location_dimension] = window_size;
+            start[location_dimension] = window_begin;
+            if (window_size == last - first)
+            {
+                buffer.resize(window_size * entity_size);
+                source_variable.getVar(start, count, buffer.data());
+            }
+            else
+            {
+                window_buffer.resize(window_size * entity_size);
+                source_variable.getVar(start, count, window_buffer.data());
+                buffer.resize((last - first) * entity_size);
+                for (auto i = first; i < last; ++i)
+                {
+                    std::memcpy(buffer.data() + (i - first) * entity_size, window_buffer.data() + (selection[i] - window_begin) * entity_size, entity_size);
+                }
+            }
+
+            count[location_dimension] = last - first;
+            start[location_dimension] = first;
+            target_variable.putVar(start, count, buffer.data());
+        }
+    }
+}
+
+void ugrid::write_mesh2d_subset(Mesh2D& mesh,
+                                std::shared_ptr<netCDF::NcFile> const& source,
+                                Mesh2DSubset subset,
+                                std::vector<Mesh2DSubsetVariable> const& subset_variables,
+                                std::shared_ptr<netCDF::NcFile> const& target,
+                                HeaderPadding const& padding)
+{
+    // Define the mesh of the subset
+    auto const& name = mesh.get_name();
+    std::vector<char> name_array(name_long_length);
+    string_to_char_array(name, name_long_length, name_array.data());
+    ugridapi::Mesh2D mesh2d;
+    mesh2d.name = name_array.data();
+    mesh2d.node_x = subset.node_x.data();
+    mesh2d.node_y = subset.node_y.data();
+    mesh2d.num_nodes = static_cast<int>(subset.nodes.size());
+    mesh2d.edge_nodes = subset.edge_nodes.empty() ? nullptr : subset.edge_nodes.data();
+    mesh2d.num_edges = static_cast<int>(subset.edges.size());
+    mesh2d.face_nodes = subset.face_nodes.data();
+    mesh2d.num_faces = static_cast<int>(subset.faces.size());
+    mesh2d.num_face_nodes_max = static_cast<int>(subset.num_face_nodes_max);
+    mesh2d.int_fill_value = subset.fill_value;
+    Mesh2D target_mesh(target);
+    target_mesh.define(mesh2d);
+
+    // Define the data variables on the selected locations
+    struct ExtractedVariable
+    {
+        netCDF::NcVar source;                 ///< The source data variable
+        netCDF::NcVar target;                 ///< The target data variable
+        size_t location_dimension;            ///< The position of the location dimension in the variable dimensions
+        std::vector<size_t> const* selection; ///< The selected entities of the location
+    };
+    std::vector<ExtractedVariable> extracted_variables;
+    std::vector<std::pair<netCDF::NcVar, netCDF::NcVar>> coordinate_variables;
+    std::vector<std::tuple<UGridFileDimensions, std::string, std::vector<size_t> const*>> const locations{
+        {UGridFileDimensions::node, "node", &subset.nodes},
+        {UGridFileDimensions::edge, "edge", &subset.edges},
+        {UGridFileDimensions::face, "face", &subset.faces}};
+    for (auto const& [location, location_string, selection] : locations)
+    {
+        if (selection->empty())
+        {
+            continue;
+        }
+        auto const& source_location_dimension = mesh.get_dimension(location);
+        auto const& target_location_dimension = target_mesh.get_dimension(location);
+        for (auto const& variable_name : mesh.get_data_variables_names(location_string))
+        {
+            if (std::any_of(subset_variables.begin(), subset_variables.end(), [&variable_name](auto const& variable)
+                            { return variable.name == variable_name; }))
+            {
+                continue;
+            }
+            auto const source_variable = source->getVar(variable_name);
+            auto const dimensions = source_variable.getDims();
+            auto const location_it = std::find(dimensions.begin(), dimensions.end(), source_location_dimension);
+            if (location_it == dimensions.end())
+            {
+                continue;
+            }
+            auto const target_variable = define_variable_on_location(source_variable, source_location_dimension, target_location_dimension, *target);
+            auto const location_dimension = static_cast<size_t>(location_it - dimensions.begin());
+            extracted_variables.push_back({source_variable, target_variable, location_dimension, selection});
+            auto variable_coordinates = define_coordinate_variables(source_variable, location_dimension, *source, *target);
+            coordinate_variables.insert(coordinate_variables.end(), variable_coordinates.begin(), variable_coordinates.end());
+        }
+    }
+
+    std::vector<netCDF::NcVar> target_subset_variables;
+    for (auto const& variable : subset_variables)
+    {
+        auto const location_string = std::get<1>(*std::find_if(locations.begin(), locations.end(), [&variable](auto const& location)
+                                                                  { return std::get<0>(location) == variable.location; }));
+        auto const target_variable = target->addVar(variable.name, netCDF::NcType::nc_INT, target_mesh.get_dimension(variable.location));
+        target_variable.putAtt("mesh", name);
+        target_variable.putAtt("location", location_string);
+        target_variable.putAtt("long_name", variable.long_name);
+        target_subset_variables.emplace_back(target_variable);
+    }
+
+    end_define(*target, padding, "write_mesh2d_subset");
+
+    // Write the topology and stream the data variables
+    target_mesh.put(mesh2d);
+    for (auto const& variable : extracted_variables)
+    {
+        copy_extracted_variable(variable.source, variable.target, variable.location_dimension, *variable.selection);
+    }
+    for (auto const& [source_variable, target_variable] : coordinate_variables)
+    {
+        copy_coordinate_variable(source_variable, target_variable);
+    }
+    for (size_t i = 0; i < subset_variables.size(); ++i)
+    {
+        target_subset_variables[i].putVar(subset_variables[i].values.data());
+    }
+}
+
+size_t ugrid::extract_mesh2d(Mesh2D& mesh,
+                             std::shared_ptr<netCDF::NcFile> const& source,
+                             std::function<bool(double, double)> const& is_inside,
+                             std::shared_ptr<netCDF::NcFile> const& target,
+                             HeaderPadding const& padding)
+{
+    auto subset = select_mesh2d_faces(read_mesh2d_arrays(mesh), is_inside);
+    auto const num_faces = subset.faces.size();
+    if (num_faces == 0)
+    {
+        throw std::invalid_argument("extract_mesh2d: No face of mesh " + mesh.get_name() + " lies inside the region.");
+    }
+
+    write_mesh2d_subset(mesh, source, std::move(subset), {}, target, padding);
+    return num_faces;
+}
@@ -0,0 +1,582 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <UGrid/Constants.hpp>
+#include <UGrid/MeshExtraction.hpp>
+#include <UGrid/MeshMerge.hpp>
+#include <UGrid/Operations.hpp>
+#include <UGrid/Parallel.hpp>
+
+/// @brief The key of the entities dropped from the merged mesh
+static constexpr uint64_t dropped_key = std::numeric_limits<uint64_t>::max();
+
+/// @brief The merged index of the entities dropped from the merged mesh
+static constexpr size_t dropped_index = std::numeric_limits<size_t>::max();
+
+/// @brief The entities of one location (nodes, edges or faces) of all domains, merged into one numbering
+struct MergedLocation
+{
+    size_t size = 0;                                             ///< The number of merged entities
+    std::vector<std::vector<size_t>> merged;                     ///< Per domain, the merged index of each entity, dropped_index if dropped
+    std::vector<std::vector<std::pair<size_t, size_t>>> written; ///< Per domain, the entities written by the domain and their merged index
+};
+
+/// @brief The topology of a domain and its partition variables
+struct DomainTopology
+{
+    ugrid::Mesh2DArrays arrays;           ///< The topology arrays
+    std::vector<int> node_global_numbers; ///< The 1-based global node numbers, empty if absent
+    std::vector<int> edge_global_numbers; ///< The 1-based global edge numbers, empty if absent
+    std::vector<int> face_global_numbers; ///< The 1-based global face numbers, empty if absent
+    std::vector<int> face_domain_numbers; ///< The domain owning each face, empty if absent
+};
+
+/// @brief Reads an int variable, if present
+/// @param nc_file The file
+/// @param name The variable name
+/// @param size The expected number of values
+/// @return The values, empty if the file has no such variable
+static std::vector<int> read_optional_int_variable(netCDF::NcFile const& nc_file, std::string const& name, size_t size)
+{
+    auto const variable = nc_file.getVar(name);
+    if (variable.isNull())
+    {
+        return {};
+    }
+    std::vector<int> values(size);
+    if (size > 0)
+    {
+        variable.getVar(values.data());
+    }
+    return values;
+}
+
+/// @brief Merges the entities of one location of all domains: entities with equal keys become one merged entity,
+///        written by the first domain holding the key
+/// @param keys Per domain, the key of each entity, dropped_key to drop the entity
+/// @param keys_are_indices If the keys are the merged indices, which must then cover [0, number of distinct keys).
+///                         Otherwise the merged entities are numbered in order of first appearance
+/// @param location The location name, used in error messages
+/// @return The merged location
+static MergedLocation merge_entities(std::vector<std::vector<uint64_t>> const& keys, bool keys_are_indices, std::string const& location)
+{
+    MergedLocation result;
+    result.merged.resize(keys.size());
+    result.written.resize(keys.size());
+
+    if (keys_are_indices)
+    {
+        for (auto const& domain_keys : keys)
+        {
+            for (auto const key : domain_keys)
+            {
+                if (key != dropped_key)
+                {
+                    result.size = std::max(result.size, static_cast<size_t>(key) + 1);
+                }
+            }
+        }
+        std::vector<bool> is_written(result.size, false);
+        for (size_t domain = 0; domain < keys.size(); ++domain)
+        {
+            result.merged[domain].resize(keys[domain].size(), dropped_index);
+            for (size_t entity = 0; entity < keys[domain].size(); ++entity)
+            {
+                auto const key = keys[domain][entity];
+                if (key == dropped_key)
+                {
+                    continue;
+                }
+                result.merged[domain][entity] = static_cast<size_t>(key);
+                if (!is_written[key])
+                {
+                    is_written[key] = true;
+                    result.written[domain].emplace_back(entity, static_cast<size_t>(key));
+                }
+            }
+        }
+        if (std::find(is_written.begin(), is_written.end(), false) != is_written.end())
+        {
+            throw std::invalid_argument("merge_mesh2d_partitions: The global " + location + " numbers of the domains leave gaps.");
+        }
+        return result;
+    }
+
+    std::unordered_map<uint64_t, size_t> merged_indices;
+    for (size_t domain = 0; domain < keys.size(); ++domain)
+    {
+        result.merged[domain].resize(keys[domain].size(), dropped_index);
+        for (size_t entity = 0; entity < keys[domain].size(); ++entity)
+        {
+            auto const key = keys[domain][entity];
+            if (key == dropped_key)
+            {
+                continue;
+            }
+            auto const [it, inserted] = merged_indices.try_emplace(key, merged_indices.size());
+            result.merged[domain][entity] = it->second;
+            if (inserted)
+            {
+                result.written[domain].emplace_back(entity, it->second);
+            }
+        }
+    }
+    result.size = merged_indices.size();
+    return result;
+}
+
+/// @brief Gets the key of an entity from its 1-based global number
+/// @param global_number The global number
+/// @param location The location name, used in error messages
+/// @return The 0-based global index
+static uint64_t get_global_number_key(int global_number, std::string const& location)
+{
+    if (global_number < 1)
+    {
+        throw std::invalid_argument("merge_mesh2d_partitions: Invalid global " + location + " number " + std::to_string(global_number) + ".");
+    }
+    return static_cast<uint64_t>(global_number - 1);
+}
+
+/// @brief Gets the keys of entities from their 1-based global numbers
+/// @param global_numbers The global numbers
+/// @param location The location name, used in error messages
+/// @return The 0-based global indices
+static std::vector<uint64_t> get_global_number_keys(std::vector<int> const& global_numbers, std::string const& location)
+{
+    std::vector<uint64_t> keys(global_numbers.size());
+    std::transform(global_numbers.begin(), global_numbers.end(), keys.begin(), [&location](int global_number)
+                   { return get_global_number_key(global_number, location); });
+    return keys;
+}
+
+/// @brief Gets the keys of the nodes of all domains from their coordinates: nodes within the tolerance of a node seen before
+///        get its key, the others get the next key. Nodes are hashed on a grid with the tolerance as cell size,
+///        so only the nine cells around a node are searched
+/// @param domains The domain topologies
+/// @param tolerance The tolerance, positive
+/// @return Per domain, the key of each node
+static std::vector<std::vector<uint64_t>> get_coordinate_node_keys(std::vector<DomainTopology> const& domains, double tolerance)
+{
+    if (!(tolerance > 0.0))
+    {
+        throw std::invalid_argument("merge_mesh2d_partitions: The domains have no global node numbers, so the tolerance must be positive.");
+    }
+
+    auto const get_cell_hash = [](int64_t cell_x, int64_t cell_y)
+    {
+        return static_cast<uint64_t>(cell_x) * 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(cell_y);
+    };
+
+    // Hash collisions only add candidates, which are checked by distance
+    std::unordered_map<uint64_t, std::vector<uint64_t>> cells;
+    std::vector<double> merged_x;
+    std::vector<double> merged_y;
+    std::vector<std::vector<uint64_t>> keys(domains.size());
+    for (size_t domain = 0; domain < domains.size(); ++domain)
+    {
+        auto const& arrays = domains[domain].arrays;
+        keys[domain].resize(arrays.node_x.size());
+        for (size_t node = 0; node < arrays.node_x.size(); ++node)
+        {
+            auto const x = arrays.node_x[node];
+            auto const y = arrays.node_y[node];
+            auto const cell_x = static_cast<int64_t>(std::floor(x / tolerance));
+            auto const cell_y = static_cast<int64_t>(std::floor(y / tolerance));
+
+            auto key = dropped_key;
+            for (int64_t i = cell_x - 1; i <= cell_x + 1 && key == dropped_key; ++i)
+            {
+                for (int64_t j = cell_y - 1; j <= cell_y + 1 && key == dropped_key; ++j)
+                {
+                    auto const it = cells.find(get_cell_hash(i, j));
+                    if (it == cells.end())
+                    {
+                        continue;
+                    }
+                    for (auto const candidate : it->second)
+                    {
+                        if (std::abs(merged_x[candidate] - x) <= tolerance && std::abs(merged_y[candidate] - y) <= tolerance)
+                        {
+                            key = candidate;
+                            break;
+                        }
+                    }
+                }
+            }
+            if (key == dropped_key)
+            {
+                key = merged_x.size();
+                merged_x.push_back(x);
+                merged_y.push_back(y);
+                cells[get_cell_hash(cell_x, cell_y)].push_back(key);
+            }
+            keys[domain][node] = key;
+        }
+    }
+    return keys;
+}
+
+/// @brief Checks whether every domain has a partition variable
+/// @param domains The domain topologies
+/// @param member The partition variable
+/// @return True if every domain has the variable
+static bool all_domains_have(std::vector<DomainTopology> const& domains, std::vector<int> DomainTopology::*member)
+{
+    return std::all_of(domains.begin(), domains.end(), [member](DomainTopology const& domain)
+                       { return !(domain.*member).empty(); });
+}
+
+/// @brief Gets the merged index of a node of a domain
+/// @param nodes The merged nodes
+/// @param domain The domain
+/// @param node The node of the domain
+/// @return The merged node
+static int get_merged_node(MergedLocation const& nodes, size_t domain, int node)
+{
+    if (node < 0 || static_cast<size_t>(node) >= nodes.merged[domain].size())
+    {
+        throw std::invalid_argument("merge_mesh2d_partitions: Invalid node index " + std::to_string(node) + " in domain " + std::to_string(domain) + ".");
+    }
+    return static_cast<int>(nodes.merged[domain][static_cast<size_t>(node)]);
+}
+
+size_t ugrid::merge_mesh2d_partitions(std::vector<Mesh2D>& domains,
+                                      std::vector<std::shared_ptr<netCDF::NcFile>> const& sources,
+                                      double tolerance,
+                                      std::shared_ptr<netCDF::NcFile> const& target,
+                                      HeaderPadding const& padding,
+                                      size_t max_read_threads)
+{
+    auto const num_domains = domains.size();
+    if (num_domains == 0 || sources.size() != num_domains)
+    {
+        throw std::invalid_argument("merge_mesh2d_partitions: There must be one file per domain, and at least one domain.");
+    }
+    auto const& name = domains[0].get_name();
+
+    // Read the domain topologies and partition variables
+    std::vector<DomainTopology> topologies(num_domains);
+    parallel_for(num_domains, max_read_threads, [&](size_t domain)
+                 {
+                     auto& topology = topologies[domain];
+                     topology.arrays = read_mesh2d_arrays(domains[domain]);
+                     auto const num_nodes = topology.arrays.node_x.size();
+                     auto const num_edges = topology.arrays.edge_nodes.size() / 2;
+                     auto const num_faces = topology.arrays.get_num_faces();
+                     topology.node_global_numbers = read_optional_int_variable(*sources[domain], name + "_node_global_number", num_nodes);
+                     topology.edge_global_numbers = read_optional_int_variable(*sources[domain], name + "_edge_global_number", num_edges);
+                     topology.face_global_numbers = read_optional_int_variable(*sources[domain], name + "_face_global_number", num_faces);
+                     topology.face_domain_numbers = read_optional_int_variable(*sources[domain], name + "_face_domain_number", num_faces);
+                 });
+
+    // Merge the nodes
+    std::vector<std::vector<uint64_t>> keys(num_domains);
+    bool const has_node_numbers = all_domains_have(topologies, &DomainTopology::node_global_numbers);
+    if (has_node_numbers)
+    {
+        for (size_t domain = 0; domain < num_domains; ++domain)
+        {
+            keys[domain] = get_global_number_keys(topologies[domain].node_global_numbers, "node");
+        }
+    }
+    else
+    {
+        keys = get_coordinate_node_keys(topologies, tolerance);
+    }
+    auto const nodes = merge_entities(keys, true, "node");
+    if (nodes.size > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::overflow_error("merge_mesh2d_partitions: The number of merged nodes exceeds the int range.");
+    }
+
+    // Merge the faces, without the ghost faces
+    bool const has_face_numbers = all_domains_have(topologies, &DomainTopology::face_global_numbers);
+    std::map<std::vector<int>, uint64_t> face_node_keys;
+    for (size_t domain = 0; domain < num_domains; ++domain)
+    {
+        auto const& topology = topologies[domain];
+        auto const& arrays = topology.arrays;
+        auto const num_faces = arrays.get_num_faces();
+        keys[domain].assign(num_faces, dropped_key);
+        for (size_t face = 0; face < num_faces; ++face)
+        {
+            if (!topology.face_domain_numbers.empty() && topology.face_domain_numbers[face] != static_cast<int>(domain))
+            {
+                continue;
+            }
+            if (has_face_numbers)
+            {
+                keys[domain][face] = get_global_number_key(topology.face_global_numbers[face], "face");
+                continue;
+            }
+
+            // Without global numbers a face is identified by its sorted merged nodes
+            std::vector<int> face_key;
+            for (size_t k = 0; k < arrays.num_face_nodes_max; ++k)
+            {
+                auto const node = arrays.face_nodes[face * arrays.num_face_nodes_max + k];
+                if (node == arrays.fill_value)
+                {
+                    break;
+                }
+                face_key.push_back(get_merged_node(nodes, domain, node));
+            }
+            std::sort(face_key.begin(), face_key.end());
+            keys[domain][face] = face_node_keys.try_emplace(std::move(face_key), face_node_keys.size()).first->second;
+        }
+    }
+    auto const faces = merge_entities(keys, true, "face");
+
+    // Merge the edges, if every domain has edges
+    MergedLocation edges;
+    bool const has_edges = std::all_of(topologies.begin(), topologies.end(), [](DomainTopology const& topology)
+                                       { return !topology.arrays.edge_nodes.empty(); });
+    if (has_edges)
+    {
+        bool const has_edge_numbers = all_domains_have(topologies, &DomainTopology::edge_global_numbers);
+        for (size_t domain = 0; domain < num_domains; ++domain)
+        {
+            auto const& topology = topologies[domain];
+            if (has_edge_numbers)
+            {
+                keys[domain] = get_global_number_keys(topology.edge_global_numbers, "edge");
+                continue;
+            }
+            auto const num_edges = topology.arrays.edge_nodes.size() / 2;
+            keys[domain].resize(num_edges);
+            for (size_t edge = 0; edge < num_edges; ++edge)
+            {
+                auto const first = static_cast<uint64_t>(get_merged_node(nodes, domain, topology.arrays.edge_nodes[2 * edge]));
+                auto const second = static_cast<uint64_t>(get_merged_node(nodes, domain, topology.arrays.edge_nodes[2 * edge + 1]));
+                keys[domain][edge] = (std::min(first, second) << 32) | std::max(first, second);
+            }
+        }
+        edges = merge_entities(keys, has_edge_numbers, "edge");
+    }
+
+    // Assemble the merged topology
+    size_t num_face_nodes_max = 0;
+    for (auto const& topology : topologies)
+    {
+        num_face_nodes_max = std::max(num_face_nodes_max, topology.arrays.num_face_nodes_max);
+    }
+    auto const fill_value = topologies[0].arrays.fill_value;
+    std::vector<double> node_x(nodes.size);
+    std::vector<double> node_y(nodes.size);
+    std::vector<int> face_nodes(faces.size * num_face_nodes_max, fill_value);
+    std::vector<int> edge_nodes(2 * edges.size);
+    for (size_t domain = 0; domain < num_domains; ++domain)
+    {
+        auto const& arrays = topologies[domain].arrays;
+        for (auto const& [node, merged_node] : nodes.written[domain])
+        {
+            node_x[merged_node] = arrays.node_x[node];
+            node_y[merged_node] = arrays.node_y[node];
+        }
+        for (auto const& [face, merged_face] : faces.written[domain])
+        {
+            for (size_t k = 0; k < arrays.num_face_nodes_max; ++k)
+            {
+                auto const node = arrays.face_nodes[face * arrays.num_face_nodes_max + k];
+                if (node == arrays.fill_value)
+                {
+                    break;
+                }
+                face_nodes[merged_face * num_face_nodes_max + k] = get_merged_node(nodes, domain, node);
+            }
+        }
+        if (!has_edges)
+        {
+            continue;
+        }
+        for (auto const& [edge, merged_edge] : edges.written[domain])
+        {
+            edge_nodes[2 * merged_edge] = get_merged_node(nodes, domain, arrays.edge_nodes[2 * edge]);
+            edge_nodes[2 * merged_edge + 1] = get_merged_node(nodes, domain, arrays.edge_nodes[2 * edge + 1]);
+        }
+    }
+
+    // Define the merged mesh
+    std::vector<char> name_array(name_long_length);
+    string_to_char_array(name, name_long_length, name_array.data());
+    ugridapi::Mesh2D mesh2d;
+    mesh2d.name = name_array.data();
+    mesh2d.node_x = node_x.data();
+    mesh2d.node_y = node_y.data();
+    mesh2d.num_nodes = static_cast<int>(nodes.size);
+    mesh2d.edge_nodes = edge_nodes.empty() ? nullptr : edge_nodes.data();
+    mesh2d.num_edges = static_cast<int>(edges.size);
+    mesh2d.face_nodes = face_nodes.data();
+    mesh2d.num_faces = static_cast<int>(faces.size);
+    mesh2d.num_face_nodes_max = static_cast<int>(num_face_nodes_max);
+    mesh2d.int_fill_value = fill_value;
+    Mesh2D target_mesh(target);
+    target_mesh.define(mesh2d);
+
+    // Define the data variables of the first domain, without the partition variables
+    struct MergedVariable
+    {
+        std::vector<netCDF::NcVar> sources; ///< The data variable of each domain
+        netCDF::NcVar target;               ///< The merged data variable
+        size_t location_dimension;          ///< The position of the location dimension in the variable dimensions
+        MergedLocation const* location;     ///< The merged location
+    };
+    std::vector<MergedVariable> merged_variables;
+    std::vector<std::pair<netCDF::NcVar, netCDF::NcVar>> coordinate_variables;
+    std::vector<std::string> const partition_variables{name + "_node_global_number",
+                                                       name + "_edge_global_number",
+                                                       name + "_face_global_number",
+                                                       name + "_face_domain_number"};
+    std::vector<std::tuple<UGridFileDimensions, std::string, MergedLocation const*>> const locations{
+        {UGridFileDimensions::node, "node", &nodes},
+        {UGridFileDimensions::edge, "edge", &edges},
+        {UGridFileDimensions::face, "face", &faces}};
+    for (auto const& [location, location_string, merged_location] : locations)
+    {
+        if (merged_location->size == 0)
+        {
+            continue;
+        }
+        auto const& location_dimension = domains[0].get_dimension(location);
+        for (auto const& variable_name : domains[0].get_data_variables_names(location_string))
+        {
+            if (std::find(partition_variables.begin(), partition_variables.end(), variable_name) != partition_variables.end())
+            {
+                continue;
+            }
+            auto const first_variable = sources[0]->getVar(variable_name);
+            auto const dimensions = first_variable.getDims();
+            auto const location_it = std::find(dimensions.begin(), dimensions.end(), location_dimension);
+            if (location_it == dimensions.end())
+            {
+                continue;
+            }
+
+            MergedVariable merged_variable{{}, {}, static_cast<size_t>(location_it - dimensions.begin()), merged_location};
+            for (size_t domain = 0; domain < num_domains; ++domain)
+            {
+                auto const variable = sources[domain]->getVar(variable_name);
+                if (variable.isNull() || variable.getDimCount() != first_variable.getDimCount())
+                {
+                    throw std::invalid_argument("merge_mesh2d_partitions: Variable " + variable_name + " is missing or differs in domain " + std::to_string(domain) + ".");
+                }
+
+                // The domains must hold the same records and other non-location dimensions
+                auto const variable_dimensions = variable.getDims();
+                for (size_t i = 0; i < dimensions.size(); ++i)
+                {
+                    if (i != merged_variable.location_dimension && variable_dimensions[i].getSize() != dimensions[i].getSize())
+                    {
+                        throw std::invalid_argument("merge_mesh2d_partitions: Dimension " + dimensions[i].getName() + " of variable " + variable_name + " differs in domain " + std::to_string(domain) + ".");
+                    }
+                }
+                merged_variable.sources.emplace_back(variable);
+            }
+            merged_variable.target = define_variable_on_location(first_variable, location_dimension, target_mesh.get_dimension(location), *target);
+            auto variable_coordinates = define_coordinate_variables(first_variable, merged_variable.location_dimension, *sources[0], *target);
+            coordinate_variables.insert(coordinate_variables.end(), variable_coordinates.begin(), variable_coordinates.end());
+            merged_variables.emplace_back(std::move(merged_variable));
+        }
+    }
+
+    end_define(*target, padding, "merge_mesh2d_partitions");
+    target_mesh.put(mesh2d);
+
+    // Stream the data variables, one slab of the merged variable at a time, reading the domains concurrently.
+    // The sizes come from the first domain, the unlimited dimensions of the target are still empty
+    for (auto const& variable : merged_variables)
+    {
+        auto const dimensions = variable.sources[0].getDims();
+        auto const location_dimension = variable.location_dimension;
+        size_t num_leading = 1;
+        for (size_t i = 0; i < location_dimension; ++i)
+        {
+            num_leading *= dimensions[i].getSize();
+        }
+        size_t row_size = variable.target.getType().getSize();
+        for (auto i = location_dimension + 1; i < dimensions.size(); ++i)
+        {
+            row_size *= dimensions[i].getSize();
+        }
+
+        std::vector<size_t> start(dimensions.size(), 0);
+        std::vector<size_t> count(dimensions.size(), 1);
+        for (auto i = location_dimension + 1; i < dimensions.size(); ++i)
+        {
+            count[i] = dimensions[i].getSize();
+        }
+        std::vector<unsigned char> merged(variable.location->size * row_size);
+        for (size_t leading = 0; leading < num_leading; ++leading)
+        {
+            auto remainder = leading;
+            for (auto i = location_dimension; i > 0; --i)
+            {
+                start[i - 1] = remainder % dimensions[i - 1].getSize();
+                remainder /= dimensions[i - 1].getSize();
+            }
+
+            parallel_for(num_domains, max_read_threads, [&](size_t domain)
+                         {
+                             auto const& written = variable.location->written[domain];
+                             if (written.empty())
+                             {
+                                 return;
+                             }
+                             auto domain_count = count;
+                             domain_count[location_dimension] = variable.sources[domain].getDim(static_cast<int>(location_dimension)).getSize();
+                             std::vector<unsigned char> buffer(domain_count[location_dimension] * row_size);
+                             variable.sources[domain].getVar(start, domain_count, buffer.data());
+                             for (auto const& [entity, merged_entity] : written)
+                             {
+                                 std::memcpy(merged.data() + merged_entity * row_size, buffer.data() + entity * row_size, row_size);
+                             }
+                         });
+
+            count[location_dimension] = variable.location->size;
+            variable.target.putVar(start, count, merged.data());
+        }
+    }
+    for (auto const& [source_variable, target_variable] : coordinate_variables)
+    {
+        copy_coordinate_variable(source_variable, target_variable);
+    }
+
+    return faces.size;
+}
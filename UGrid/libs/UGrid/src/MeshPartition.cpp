@@ -0,0 +1,219 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <UGrid/MeshConnectivity.hpp>
+#include <UGrid/MeshPartition.hpp>
+#include <UGrid/Parallel.hpp>
+#include <UGrid/SpaceFillingCurve.hpp>
+
+std::vector<int> ugrid::partition_mesh2d_faces(Mesh2DArrays const& mesh, size_t num_domains, size_t max_threads)
+{
+    // The face centres are the mean of the face nodes
+    auto const num_faces = mesh.get_num_faces();
+    auto const num_face_nodes_max = mesh.num_face_nodes_max;
+    std::vector<double> center_x(num_faces);
+    std::vector<double> center_y(num_faces);
+    parallel_for_each_index(num_faces, max_threads, [&](size_t face)
+                            {
+                                double sum_x = 0.0;
+                                double sum_y = 0.0;
+                                size_t num_nodes = 0;
+                                for (size_t k = 0; k < num_face_nodes_max; ++k)
+                                {
+                                    auto const node = mesh.face_nodes[face * num_face_nodes_max + k];
+                                    if (node == mesh.fill_value)
+                                    {
+                                        break;
+                                    }
+                                    if (node < 0 || static_cast<size_t>(node) >= mesh.node_x.size())
+                                    {
+                                        throw std::invalid_argument("partition_mesh2d_faces: Invalid node index in face " + std::to_string(face) + ".");
+                                    }
+                                    sum_x += mesh.node_x[node];
+                                    sum_y += mesh.node_y[node];
+                                    ++num_nodes;
+                                }
+                                if (num_nodes == 0)
+                                {
+                                    throw std::invalid_argument("partition_mesh2d_faces: Face " + std::to_string(face) + " has no nodes.");
+                                }
+                                center_x[face] = sum_x / static_cast<double>(num_nodes);
+                                center_y[face] = sum_y / static_cast<double>(num_nodes);
+                            });
+
+    return partition_along_hilbert_curve(center_x.data(), center_y.data(), num_faces, num_domains, max_threads);
+}
+
+/// @brief Adds layers of ghost faces around the faces of a domain
+/// @param face_faces The 0-based neighbouring face across each face edge
+/// @param num_face_nodes_max The maximum number of nodes per face
+/// @param fill_value The fill value of the face faces
+/// @param num_ghost_layers The number of ghost layers
+/// @param faces [in,out] The faces of the domain, ascending, extended with the ghost faces
+static void add_ghost_layers(std::vector<int> const& face_faces,
+                             size_t num_face_nodes_max,
+                             int fill_value,
+                             size_t num_ghost_layers,
+                             std::vector<size_t>& faces)
+{
+    auto frontier = faces;
+    std::vector<size_t> neighbours;
+    std::vector<size_t> layer;
+    std::vector<size_t> merged;
+    for (size_t l = 0; l < num_ghost_layers && !frontier.empty(); ++l)
+    {
+        neighbours.clear();
+        for (auto const face : frontier)
+        {
+            for (size_t k = 0; k < num_face_nodes_max; ++k)
+            {
+                auto const neighbour = face_faces[face * num_face_nodes_max + k];
+                if (neighbour != fill_value && neighbour >= 0)
+                {
+                    neighbours.push_back(static_cast<size_t>(neighbour));
+                }
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+        layer.clear();
+        std::set_difference(neighbours.begin(), neighbours.end(), faces.begin(), faces.end(), std::back_inserter(layer));
+        merged.clear();
+        std::merge(faces.begin(), faces.end(), layer.begin(), layer.end(), std::back_inserter(merged));
+        faces.swap(merged);
+        frontier.swap(layer);
+    }
+}
+
+void ugrid::write_mesh2d_partitions(Mesh2D& mesh,
+                                    std::shared_ptr<netCDF::NcFile> const& source,
+                                    std::vector<int> const& face_domains,
+                                    size_t num_domains,
+                                    size_t num_ghost_layers,
+                                    std::function<std::shared_ptr<netCDF::NcFile>(size_t)> const& create_file,
+                                    HeaderPadding const& padding,
+                                    size_t max_threads)
+{
+    auto const arrays = read_mesh2d_arrays(mesh);
+    auto const num_faces = arrays.get_num_faces();
+    if (face_domains.size() != num_faces)
+    {
+        throw std::invalid_argument("write_mesh2d_partitions: There must be one domain per face.");
+    }
+
+    // The faces of each domain, ascending, in compressed row format
+    std::vector<size_t> domain_offsets(num_domains + 1, 0);
+    for (auto const domain : face_domains)
+    {
+        if (domain < 0 || static_cast<size_t>(domain) >= num_domains)
+        {
+            throw std::invalid_argument("write_mesh2d_partitions: Domain " + std::to_string(domain) + " is out of range.");
+        }
+        ++domain_offsets[static_cast<size_t>(domain) + 1];
+    }
+    for (size_t domain = 0; domain < num_domains; ++domain)
+    {
+        if (domain_offsets[domain + 1] == 0)
+        {
+            throw std::invalid_argument("write_mesh2d_partitions: Domain " + std::to_string(domain) + " has no faces.");
+        }
+        domain_offsets[domain + 1] += domain_offsets[domain];
+    }
+    std::vector<size_t> domain_faces(num_faces);
+    {
+        auto positions = domain_offsets;
+        for (size_t face = 0; face < num_faces; ++face)
+        {
+            domain_faces[positions[static_cast<size_t>(face_domains[face])]++] = face;
+        }
+    }
+
+    // The face neighbours for the ghost layers, and the face edges numbered as the edges in the file
+    auto connectivity = derive_connectivity(arrays.face_nodes.data(), num_faces, arrays.num_face_nodes_max, arrays.fill_value, max_threads);
+    bool const has_edges = !arrays.edge_nodes.empty();
+    if (has_edges)
+    {
+        renumber_edges(connectivity, arrays.edge_nodes);
+    }
+
+    auto const& name = mesh.get_name();
+    auto const to_global_numbers = [](std::vector<size_t> const& indices)
+    {
+        std::vector<int> numbers(indices.size());
+        std::transform(indices.begin(), indices.end(), numbers.begin(), [](size_t index)
+                       { return static_cast<int>(index) + 1; });
+        return numbers;
+    };
+    for (size_t domain = 0; domain < num_domains; ++domain)
+    {
+        std::vector<size_t> faces(domain_faces.begin() + static_cast<std::ptrdiff_t>(domain_offsets[domain]),
+                                  domain_faces.begin() + static_cast<std::ptrdiff_t>(domain_offsets[domain + 1]));
+        add_ghost_layers(connectivity.face_faces, arrays.num_face_nodes_max, connectivity.fill_value, num_ghost_layers, faces);
+
+        std::vector<size_t> edges;
+        if (has_edges)
+        {
+            for (auto const face : faces)
+            {
+                for (size_t k = 0; k < arrays.num_face_nodes_max; ++k)
+                {
+                    auto const edge = connectivity.face_edges[face * arrays.num_face_nodes_max + k];
+                    if (edge != connectivity.fill_value)
+                    {
+                        edges.push_back(static_cast<size_t>(edge));
+                    }
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        }
+
+        auto subset = make_mesh2d_subset(arrays, std::move(faces), std::move(edges));
+        std::vector<Mesh2DSubsetVariable> subset_variables{
+            {name + "_node_global_number", UGridFileDimensions::node, "Global node number", to_global_numbers(subset.nodes)},
+            {name + "_face_global_number", UGridFileDimensions::face, "Global face number", to_global_numbers(subset.faces)},
+            {name + "_face_domain_number", UGridFileDimensions::face, "Domain number of the face", {}}};
+        if (has_edges)
+        {
+            subset_variables.push_back({name + "_edge_global_number", UGridFileDimensions::edge, "Global edge number", to_global_numbers(subset.edges)});
+        }
+        auto& face_domain_numbers = subset_variables[2].values;
+        face_domain_numbers.reserve(subset.faces.size());
+        for (auto const face : subset.faces)
+        {
+            face_domain_numbers.push_back(face_domains[face]);
+        }
+
+        write_mesh2d_subset(mesh, source, std::move(subset), subset_variables, create_file(domain), padding);
+    }
+}
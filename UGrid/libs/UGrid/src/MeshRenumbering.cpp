@@ -0,0 +1,303 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <UGrid/Mesh2D.hpp>
+#include <UGrid/MeshRenumbering.hpp>
+#include <UGrid/Parallel.hpp>
+#include <UGrid/SpaceFillingCurve.hpp>
+
+/// @brief A connectivity array of the api struct, given as 32-bit or 64-bit indices. The 64-bit array takes precedence when set
+struct ConnectivityArray
+{
+    char const* name = "";          ///< The array name, used in error messages
+    int* values = nullptr;          ///< The 32-bit indices
+    int64_t* values_long = nullptr; ///< The 64-bit indices
+    size_t num_rows = 0;            ///< The number of entities the array is defined on
+    size_t num_columns = 0;         ///< The number of indices per entity
+    size_t num_targets = 0;         ///< The number of entities the indices refer to
+    bool has_fill_values = false;   ///< If unused entries are marked with the fill value
+
+    /// @brief Gets if the array is set
+    /// @return True if one of the arrays is set
+    [[nodiscard]] bool is_set() const
+    {
+        return values != nullptr || values_long != nullptr;
+    }
+
+    /// @brief Gets an index
+    /// @param position [in] The position in the array
+    /// @return The index, including the start index
+    [[nodiscard]] int64_t get(size_t position) const
+    {
+        return values_long != nullptr ? values_long[position] : int64_t{values[position]};
+    }
+};
+
+/// @brief Checks that all indices of a connectivity array refer to an existing entity
+/// @param array [in] The array
+/// @param start_index [in] The start index of the indices
+/// @param fill_value [in] The fill value
+static void check_indices(ConnectivityArray const& array, int start_index, int fill_value)
+{
+    if (!array.is_set())
+    {
+        return;
+    }
+    auto const size = array.num_rows * array.num_columns;
+    for (size_t i = 0; i < size; ++i)
+    {
+        auto const value = array.get(i);
+        if (array.has_fill_values && value == fill_value)
+        {
+            continue;
+        }
+        if (value < start_index || static_cast<uint64_t>(value - start_index) >= array.num_targets)
+        {
+            throw std::out_of_range(std::string("Mesh2D renumbering: ") + array.name + " contains the index " + std::to_string(value) +
+                                    ", out of the range of " + std::to_string(array.num_targets) + " entities.");
+        }
+    }
+}
+
+/// @brief Reorders the rows of an index array and maps its indices to the new numbering
+/// @tparam T The index type
+/// @param row_permutation [in] The old row of each new row
+/// @param target_inverse [in] The new index of each old entity the indices refer to
+/// @param num_columns [in] The number of indices per row
+/// @param start_index [in] The start index of the indices
+/// @param fill_value [in] The fill value, left as is
+/// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+/// @param values [in,out] The indices
+template <typename T>
+static void renumber_indices(std::vector<size_t> const& row_permutation,
+                             std::vector<size_t> const& target_inverse,
+                             size_t num_columns,
+                             T start_index,
+                             T fill_value,
+                             size_t max_threads,
+                             T* values)
+{
+    ugrid::permute_values(row_permutation, num_columns, values);
+    ugrid::parallel_for_each_index(row_permutation.size() * num_columns, max_threads, [&](size_t i)
+                                   {
+                                       if (values[i] != fill_value)
+                                       {
+                                           values[i] = static_cast<T>(target_inverse[static_cast<size_t>(values[i] - start_index)]) + start_index;
+                                       }
+                                   });
+}
+
+/// @brief Reorders the rows of a connectivity array and maps its indices to the new numbering
+/// @param array [in] The array, left as is if not set
+/// @param row_permutation [in] The old row of each new row
+/// @param target_inverse [in] The new index of each old entity the indices refer to
+/// @param mesh2d [in] The mesh2d the array belongs to, for its start index and fill value
+/// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+static void renumber_connectivity(ConnectivityArray const& array,
+                                  std::vector<size_t> const& row_permutation,
+                                  std::vector<size_t> const& target_inverse,
+                                  ugridapi::Mesh2D const& mesh2d,
+                                  size_t max_threads)
+{
+    if (array.values_long != nullptr)
+    {
+        renumber_indices(row_permutation, target_inverse, array.num_columns, int64_t{mesh2d.start_index}, int64_t{mesh2d.int_fill_value}, max_threads, array.values_long);
+    }
+    else if (array.values != nullptr)
+    {
+        renumber_indices(row_permutation, target_inverse, array.num_columns, mesh2d.start_index, mesh2d.int_fill_value, max_threads, array.values);
+    }
+}
+
+/// @brief Computes the Hilbert order of entities located at the mean of their nodes
+/// @param mesh2d [in] The mesh2d
+/// @param entity_nodes [in] The nodes of each entity, with checked indices
+/// @param grid [in] The grid of the curve
+/// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+/// @return The entities in curve order
+static std::vector<size_t> sort_entities_by_nodes(ugridapi::Mesh2D const& mesh2d,
+                                                  ConnectivityArray const& entity_nodes,
+                                                  ugrid::HilbertGrid const& grid,
+                                                  size_t max_threads)
+{
+    std::vector<double> x(entity_nodes.num_rows, grid.min_x);
+    std::vector<double> y(entity_nodes.num_rows, grid.min_y);
+    ugrid::parallel_for_each_index(entity_nodes.num_rows, max_threads, [&](size_t entity)
+                                   {
+                                       double sum_x = 0.0;
+                                       double sum_y = 0.0;
+                                       size_t num_nodes = 0;
+                                       for (size_t n = 0; n < entity_nodes.num_columns; ++n)
+                                       {
+                                           auto const node = entity_nodes.get(entity * entity_nodes.num_columns + n);
+                                           if (entity_nodes.has_fill_values && node == mesh2d.int_fill_value)
+                                           {
+                                               continue;
+                                           }
+                                           auto const node_index = static_cast<size_t>(node - mesh2d.start_index);
+                                           sum_x += mesh2d.node_x[node_index];
+                                           sum_y += mesh2d.node_y[node_index];
+                                           ++num_nodes;
+                                       }
+                                       if (num_nodes > 0)
+                                       {
+                                           x[entity] = sum_x / static_cast<double>(num_nodes);
+                                           y[entity] = sum_y / static_cast<double>(num_nodes);
+                                       }
+                                   });
+    return ugrid::sort_along_hilbert_curve(x.data(), y.data(), x.size(), grid, max_threads);
+}
+
+/// @brief Computes the Hilbert order of the edges or faces of a mesh2d
+/// @param mesh2d [in] The mesh2d
+/// @param entity_nodes [in] The nodes of each entity
+/// @param entity_x [in] The entity x coordinates, used if the nodes are not set
+/// @param entity_y [in] The entity y coordinates, used if the nodes are not set
+/// @param grid [in] The grid of the curve
+/// @param max_threads [in] The maximum number of threads, 0 to use the hardware concurrency
+/// @return The entities in curve order, the identity if neither the nodes nor the coordinates are set
+static std::vector<size_t> sort_entities(ugridapi::Mesh2D const& mesh2d,
+                                         ConnectivityArray const& entity_nodes,
+                                         double const* entity_x,
+                                         double const* entity_y,
+                                         ugrid::HilbertGrid const& grid,
+                                         size_t max_threads)
+{
+    if (entity_nodes.is_set())
+    {
+        check_indices(entity_nodes, mesh2d.start_index, mesh2d.int_fill_value);
+        return sort_entities_by_nodes(mesh2d, entity_nodes, grid, max_threads);
+    }
+    if (entity_x != nullptr && entity_y != nullptr)
+    {
+        return ugrid::sort_along_hilbert_curve(entity_x, entity_y, entity_nodes.num_rows, grid, max_threads);
+    }
+    std::vector<size_t> order(entity_nodes.num_rows);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    return order;
+}
+
+ugrid::Mesh2DPermutations ugrid::compute_mesh2d_hilbert_order(ugridapi::Mesh2D const& mesh2d, size_t max_threads)
+{
+    if (mesh2d.node_x == nullptr || mesh2d.node_y == nullptr)
+    {
+        throw std::invalid_argument("compute_mesh2d_hilbert_order: node_x and node_y are required.");
+    }
+    auto const num_nodes = ugrid::get_mesh2d_count(mesh2d.num_nodes, mesh2d.num_nodes_long);
+    auto const num_edges = ugrid::get_mesh2d_count(mesh2d.num_edges, mesh2d.num_edges_long);
+    auto const num_faces = ugrid::get_mesh2d_count(mesh2d.num_faces, mesh2d.num_faces_long);
+    auto const num_face_nodes_max = static_cast<size_t>(std::max(mesh2d.num_face_nodes_max, 0));
+
+    // Edges and faces are placed on the grid of the nodes, so that the three curves coincide
+    auto const grid = get_hilbert_grid(mesh2d.node_x, mesh2d.node_y, num_nodes, max_threads);
+
+    Mesh2DPermutations permutations;
+    permutations.nodes = sort_along_hilbert_curve(mesh2d.node_x, mesh2d.node_y, num_nodes, grid, max_threads);
+    permutations.edges = sort_entities(mesh2d,
+                                       {"edge_nodes", mesh2d.edge_nodes, mesh2d.edge_nodes_long, num_edges, 2, num_nodes, false},
+                                       mesh2d.edge_x,
+                                       mesh2d.edge_y,
+                                       grid,
+                                       max_threads);
+    permutations.faces = sort_entities(mesh2d,
+                                       {"face_nodes", mesh2d.face_nodes, mesh2d.face_nodes_long, num_faces, num_face_nodes_max, num_nodes, true},
+                                       mesh2d.face_x,
+                                       mesh2d.face_y,
+                                       grid,
+                                       max_threads);
+    return permutations;
+}
+
+std::vector<size_t> ugrid::invert_permutation(std::vector<size_t> const& permutation)
+{
+    auto const size = permutation.size();
+    std::vector<size_t> inverse(size, size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        auto const old_index = permutation[i];
+        if (old_index >= size || inverse[old_index] != size)
+        {
+            throw std::invalid_argument("invert_permutation: The index " + std::to_string(old_index) + " is out of range or repeated.");
+        }
+        inverse[old_index] = i;
+    }
+    return inverse;
+}
+
+void ugrid::renumber_mesh2d(Mesh2DPermutations const& permutations, size_t max_threads, ugridapi::Mesh2D& mesh2d)
+{
+    auto const num_nodes = ugrid::get_mesh2d_count(mesh2d.num_nodes, mesh2d.num_nodes_long);
+    auto const num_edges = ugrid::get_mesh2d_count(mesh2d.num_edges, mesh2d.num_edges_long);
+    auto const num_faces = ugrid::get_mesh2d_count(mesh2d.num_faces, mesh2d.num_faces_long);
+    auto const num_face_nodes_max = static_cast<size_t>(std::max(mesh2d.num_face_nodes_max, 0));
+    if (permutations.nodes.size() != num_nodes || permutations.edges.size() != num_edges || permutations.faces.size() != num_faces)
+    {
+        throw std::invalid_argument("renumber_mesh2d: The permutation sizes do not match the number of nodes, edges and faces.");
+    }
+    auto const node_inverse = invert_permutation(permutations.nodes);
+    auto const edge_inverse = invert_permutation(permutations.edges);
+    auto const face_inverse = invert_permutation(permutations.faces);
+
+    ConnectivityArray const edge_nodes{"edge_nodes", mesh2d.edge_nodes, mesh2d.edge_nodes_long, num_edges, 2, num_nodes, false};
+    ConnectivityArray const edge_faces{"edge_faces", mesh2d.edge_faces, mesh2d.edge_faces_long, num_edges, 2, num_faces, true};
+    ConnectivityArray const face_nodes{"face_nodes", mesh2d.face_nodes, mesh2d.face_nodes_long, num_faces, num_face_nodes_max, num_nodes, true};
+    ConnectivityArray const face_edges{"face_edges", mesh2d.face_edges, mesh2d.face_edges_long, num_faces, num_face_nodes_max, num_edges, true};
+    ConnectivityArray const face_faces{"face_faces", mesh2d.face_faces, mesh2d.face_faces_long, num_faces, num_face_nodes_max, num_faces, true};
+
+    // Nothing is modified before all indices are known to be valid
+    for (auto const* array : {&edge_nodes, &edge_faces, &face_nodes, &face_edges, &face_faces})
+    {
+        check_indices(*array, mesh2d.start_index, mesh2d.int_fill_value);
+    }
+
+    permute_values(permutations.nodes, 1, mesh2d.node_x);
+    permute_values(permutations.nodes, 1, mesh2d.node_y);
+    permute_values(permutations.nodes, 1, mesh2d.node_z);
+    permute_values(permutations.edges, 1, mesh2d.edge_x);
+    permute_values(permutations.edges, 1, mesh2d.edge_y);
+    permute_values(permutations.edges, 1, mesh2d.edge_z);
+    permute_values(permutations.faces, 1, mesh2d.face_x);
+    permute_values(permutations.faces, 1, mesh2d.face_y);
+    permute_values(permutations.faces, 1, mesh2d.face_z);
+    permute_values(permutations.faces, num_face_nodes_max, mesh2d.face_x_bnd);
+    permute_values(permutations.faces, num_face_nodes_max, mesh2d.face_y_bnd);
+
+    renumber_connectivity(edge_nodes, permutations.edges, node_inverse, mesh2d, max_threads);
+    renumber_connectivity(edge_faces, permutations.edges, face_inverse, mesh2d, max_threads);
+    renumber_connectivity(face_nodes, permutations.faces, node_inverse, mesh2d, max_threads);
+    renumber_connectivity(face_edges, permutations.faces, edge_inverse, mesh2d, max_threads);
+    renumber_connectivity(face_faces, permutations.faces, face_inverse, mesh2d, max_threads);
+}
@@ -37,13 +37,19 @@ Network1D::Network1D(std::shared_ptr<netCDF::NcFile> nc_file,
                      netCDF::NcVar const& topology_variable,
                      std::map<std::string, std::vector<netCDF::NcVar>> const& entity_attributes,
                      std::map<std::string, std::vector<std::string>> const& entity_attribute_names,
-                     std::map<UGridFileDimensions, netCDF::NcDim> const& entity_dimensions) : UGridEntity(nc_file, topology_variable, entity_attributes, entity_attribute_names, entity_dimensions)
-
+                     std::map<UGridFileDimensions, netCDF::NcDim> const& entity_dimensions) : Network1D(nc_file, topology_variable, entity_attributes, entity_attribute_names, entity_dimensions, nc_file->getVars(), nc_file->getDims())
 {
-    // file variables and file dimensions
-    auto const file_variables = nc_file->getVars();
-    auto const file_dimensions = nc_file->getDims();
+}
 
+Network1D::Network1D(std::shared_ptr<netCDF::NcFile> nc_file,
+                     netCDF::NcVar const& topology_variable,
+                     std::map<std::string, std::vector<netCDF::NcVar>> const& entity_attributes,
+                     std::map<std::string, std::vector<std::string>> const& entity_attribute_names,
+                     std::map<UGridFileDimensions, netCDF::NcDim> const& entity_dimensions,
+                     std::multimap<std::string, netCDF::NcVar> const& file_variables,
+                     std::multimap<std::string, netCDF::NcDim> const& file_dimensions) : UGridEntity(nc_file, topology_variable, entity_attributes, entity_attribute_names, entity_dimensions)
+
+{
     // find the network geometry
     auto const entity_attribute_strings_iterator = entity_attribute_names.find("edge_geometry");
     if (entity_attribute_strings_iterator == entity_attribute_names.end())
@@ -238,8 +244,6 @@ void Network1D::define(ugridapi::Network1D const& network1d)
         m_network_geometry_attribute_variables.insert({"part_node_count", {m_related_variables.at("geom_part_node_count")}});
         m_network_geometry_attribute_variables.insert({"node_coordinates", {m_related_variables.at("geom_x"), m_related_variables.at("geom_y")}});
     }
-
-    m_nc_file->enddef();
 }
 
 void Network1D::put(ugridapi::Network1D const& network1d)
@@ -269,7 +273,7 @@ void Network1D::put(ugridapi::Network1D const& network1d)
 
     if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); network1d.edge_nodes != nullptr && it != m_topology_attribute_variables.end())
     {
-        it->second.at(0).putVar(network1d.edge_nodes);
+        put_indices(it->second.at(0), network1d.start_index, static_cast<size_t>(network1d.num_edges) * 2, network1d.edge_nodes);
     }
 
     if (auto const it = m_topology_attribute_variables.find("edge_length"); network1d.edge_length != nullptr && it != m_topology_attribute_variables.end())
@@ -342,9 +346,7 @@ void Network1D::get(ugridapi::Network1D& network1d) const
 
     if (auto const it = m_topology_attribute_variables.find("edge_node_connectivity"); network1d.edge_nodes != nullptr && it != m_topology_attribute_variables.end())
     {
-        const auto var = it->second.at(0);
-        var.getVar(network1d.edge_nodes);
-        apply_start_index_offset(var, network1d.start_index, network1d.num_edges * 2, network1d.edge_nodes);
+        get_indices(it->second.at(0), network1d.start_index, static_cast<size_t>(network1d.num_edges) * 2, network1d.edge_nodes);
     }
 
     if (auto const it = find_attribute_variable_name_with_aliases("node_id"); network1d.node_id != nullptr && it != m_topology_attribute_variables.end())
@@ -0,0 +1,178 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <UGrid/Parallel.hpp>
+#include <UGrid/SpaceFillingCurve.hpp>
+
+/// @brief The Hilbert curve as a state machine over the quadrant levels. The state is the orientation of the current sub-curve
+///        (bit 1: x and y swapped, bit 0: both complemented). Indexed by state << 2 | x bit << 1 | y bit, each entry holds
+///        the next state << 2 | the quadrant position along the curve. Replaces the data dependent branches of the orientation updates by a lookup
+static constexpr auto hilbert_states = []
+{
+    std::array<uint8_t, 16> states{};
+    for (uint32_t state = 0; state < 4; ++state)
+    {
+        for (uint32_t bits = 0; bits < 4; ++bits)
+        {
+            uint32_t const swapped = state >> 1;
+            uint32_t const complemented = state & 1;
+            uint32_t const rx = (swapped != 0 ? bits & 1 : bits >> 1) ^ complemented;
+            uint32_t const ry = (swapped != 0 ? bits >> 1 : bits & 1) ^ complemented;
+            uint32_t next_state = state;
+            if (ry == 0)
+            {
+                next_state ^= rx == 1 ? 3 : 2;
+            }
+            states[state << 2 | bits] = static_cast<uint8_t>(next_state << 2 | ((3 * rx) ^ ry));
+        }
+    }
+    return states;
+}();
+
+uint64_t ugrid::get_hilbert_index(uint32_t x, uint32_t y, unsigned order)
+{
+    // Descend the quadrants from the coarsest level, in the orientation of the sub-curve
+    uint64_t index = 0;
+    uint32_t state = 0;
+    for (auto level = order; level > 0; --level)
+    {
+        uint32_t const bits = ((x >> (level - 1)) & 1) << 1 | ((y >> (level - 1)) & 1);
+        uint32_t const entry = hilbert_states[state << 2 | bits];
+        index = index << 2 | (entry & 3);
+        state = entry >> 2;
+    }
+    return index;
+}
+
+ugrid::HilbertGrid ugrid::get_hilbert_grid(double const* x, double const* y, size_t num_points, size_t max_threads)
+{
+    HilbertGrid grid;
+    if (num_points == 0)
+    {
+        return grid;
+    }
+
+    // The bounding box, reduced per chunk of points
+    auto const num_chunks = get_num_threads(num_points, max_threads);
+    std::vector<double> chunk_min_x(num_chunks, std::numeric_limits<double>::max());
+    std::vector<double> chunk_max_x(num_chunks, std::numeric_limits<double>::lowest());
+    std::vector<double> chunk_min_y(num_chunks, std::numeric_limits<double>::max());
+    std::vector<double> chunk_max_y(num_chunks, std::numeric_limits<double>::lowest());
+    parallel_for_chunks(num_points, num_chunks, max_threads, [&](size_t chunk, size_t begin, size_t end)
+                        {
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                chunk_min_x[chunk] = std::min(chunk_min_x[chunk], x[i]);
+                                chunk_max_x[chunk] = std::max(chunk_max_x[chunk], x[i]);
+                                chunk_min_y[chunk] = std::min(chunk_min_y[chunk], y[i]);
+                                chunk_max_y[chunk] = std::max(chunk_max_y[chunk], y[i]);
+                            }
+                        });
+    auto const min_x = *std::min_element(chunk_min_x.begin(), chunk_min_x.end());
+    auto const max_x = *std::max_element(chunk_max_x.begin(), chunk_max_x.end());
+    auto const min_y = *std::min_element(chunk_min_y.begin(), chunk_min_y.end());
+    auto const max_y = *std::max_element(chunk_max_y.begin(), chunk_max_y.end());
+    if (!std::isfinite(min_x) || !std::isfinite(max_x) || !std::isfinite(min_y) || !std::isfinite(max_y))
+    {
+        throw std::invalid_argument("get_hilbert_grid: The coordinates must be finite.");
+    }
+
+    // Both axes share the scale, so the cells are square
+    auto const extent = std::max(max_x - min_x, max_y - min_y);
+    grid.min_x = min_x;
+    grid.min_y = min_y;
+    grid.scale = extent > 0.0 ? static_cast<double>(uint32_t{1} << hilbert_order) / extent : 0.0;
+    return grid;
+}
+
+std::vector<uint64_t> ugrid::compute_hilbert_indices(double const* x, double const* y, size_t num_points, HilbertGrid const& grid, size_t max_threads)
+{
+    std::vector<uint64_t> indices(num_points);
+    double const max_cell = static_cast<double>((uint32_t{1} << hilbert_order) - 1);
+    auto const to_cell = [max_cell, &grid](double value, double min)
+    {
+        return static_cast<uint32_t>(std::clamp((value - min) * grid.scale, 0.0, max_cell));
+    };
+
+    parallel_for_each_index(num_points, max_threads, [&](size_t i)
+                            {
+                                indices[i] = get_hilbert_index(to_cell(x[i], grid.min_x), to_cell(y[i], grid.min_y), hilbert_order);
+                            });
+    return indices;
+}
+
+std::vector<size_t> ugrid::sort_along_hilbert_curve(double const* x, double const* y, size_t num_points, HilbertGrid const& grid, size_t max_threads)
+{
+    auto const indices = compute_hilbert_indices(x, y, num_points, grid, max_threads);
+
+    // Pairing each index with its point makes all elements distinct, so the parallel sort is deterministic
+    std::vector<std::pair<uint64_t, size_t>> keyed_points(num_points);
+    for (size_t i = 0; i < num_points; ++i)
+    {
+        keyed_points[i] = {indices[i], i};
+    }
+    parallel_sort(keyed_points, max_threads);
+
+    std::vector<size_t> order(num_points);
+    std::transform(keyed_points.begin(), keyed_points.end(), order.begin(), [](auto const& keyed_point)
+                   { return keyed_point.second; });
+    return order;
+}
+
+std::vector<size_t> ugrid::sort_along_hilbert_curve(double const* x, double const* y, size_t num_points, size_t max_threads)
+{
+    return sort_along_hilbert_curve(x, y, num_points, get_hilbert_grid(x, y, num_points, max_threads), max_threads);
+}
+
+std::vector<int> ugrid::partition_along_hilbert_curve(double const* x, double const* y, size_t num_points, size_t num_domains, size_t max_threads)
+{
+    if (num_domains == 0 || num_domains > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::invalid_argument("partition_along_hilbert_curve: The number of domains must be positive and in the int range.");
+    }
+
+    // Domain d takes the points [d * num_points / num_domains, (d + 1) * num_points / num_domains) along the curve,
+    // so the domain sizes differ by at most one
+    auto const order = sort_along_hilbert_curve(x, y, num_points, max_threads);
+    std::vector<int> domains(num_points);
+    parallel_for(num_domains, max_threads, [&](size_t domain)
+                 {
+                     auto const end = (domain + 1) * num_points / num_domains;
+                     for (auto i = domain * num_points / num_domains; i < end; ++i)
+                     {
+                         domains[order[i]] = static_cast<int>(domain);
+                     }
+                 });
+    return domains;
+}
@@ -0,0 +1,63 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <UGrid/TopologyScanner.hpp>
+
+using ugrid::TopologyScanner;
+
+TopologyScanner::TopologyScanner(std::shared_ptr<netCDF::NcFile> const& nc_file)
+    : m_nc_file(nc_file),
+      m_file_variables(nc_file->getVars()),
+      m_file_dimensions(nc_file->getDims())
+{
+    for (auto const& [name, variable] : m_file_variables)
+    {
+        // The attributes of each variable are read once and tested against all entity types
+        auto const attributes = variable.getAtts();
+        if (attributes.find("cf_role") == attributes.end())
+        {
+            continue;
+        }
+
+        if (is_topology_variable_of_type<Mesh1D>(attributes))
+        {
+            m_mesh1d_variables.emplace_back(variable);
+        }
+        if (is_topology_variable_of_type<Mesh2D>(attributes))
+        {
+            m_mesh2d_variables.emplace_back(variable);
+        }
+        if (is_topology_variable_of_type<Network1D>(attributes))
+        {
+            m_network1d_variables.emplace_back(variable);
+        }
+        if (is_topology_variable_of_type<Contacts>(attributes))
+        {
+            m_contacts_variables.emplace_back(variable);
+        }
+    }
+}
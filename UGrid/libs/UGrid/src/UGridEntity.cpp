@@ -28,6 +28,7 @@
 #include <format>
 
 #include <UGrid/Constants.hpp>
+#include <UGrid/IndexOffset.hpp>
 #include <UGrid/Operations.hpp>
 #include <UGrid/UGridEntity.hpp>
 #include <UGrid/UGridVarAttributeStringBuilder.hpp>
@@ -52,6 +53,104 @@ UGridEntity::UGridEntity(
       m_dimensions(dimensions)
 {
     m_entity_name = m_topology_variable.getName();
+    read_index_conventions();
+}
+
+void UGridEntity::read_index_conventions()
+{
+    static std::vector<std::string> const index_attribute_names{"edge_node_connectivity",
+                                                                "edge_face_connectivity",
+                                                                "face_node_connectivity",
+                                                                "face_edge_connectivity",
+                                                                "face_face_connectivity"};
+
+    for (auto const& attribute_name : index_attribute_names)
+    {
+        auto const it = m_topology_attribute_variables.find(attribute_name);
+        if (it == m_topology_attribute_variables.end())
+        {
+            continue;
+        }
+        for (auto const& variable : it->second)
+        {
+            auto const attributes = variable.getAtts();
+            auto const start_index_it = attributes.find("start_index");
+            if (start_index_it == attributes.end())
+            {
+                continue;
+            }
+
+            IndexConvention convention;
+            start_index_it->second.getValues(&convention.start_index);
+            if (auto const fill_value_it = attributes.find("_FillValue"); fill_value_it != attributes.end())
+            {
+                fill_value_it->second.getValues(&convention.fill_value);
+            }
+            m_index_conventions.insert_or_assign(variable.getId(), convention);
+        }
+    }
+}
+
+int UGridEntity::get_index_offset(netCDF::NcVar const& var, int start_index, int& fill_value) const
+{
+    auto const it = m_index_conventions.find(var.getId());
+    if (it == m_index_conventions.end())
+    {
+        fill_value = m_int_fill_value;
+        return 0;
+    }
+    fill_value = it->second.fill_value;
+    return start_index - it->second.start_index;
+}
+
+void UGridEntity::get_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int* values) const
+{
+    var.getVar(values);
+
+    int fill_value = 0;
+    auto const offset = get_index_offset(var, start_index, fill_value);
+    add_index_offset(offset, fill_value, values_size, values);
+}
+
+void UGridEntity::put_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int const* values) const
+{
+    int fill_value = 0;
+    auto const offset = get_index_offset(var, start_index, fill_value);
+    if (offset == 0)
+    {
+        var.putVar(values);
+        return;
+    }
+
+    // The caller's array is left unchanged
+    std::vector<int> converted(values, values + values_size);
+    add_index_offset(-offset, fill_value, values_size, converted.data());
+    var.putVar(converted.data());
+}
+
+void UGridEntity::get_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int64_t* values) const
+{
+    var.getVar(values);
+
+    int fill_value = 0;
+    auto const offset = get_index_offset(var, start_index, fill_value);
+    add_index_offset(int64_t{offset}, int64_t{fill_value}, values_size, values);
+}
+
+void UGridEntity::put_indices(netCDF::NcVar const& var, int start_index, size_t values_size, int64_t const* values) const
+{
+    int fill_value = 0;
+    auto const offset = get_index_offset(var, start_index, fill_value);
+    if (offset == 0)
+    {
+        var.putVar(values);
+        return;
+    }
+
+    // The caller's array is left unchanged
+    std::vector<int64_t> converted(values, values + values_size);
+    add_index_offset(-int64_t{offset}, int64_t{fill_value}, values_size, converted.data());
+    var.putVar(converted.data());
 }
 
 bool UGridEntity::is_topology_variable(std::map<std::string, netCDF::NcVarAtt> const& attributes)
@@ -358,6 +457,7 @@ void UGridEntity::define_topological_variable(std::string const& topology_attrib
 
     // create topology variable
     auto const topology_attribute_variable = m_nc_file->addVar(string_builder.str(), nc_type, dimensions);
+    apply_registered_variable_storage(topology_attribute_variable);
 
     // create the attributes
     for (auto const& attribute : attributes)
@@ -369,14 +469,29 @@ void UGridEntity::define_topological_variable(std::string const& topology_attrib
     if (add_start_index)
     {
         topology_attribute_variable.putAtt("start_index", netCDF::NcType::nc_INT, m_start_index);
+
+        IndexConvention convention;
+        convention.start_index = m_start_index;
+        convention.fill_value = m_int_fill_value;
+        m_index_conventions.insert_or_assign(topology_attribute_variable.getId(), convention);
     }
 
     // add fill value
     if (add_fill_value)
     {
-        nc_type == netCDF::NcType::nc_DOUBLE
-            ? topology_attribute_variable.setFill(true, m_double_fill_value)
-            : topology_attribute_variable.setFill(true, m_int_fill_value);
+        // The fill value must have the type of the variable
+        if (nc_type == netCDF::NcType::nc_DOUBLE)
+        {
+            topology_attribute_variable.setFill(true, m_double_fill_value);
+        }
+        else if (nc_type == netCDF::NcType::nc_INT64)
+        {
+            topology_attribute_variable.setFill(true, static_cast<long long>(m_int_fill_value));
+        }
+        else
+        {
+            topology_attribute_variable.setFill(true, m_int_fill_value);
+        }
     }
 
     // find if an attribute variable_suffix is already stored, otherwise fill it
@@ -407,6 +522,7 @@ void UGridEntity::define_topology_related_variables(std::string const& variable,
     }
 
     const auto topology_related_variable = m_nc_file->addVar(string_builder.str(), nc_type, dimensions);
+    apply_registered_variable_storage(topology_related_variable);
 
     for (auto const& attribute : attributes)
     {
@@ -423,6 +539,16 @@ void UGridEntity::define_topology_related_variables(std::string const& variable,
     m_related_variables.insert({variable, {topology_related_variable}});
 }
 
+void UGridEntity::apply_registered_variable_storage(netCDF::NcVar const& variable) const
+{
+    auto const it = m_variable_storage.find(variable.getName());
+    if (it == m_variable_storage.end())
+    {
+        return;
+    }
+    apply_variable_storage(variable, it->second);
+}
+
 void UGridEntity::define(char const* const entity_name,
                          int start_index,
                          std::string const& long_name,
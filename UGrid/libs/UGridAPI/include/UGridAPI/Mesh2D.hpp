@@ -29,6 +29,8 @@
 
 #include <UGrid/Constants.hpp>
 
+#include <cstdint>
+
 namespace ugridapi
 {
     /// @brief A struct used to describe UGrid mesh2d in a C-compatible manner
@@ -91,13 +93,13 @@ namespace ugridapi
         /// @brief The z coordinates of a layer interface
         double* interface_zs = nullptr;
 
-        /// @brief The number of node
+        /// @brief The number of node, -1 to use num_nodes_long
         int num_nodes = 0;
 
-        /// @brief The number of edge
+        /// @brief The number of edge, -1 to use num_edges_long
         int num_edges = 0;
 
-        /// @brief The number of face
+        /// @brief The number of face, -1 to use num_faces_long
         int num_faces = 0;
 
         /// @brief The number of layers
@@ -120,5 +122,32 @@ namespace ugridapi
 
         /// @brief The fill value for array of integers
         int int_fill_value = ugrid::int_missing_value;
+
+        /// @brief The edge node connectivity, 64-bit. Used instead of edge_nodes if set
+        int64_t* edge_nodes_long = nullptr;
+
+        /// @brief The node composing each face, 64-bit. Used instead of face_nodes if set
+        int64_t* face_nodes_long = nullptr;
+
+        /// @brief The edge composing each face, 64-bit. Used instead of edge_faces if set
+        int64_t* edge_faces_long = nullptr;
+
+        /// @brief For each face, the edge composing it, 64-bit. Used instead of face_edges if set
+        int64_t* face_edges_long = nullptr;
+
+        /// @brief For each face, the neighboring face, 64-bit. Used instead of face_faces if set
+        int64_t* face_faces_long = nullptr;
+
+        /// @brief The number of node, 64-bit. Only used when num_nodes is negative. Set on inquire, where num_nodes is set to -1 if the count exceeds the int range
+        int64_t num_nodes_long = 0;
+
+        /// @brief The number of edge, 64-bit. Only used when num_edges is negative. Set on inquire, where num_edges is set to -1 if the count exceeds the int range
+        int64_t num_edges_long = 0;
+
+        /// @brief The number of face, 64-bit. Only used when num_faces is negative. Set on inquire, where num_faces is set to -1 if the count exceeds the int range
+        int64_t num_faces_long = 0;
+
+        /// @brief 1 to store the connectivity variables as 64-bit integers (requires the netCDF-4 format), 0 otherwise
+        int connectivity_int64 = 0;
     };
 } // namespace ugridapi
@@ -0,0 +1,49 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#ifndef UGRID_API
+#ifdef _WIN32
+#define UGRID_API __declspec(dllexport)
+#else
+#define UGRID_API __attribute__((visibility("default")))
+#endif
+#endif
+
+namespace ugridapi
+{
+
+    /// @brief The face connectivities of a mesh2d available in the ragged layout
+    enum Mesh2DConnectivity
+    {
+        FaceNodes = 0, ///< The nodes of each face (face_node_connectivity)
+        FaceEdges = 1, ///< The edges of each face (face_edge_connectivity)
+        FaceFaces = 2, ///< The neighbouring faces of each face (face_face_connectivity)
+    };
+
+} // namespace ugridapi
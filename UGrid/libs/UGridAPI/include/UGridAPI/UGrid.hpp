@@ -38,8 +38,10 @@
 #include <UGridAPI/Contacts.hpp>
 #include <UGridAPI/Mesh1D.hpp>
 #include <UGridAPI/Mesh2D.hpp>
+#include <UGridAPI/Mesh2DConnectivity.hpp>
 #include <UGridAPI/MeshLocations.hpp>
 #include <UGridAPI/Network1D.hpp>
+#include <UGridAPI/VariableReadRequest.hpp>
 
 /// \namespace ugridapi
 /// @brief Contains all structs and functions exposed at the API level
@@ -74,7 +76,7 @@ namespace ugridapi
         };
 
         /// @brief Gets pointer to the exception message.
-        /// @param[out] error_message The pointer to the latest error message
+        /// @param[out] error_message The pointer to the latest error message raised on the calling thread
         /// @returns Error code
         UGRID_API int ug_error_get(char* error_message);
 
@@ -139,6 +141,23 @@ namespace ugridapi
                                                                      const char* dimension_name,
                                                                      const int dimension_value);
 
+        /// @brief Defines a double variable on a topology with a leading unlimited (record) dimension.
+        ///        Records are written one at a time with \ref ug_variable_append_data_double, so the number of time steps
+        ///        does not need to be known in advance.
+        /// @param[in] file_id The file id
+        /// @param[in] topology_type The topology type
+        /// @param[in] topology_id The topology id
+        /// @param[in] location The location on the topology (e.g. node, edge or face)
+        /// @param[in] variable_name The variable name
+        /// @param[in] record_dimension_name The name of the unlimited dimension (e.g "time"), shared by all variables using it
+        /// @return Error code
+        UGRID_API int ug_topology_define_double_record_variable_on_location(int file_id,
+                                                                            TopologyType topology_type,
+                                                                            int topology_id,
+                                                                            MeshLocations location,
+                                                                            const char* variable_name,
+                                                                            const char* record_dimension_name);
+
         /// @brief Defines a double geometry variable on a topology with a named dimension.
         ///        Use this function when the variable itself describes the spatial geometry of the
         ///        topology element, as opposed to \ref ug_topology_define_double_variable_on_location
@@ -202,6 +221,13 @@ namespace ugridapi
         /// @return Error code
         UGRID_API int ug_variable_get_data_dimensions(int file_id, const char* variable_name, int* dimension_vec);
 
+        /// @brief Get the dimension values of a specific variable as 64-bit sizes, for dimensions exceeding the int range
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[out] dimension_vec The dimension values associated with the variable name
+        /// @return Error code
+        UGRID_API int ug_variable_get_data_dimensions_long(int file_id, const char* variable_name, int64_t* dimension_vec);
+
         /// @brief Get the variable data as a flat array of doubles. This might be large, because the arrays can have a large dimensionality
         /// @param[in] file_id The file id
         /// @param[in] variable_name The variable name
@@ -244,6 +270,82 @@ namespace ugridapi
         /// @return Error code
         UGRID_API int ug_variable_put_data_char(int file_id, const char* variable_name, char const* data);
 
+        /// @brief Get a hyperslab of the variable data as a flat array of double. Only the selected values are read from the file
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[in] start The start index along each dimension of the variable
+        /// @param[in] count The number of values along each dimension of the variable
+        /// @param[in] stride The sampling interval along each dimension of the variable, or nullptr for a contiguous selection
+        /// @param[out] data The selected data, sized to the product of count
+        /// @return Error code
+        UGRID_API int ug_variable_get_data_double_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, double* data);
+
+        /// @brief Get a hyperslab of the variable data as a flat array of int. Only the selected values are read from the file
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[in] start The start index along each dimension of the variable
+        /// @param[in] count The number of values along each dimension of the variable
+        /// @param[in] stride The sampling interval along each dimension of the variable, or nullptr for a contiguous selection
+        /// @param[out] data The selected data, sized to the product of count
+        /// @return Error code
+        UGRID_API int ug_variable_get_data_int_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, int* data);
+
+        /// @brief Get a hyperslab of the variable data as a flat array of char. Only the selected values are read from the file
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[in] start The start index along each dimension of the variable
+        /// @param[in] count The number of values along each dimension of the variable
+        /// @param[in] stride The sampling interval along each dimension of the variable, or nullptr for a contiguous selection
+        /// @param[out] data The selected data, sized to the product of count
+        /// @return Error code
+        UGRID_API int ug_variable_get_data_char_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, char* data);
+
+        /// @brief Put a hyperslab of the variable data from a flat array of double. Only the selected values are written to the file
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[in] start The start index along each dimension of the variable
+        /// @param[in] count The number of values along each dimension of the variable
+        /// @param[in] stride The sampling interval along each dimension of the variable, or nullptr for a contiguous selection
+        /// @param[in] data The data to write, sized to the product of count
+        /// @return Error code
+        UGRID_API int ug_variable_put_data_double_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, double const* data);
+
+        /// @brief Put a hyperslab of the variable data from a flat array of int. Only the selected values are written to the file
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[in] start The start index along each dimension of the variable
+        /// @param[in] count The number of values along each dimension of the variable
+        /// @param[in] stride The sampling interval along each dimension of the variable, or nullptr for a contiguous selection
+        /// @param[in] data The data to write, sized to the product of count
+        /// @return Error code
+        UGRID_API int ug_variable_put_data_int_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, int const* data);
+
+        /// @brief Put a hyperslab of the variable data from a flat array of char. Only the selected values are written to the file
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[in] start The start index along each dimension of the variable
+        /// @param[in] count The number of values along each dimension of the variable
+        /// @param[in] stride The sampling interval along each dimension of the variable, or nullptr for a contiguous selection
+        /// @param[in] data The data to write, sized to the product of count
+        /// @return Error code
+        UGRID_API int ug_variable_put_data_char_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, char const* data);
+
+        /// @brief Reads several data variables, possibly from several files, in one call.
+        ///        Requests on the same file are read in sequence, requests on different files are read concurrently on a pool of threads.
+        /// @param[in,out] requests The read requests, the status of each request is set on return
+        /// @param[in] num_requests The number of requests
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @return Error code, \ref Exception if any of the requests failed
+        UGRID_API int ug_variable_get_data_double_batch(VariableReadRequest* requests, int num_requests, int num_threads);
+
+        /// @brief Appends one record to a variable defined on an unlimited dimension, without rewriting previous records
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The variable name
+        /// @param[in] data The values of one record (e.g. one time step of all faces, edges or nodes)
+        /// @param[out] record_index The index of the written record
+        /// @return Error code
+        UGRID_API int ug_variable_append_data_double(int file_id, const char* variable_name, double const* data, int& record_index);
+
         /// @brief Inquires if a variable exists
         /// @param[in] file_id The file id
         /// @param[in] variable_name The variable name
@@ -266,18 +368,85 @@ namespace ugridapi
         /// @return Error code
         UGRID_API int ug_file_replace_mode(int& mode) noexcept;
 
-        /// @brief Opens a file and fills the library state
+        /// @brief Gets the integer identifying the classic file format
+        /// @param[out] format The integer identifying the classic file format
+        /// @return Error code
+        UGRID_API int ug_file_classic_format(int& format);
+
+        /// @brief Gets the integer identifying the NetCDF-4 (HDF5) file format, which supports chunking and compression
+        /// @param[out] format The integer identifying the NetCDF-4 file format
+        /// @return Error code
+        UGRID_API int ug_file_netcdf4_format(int& format);
+
+        /// @brief Opens a file and fills the library state. New files are created in the classic format
         /// @param[in] file_path  The path of the file
         /// @param[in] mode The opening mode
         /// @param[out] file_id The file id
         /// @return Error code
         UGRID_API int ug_file_open(const char* file_path, int mode, int& file_id);
 
+        /// @brief Opens a file and fills the library state, creating new files in the given format
+        /// @param[in] file_path  The path of the file
+        /// @param[in] mode The opening mode
+        /// @param[in] format The format of newly created files (\ref ug_file_classic_format or \ref ug_file_netcdf4_format)
+        /// @param[out] file_id The file id
+        /// @return Error code
+        UGRID_API int ug_file_open_with_format(const char* file_path, int mode, int format, int& file_id);
+
+        /// @brief Opens a file without reading its topologies. Each topology type is read on the first call that needs it
+        ///        (e.g. \ref ug_topology_get_count, \ref ug_mesh2d_inq), which makes opening a file to read data variables cheap
+        /// @param[in] file_path  The path of the file
+        /// @param[in] mode The opening mode
+        /// @param[out] file_id The file id
+        /// @return Error code
+        UGRID_API int ug_file_open_deferred(const char* file_path, int mode, int& file_id);
+
+        /// @brief Opens a classic format file for reading and maps it into memory, so \ref ug_mesh2d_get_mapped can serve the mesh arrays
+        ///        as views into the mapping instead of copying them. Topologies are discovered on first use, as with \ref ug_file_open_deferred.
+        ///        Reopening a file whose pages are in the operating system cache therefore costs little more than parsing its header
+        /// @param[in] file_path The path of the file, in a classic format (not NetCDF-4)
+        /// @param[out] file_id The file id
+        /// @return Error code
+        UGRID_API int ug_file_open_mapped(const char* file_path, int& file_id);
+
+        /// @brief Opens a file held entirely in memory. Created files are only written to disk on \ref ug_file_close, with one sequential
+        ///        write, and existing files are read with one sequential read. This avoids many small I/O operations on network file systems
+        /// @param[in] file_path The path the file is read from and, unless opened for reading, written to on close
+        /// @param[in] mode The opening mode
+        /// @param[in] format The format of newly created files (\ref ug_file_classic_format or \ref ug_file_netcdf4_format)
+        /// @param[out] file_id The file id
+        /// @return Error code
+        UGRID_API int ug_file_open_diskless(const char* file_path, int mode, int format, int& file_id);
+
+        /// @brief Opens a file for reading from a memory buffer holding its contents, e.g. received over a network, without a temporary file
+        /// @param[in] name The name of the dataset, only used in error messages
+        /// @param[in] buffer The file contents, which are not copied and must stay valid and unchanged until \ref ug_file_close
+        /// @param[in] buffer_size The size of the buffer in bytes
+        /// @param[out] file_id The file id
+        /// @return Error code
+        UGRID_API int ug_file_open_memory(const char* name, const char* buffer, int64_t buffer_size, int& file_id);
+
         /// @brief Closes a file
         /// @param[in] file_id The file id
         /// @return Error code
         UGRID_API int ug_file_close(int file_id);
 
+        /// @brief Opens a define batch. Topologies, variables and attributes defined until \ref ug_file_commit_define
+        ///        share one define phase, so the header is laid out once. Writing data is rejected while the batch is open
+        /// @param[in] file_id The file id
+        /// @return Error code
+        UGRID_API int ug_file_begin_define(int file_id);
+
+        /// @brief Closes the define batch, reserving free space in the header so that later definitions do not move the data
+        ///        (classic formats only, see nc__enddef). The padding is also applied by later topology definitions
+        /// @param[in] file_id The file id
+        /// @param[in] header_free_space The number of bytes reserved at the end of the header
+        /// @param[in] variable_alignment The alignment in bytes of the start of the fixed-size variables
+        /// @param[in] variable_free_space The number of bytes reserved after the fixed-size variables
+        /// @param[in] record_alignment The alignment in bytes of the start of the record variables
+        /// @return Error code
+        UGRID_API int ug_file_commit_define(int file_id, int header_free_space, int variable_alignment, int variable_free_space, int record_alignment);
+
         /// @brief Defines a new network1d topology
         /// @param[in] file_id The file id
         /// @param[in] network1d_api The structure containing the network data
@@ -362,6 +531,237 @@ namespace ugridapi
         /// @return Error code
         UGRID_API int ug_mesh2d_get(int file_id, int topology_id, Mesh2D& mesh2d_api);
 
+        /// @brief Gets mesh2d geometrical data as read-only views into a file opened with \ref ug_file_open_mapped, without copying.
+        ///        Every array pointer of the structure is set, to nullptr for arrays the file does not store. The views stay valid until the file is closed.
+        ///        The connectivity is converted in place to mesh2d_api.start_index; the views of the same variable share memory,
+        ///        so getting the mesh again with another start index converts the earlier views as well. Values must not be written
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[in,out] mesh2d_api The structure with the start index, where to assign the views
+        /// @return Error code
+        UGRID_API int ug_mesh2d_get_mapped(int file_id, int topology_id, Mesh2D& mesh2d_api);
+
+        /// @brief Derives the edge_nodes, edge_faces, face_edges and face_faces connectivity of a mesh2d from its face nodes, in parallel.
+        ///        Afterwards, \ref ug_mesh2d_inq and \ref ug_mesh2d_get return the derived connectivity where the file lacks it.
+        ///        64-bit face nodes in the file are read as int indices: a mesh with more faces or edges than the int range is rejected
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @return Error code
+        UGRID_API int ug_mesh2d_derive_connectivity(int file_id, int topology_id, int num_threads);
+
+        /// @brief Builds the faces around each node of a mesh2d in compressed row (CSR) format, from the face nodes of the api structure.
+        ///        Uses num_nodes, num_faces, num_face_nodes_max, face_nodes, start_index and int_fill_value, e.g. as filled by \ref ug_mesh2d_get.
+        ///        The 64-bit counts and face_nodes_long are used as in \ref ug_mesh2d_def. The output is int, so the 64-bit face nodes are
+        ///        narrowed and the function fails if an index, the number of faces or the number of face nodes exceeds the int range
+        /// @param[in] mesh2d_api The mesh2d api structure
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @param[out] node_face_offsets The offsets of the faces of each node, sized to num_nodes + 1
+        /// @param[out] node_faces The faces of each node in ascending order, sized to the number of face nodes that are not fill values
+        ///             (at most num_faces * num_face_nodes_max). The face indices use the start index of the mesh
+        /// @return Error code
+        UGRID_API int ug_mesh2d_build_node_faces(Mesh2D const& mesh2d_api, int num_threads, int* node_face_offsets, int* node_faces);
+
+        /// @brief Builds the edges around each node of a mesh2d in compressed row (CSR) format, from the edge nodes of the api structure.
+        ///        Uses num_nodes, num_edges, edge_nodes and start_index, e.g. as filled by \ref ug_mesh2d_get.
+        ///        The 64-bit counts and edge_nodes_long are used as in \ref ug_mesh2d_def. The output is int, so the 64-bit edge nodes are
+        ///        narrowed and the function fails if an index or 2 * num_edges exceeds the int range
+        /// @param[in] mesh2d_api The mesh2d api structure
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @param[out] node_edge_offsets The offsets of the edges of each node, sized to num_nodes + 1
+        /// @param[out] node_edges The edges of each node in ascending order, sized to 2 * num_edges. The edge indices use the start index of the mesh
+        /// @return Error code
+        UGRID_API int ug_mesh2d_build_node_edges(Mesh2D const& mesh2d_api, int num_threads, int* node_edge_offsets, int* node_edges);
+
+        /// @brief Extracts the faces of a mesh2d lying inside a bounding box to a new file, with their nodes, edges and data variables.
+        ///        A face is extracted when all its nodes lie inside the box. The nodes and edges of the extracted faces are renumbered from 0,
+        ///        and the data variables defined on nodes, edges and faces are copied for the extracted entities, with their attributes
+        ///        and their other dimensions. The new file has the format of the input file and the header padding set by \ref ug_file_commit_define
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[in] min_x The minimum x coordinate of the box
+        /// @param[in] min_y The minimum y coordinate of the box
+        /// @param[in] max_x The maximum x coordinate of the box
+        /// @param[in] max_y The maximum y coordinate of the box
+        /// @param[in] output_file_path The path of the new file, replaced if it exists
+        /// @param[out] num_faces The number of extracted faces
+        /// @return Error code
+        UGRID_API int ug_mesh2d_extract_bounding_box(int file_id,
+                                                     int topology_id,
+                                                     double min_x,
+                                                     double min_y,
+                                                     double max_x,
+                                                     double max_y,
+                                                     const char* output_file_path,
+                                                     int& num_faces);
+
+        /// @brief Extracts the faces of a mesh2d lying inside a polygon to a new file, as \ref ug_mesh2d_extract_bounding_box
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[in] num_polygon_nodes The number of polygon nodes, at least 3. The polygon is closed implicitly
+        /// @param[in] polygon_x The x coordinates of the polygon nodes
+        /// @param[in] polygon_y The y coordinates of the polygon nodes
+        /// @param[in] output_file_path The path of the new file, replaced if it exists
+        /// @param[out] num_faces The number of extracted faces
+        /// @return Error code
+        UGRID_API int ug_mesh2d_extract_polygon(int file_id,
+                                                int topology_id,
+                                                int num_polygon_nodes,
+                                                double const* polygon_x,
+                                                double const* polygon_y,
+                                                const char* output_file_path,
+                                                int& num_faces);
+
+        /// @brief Partitions the faces of a mesh2d into domains of (nearly) equal size, by cutting the Hilbert space-filling curve through
+        ///        the face centres into contiguous pieces. Uses num_nodes, node_x, node_y, num_faces, num_face_nodes_max, face_nodes,
+        ///        start_index and int_fill_value, e.g. as filled by \ref ug_mesh2d_get
+        /// @param[in] mesh2d_api The mesh2d api structure
+        /// @param[in] num_domains The number of domains, at least 1
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @param[out] face_domains The 0-based domain of each face, sized to num_faces
+        /// @return Error code
+        UGRID_API int ug_mesh2d_partition_faces(Mesh2D const& mesh2d_api, int num_domains, int num_threads, int* face_domains);
+
+        /// @brief Writes one file per domain of a partitioned mesh2d, named output_file_prefix_0000.nc, output_file_prefix_0001.nc, ...
+        ///        Each file holds the faces of its domain and layers of ghost faces around them (grown across the face edges),
+        ///        the nodes and edges of these faces and the data variables defined on them, in the format and with the header padding of the input file.
+        ///        Each file also gets the variables <mesh>_node_global_number, <mesh>_edge_global_number and <mesh>_face_global_number
+        ///        with the 1-based numbers of its entities in the input mesh, and <mesh>_face_domain_number with the 0-based domain owning each face
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[in] num_domains The number of domains, at least 1, every domain must own a face
+        /// @param[in] num_ghost_layers The number of ghost face layers
+        /// @param[in] face_domains The 0-based domain of each face, or nullptr to partition as \ref ug_mesh2d_partition_faces
+        /// @param[in] output_file_prefix The path of the domain files without the domain number and extension
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @return Error code
+        UGRID_API int ug_mesh2d_write_partitions(int file_id,
+                                                 int topology_id,
+                                                 int num_domains,
+                                                 int num_ghost_layers,
+                                                 int const* face_domains,
+                                                 const char* output_file_prefix,
+                                                 int num_threads);
+
+        /// @brief Merges the domain files of a partitioned mesh2d, named input_file_prefix_0000input_file_suffix, input_file_prefix_0001input_file_suffix, ...
+        ///        into one file with the merged mesh2d and the data variables on its nodes, edges and faces, in the format of the first domain file.
+        ///        Nodes, edges and faces are merged by the global number variables written by \ref ug_mesh2d_write_partitions when present,
+        ///        nodes by coordinates otherwise. Faces owned by another domain according to <mesh>_face_domain_number are dropped as ghost faces.
+        ///        The data variables are streamed one time step (more generally, one index of the dimensions preceding the location dimension) at a time
+        /// @param[in] input_file_prefix The path of the domain files up to the domain number
+        /// @param[in] input_file_suffix The rest of the path of the domain files after the domain number, e.g. ".nc" or "_map.nc"
+        /// @param[in] num_domains The number of domains, at least 1
+        /// @param[in] topology_id The mesh2d topology id within the domain files
+        /// @param[in] tolerance The distance within which nodes are merged when the domain files have no global node numbers
+        /// @param[in] output_file_path The path of the merged file, replaced if it exists
+        /// @param[in] num_threads The maximum number of threads reading domain files, 0 to use the hardware concurrency.
+        ///            Domain files are read one at a time unless the netCDF library is thread-safe and the files are classic
+        /// @param[out] num_faces The number of merged faces
+        /// @return Error code
+        UGRID_API int ug_mesh2d_merge_partitions(const char* input_file_prefix,
+                                                 const char* input_file_suffix,
+                                                 int num_domains,
+                                                 int topology_id,
+                                                 double tolerance,
+                                                 const char* output_file_path,
+                                                 int num_threads,
+                                                 int& num_faces);
+
+        /// @brief Renumbers the nodes, edges and faces of a mesh2d in place along a Hilbert space-filling curve, so that entities close in space
+        ///        get close indices and gathers through the connectivity (e.g. face to node) touch nearby memory. Nodes are ordered by their coordinates,
+        ///        edges by their midpoints and faces by the mean of their nodes. All coordinate and connectivity arrays set in the api structure,
+        ///        32-bit or 64-bit, are reordered consistently. Write the renumbered mesh with \ref ug_mesh2d_def and \ref ug_mesh2d_put,
+        ///        and reorder its data with \ref ug_mesh2d_permute_data_double
+        /// @param[in,out] mesh2d_api The mesh2d api structure, node_x and node_y are required
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @param[out] node_permutation For each new node, the index of the node it was (using start_index), sized to num_nodes, or nullptr
+        /// @param[out] edge_permutation For each new edge, the index of the edge it was (using start_index), sized to num_edges, or nullptr
+        /// @param[out] face_permutation For each new face, the index of the face it was (using start_index), sized to num_faces, or nullptr
+        /// @return Error code
+        UGRID_API int ug_mesh2d_renumber_hilbert(Mesh2D& mesh2d_api,
+                                                 int num_threads,
+                                                 int* node_permutation,
+                                                 int* edge_permutation,
+                                                 int* face_permutation);
+
+        /// @brief Reorders the values of a data variable in place after its mesh was renumbered by \ref ug_mesh2d_renumber_hilbert
+        /// @param[in] permutation For each new entity, the index of the entity it was
+        /// @param[in] num_entities The number of entities
+        /// @param[in] num_values_per_entity The number of consecutive values of each entity (e.g. num_face_nodes_max for face bounds)
+        /// @param[in] start_index The start index of the permutation
+        /// @param[in,out] values The values, num_entities * num_values_per_entity of them
+        /// @return Error code
+        UGRID_API int ug_mesh2d_permute_data_double(int const* permutation,
+                                                    int num_entities,
+                                                    int num_values_per_entity,
+                                                    int start_index,
+                                                    double* values);
+
+        /// @brief Creates a face locator, a bucket grid over the faces of a mesh2d to locate the faces containing points.
+        ///        Uses num_nodes, node_x, node_y, num_faces, num_face_nodes_max, face_nodes, start_index, int_fill_value and is_spherical,
+        ///        e.g. as filled by \ref ug_mesh2d_get. The 64-bit counts and face_nodes_long are used as in \ref ug_mesh2d_def, the face nodes
+        ///        are narrowed to int and the function fails if an index or the number of faces exceeds the int range.
+        ///        The arrays are copied, so they can be released afterwards
+        /// @param[in] mesh2d_api The mesh2d api structure
+        /// @param[in] num_threads The maximum number of threads used to build the locator, 0 to use the hardware concurrency
+        /// @param[out] locator_id The id of the created locator
+        /// @return Error code
+        UGRID_API int ug_face_locator_create(Mesh2D const& mesh2d_api, int num_threads, int& locator_id);
+
+        /// @brief Locates the faces containing a batch of points
+        /// @param[in] locator_id The locator id
+        /// @param[in] num_points The number of points
+        /// @param[in] x The point x coordinates (longitudes in a spherical system, in any range)
+        /// @param[in] y The point y coordinates
+        /// @param[in] num_threads The maximum number of threads, 0 to use the hardware concurrency
+        /// @param[out] faces The face containing each point, with the start index of the mesh, or the fill value outside the mesh
+        /// @return Error code
+        UGRID_API int ug_face_locator_find_faces(int locator_id, int num_points, double const* x, double const* y, int num_threads, int* faces);
+
+        /// @brief Destroys a face locator
+        /// @param[in] locator_id The locator id
+        /// @return Error code
+        UGRID_API int ug_face_locator_destroy(int locator_id);
+
+        /// @brief Gets the face offsets of the ragged (compressed row) face connectivity of a mesh2d.
+        ///        The entries of face f are stored from face_offsets[f] to face_offsets[f + 1] - 1, without padding
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[out] face_offsets The face offsets, sized to the number of faces + 1. The last entry is the number of entries
+        /// @return Error code
+        UGRID_API int ug_mesh2d_get_face_offsets(int file_id, int topology_id, int* face_offsets);
+
+        /// @brief Gets a face connectivity of a mesh2d in the ragged layout, converting from the padded file layout block by block
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[in] connectivity The face connectivity
+        /// @param[in] start_index The start index of the returned indices
+        /// @param[in] face_offsets The face offsets, as returned by \ref ug_mesh2d_get_face_offsets
+        /// @param[out] indices The flat indices, sized to face_offsets[num_faces]
+        /// @return Error code
+        UGRID_API int ug_mesh2d_get_face_connectivity_ragged(int file_id,
+                                                             int topology_id,
+                                                             Mesh2DConnectivity connectivity,
+                                                             int start_index,
+                                                             int const* face_offsets,
+                                                             int* indices);
+
+        /// @brief Puts a face connectivity of a mesh2d given in the ragged layout, padding it to the file layout block by block.
+        ///        The connectivity must have been defined with \ref ug_mesh2d_def
+        /// @param[in] file_id The file id
+        /// @param[in] topology_id The topology id
+        /// @param[in] connectivity The face connectivity
+        /// @param[in] start_index The start index of the indices
+        /// @param[in] face_offsets The face offsets, sized to the number of faces + 1
+        /// @param[in] indices The flat indices
+        /// @return Error code
+        UGRID_API int ug_mesh2d_put_face_connectivity_ragged(int file_id,
+                                                             int topology_id,
+                                                             Mesh2DConnectivity connectivity,
+                                                             int start_index,
+                                                             int const* face_offsets,
+                                                             int const* indices);
+
         /// @brief Defines a new contact topology
         /// @param[in] file_id The file id
         /// @param[in] contacts_api The structure containing the contact data
@@ -390,6 +790,20 @@ namespace ugridapi
         /// @return Error code
         UGRID_API int ug_contacts_get(int file_id, int topology_id, Contacts& contacts_api);
 
+        /// @brief Defines the chunking and compression of a variable (NetCDF-4 files only).
+        ///        Call before defining the variable, either directly or through a topology or location definition.
+        /// @param[in] file_id The file id
+        /// @param[in] variable_name The full variable name (e.g. "mesh2d_face_nodes")
+        /// @param[in] deflate_level The deflate level, 0 disables compression and 9 is the strongest compression
+        /// @param[in] chunk_sizes The chunk shape, one entry per variable dimension
+        /// @param[in] num_chunk_dimensions The number of entries in chunk_sizes, 0 for the library default chunking
+        /// @return Error code
+        UGRID_API int ug_variable_storage_define(int file_id,
+                                                 const char* variable_name,
+                                                 int deflate_level,
+                                                 int const* chunk_sizes,
+                                                 int num_chunk_dimensions);
+
         /// @brief Defines a new integer variable
         /// @param[in] file_id The file id
         /// @param[in] variable_name The variable name
@@ -1,12 +1,23 @@
 #pragma once
 
 #include <UGrid/Contacts.hpp>
+#include <UGrid/MappedFile.hpp>
 #include <UGrid/Mesh1D.hpp>
 #include <UGrid/Mesh2D.hpp>
 #include <UGrid/Network1D.hpp>
+#include <UGrid/TopologyScanner.hpp>
+#include <UGrid/VariableStorage.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace ugridapi
 {
+    using ugrid::HeaderPadding;
+
     /// @brief The class holding the state of the UGridIO
     struct UGridState
     {
@@ -15,15 +26,115 @@ namespace ugridapi
         /// @brief Constructor
         /// @param nc_file [in] A pointer to a NcFile handle
         explicit UGridState(const std::shared_ptr<netCDF::NcFile>& nc_file)
-            : m_ncFile(nc_file)
+            : m_ncFile(nc_file),
+              m_is_netcdf4(ugrid::is_netcdf4_format(*nc_file))
+        {
+        }
+
+        std::shared_ptr<netCDF::NcFile> m_ncFile; ///< A pointer to a NcFile handle
+
+        std::unique_ptr<std::recursive_mutex> m_mutex = std::make_unique<std::recursive_mutex>(); ///< Serializes API calls on this file
+
+        bool m_is_netcdf4 = false;                                        ///< If the file uses the NetCDF-4 format
+        std::map<std::string, ugrid::VariableStorage> m_variable_storage; ///< The chunking and compression settings, keyed by variable name
+        std::map<std::string, size_t> m_record_counts;                    ///< The number of records written to each variable on an unlimited dimension
+        HeaderPadding m_header_padding;                                   ///< The padding applied when leaving define mode
+        bool m_define_batch_open = false;                                 ///< If definitions are batched until \ref commit_define
+        std::unique_ptr<ugrid::MappedFile> m_mapped_file;                 ///< The memory mapping of the file, if opened mapped
+
+        /// @brief Gets all Mesh1D instances, discovering them in the file on first use
+        /// @return The Mesh1D instances
+        std::vector<ugrid::Mesh1D>& get_mesh1d()
         {
+            return get_topologies(m_mesh1d, m_mesh1d_discovered);
         }
 
-        std::shared_ptr<netCDF::NcFile> m_ncFile;  ///< A pointer to a NcFile handle
-        std::vector<ugrid::Mesh1D> m_mesh1d;       ///< A vector containing all Mesh1D instances
-        std::vector<ugrid::Network1D> m_network1d; ///< A vector containing all Network1D instances
-        std::vector<ugrid::Mesh2D> m_mesh2d;       ///< A vector containing all Mesh2D instances
-        std::vector<ugrid::Contacts> m_contacts;   ///< A vector containing all Contacts instances
+        /// @brief Gets all Network1D instances, discovering them in the file on first use
+        /// @return The Network1D instances
+        std::vector<ugrid::Network1D>& get_network1d()
+        {
+            return get_topologies(m_network1d, m_network1d_discovered);
+        }
+
+        /// @brief Gets all Mesh2D instances, discovering them in the file on first use
+        /// @return The Mesh2D instances
+        std::vector<ugrid::Mesh2D>& get_mesh2d()
+        {
+            return get_topologies(m_mesh2d, m_mesh2d_discovered);
+        }
+
+        /// @brief Gets all Contacts instances, discovering them in the file on first use
+        /// @return The Contacts instances
+        std::vector<ugrid::Contacts>& get_contacts()
+        {
+            return get_topologies(m_contacts, m_contacts_discovered);
+        }
+
+        /// @brief Discovers all topologies and builds the variable index now, instead of on first use
+        void discover_all()
+        {
+            get_mesh2d();
+            get_network1d();
+            get_mesh1d();
+            get_contacts();
+            get_variables();
+        }
+
+        /// @brief Marks the file as containing no topologies to discover, e.g. because it was just created
+        void set_no_topologies()
+        {
+            m_mesh1d_discovered = true;
+            m_network1d_discovered = true;
+            m_mesh2d_discovered = true;
+            m_contacts_discovered = true;
+        }
+
+        /// @brief Opens a define batch: topology definitions no longer leave define mode until \ref commit_define
+        void begin_define()
+        {
+            if (m_define_batch_open)
+            {
+                throw std::invalid_argument("begin_define: A define batch is already open.");
+            }
+            if (auto const status = nc_redef(m_ncFile->getId()); status != NC_NOERR && status != NC_EINDEFINE)
+            {
+                throw std::runtime_error(std::string("begin_define: ") + nc_strerror(status));
+            }
+            m_define_batch_open = true;
+        }
+
+        /// @brief Closes the define batch and leaves define mode, reserving the given header padding
+        /// @param padding The header and variable layout knobs, also used by later topology definitions
+        void commit_define(HeaderPadding const& padding)
+        {
+            if (!m_define_batch_open)
+            {
+                throw std::invalid_argument("commit_define: No define batch is open.");
+            }
+            m_header_padding = padding;
+            m_define_batch_open = false;
+            end_define();
+        }
+
+        /// @brief Leaves define mode after a definition, unless a define batch is open
+        void end_define() const
+        {
+            if (m_define_batch_open)
+            {
+                return;
+            }
+            ugrid::end_define(*m_ncFile, m_header_padding, "end_define");
+        }
+
+        /// @brief Throws if a define batch is open, because writing data would leave define mode without the requested padding
+        /// @param caller The name of the calling function, used in the error message
+        void check_not_defining(std::string const& caller) const
+        {
+            if (m_define_batch_open)
+            {
+                throw std::invalid_argument(caller + ": Data cannot be written while a define batch is open.");
+            }
+        }
 
         /// @brief Set netcdf dimensions not related to topology
         /// @param dimension_name The dimension name
@@ -39,6 +150,23 @@ namespace ugridapi
             m_dimensions.emplace(dimension_name, nc_dimension);
         }
 
+        /// @brief Set an unlimited (record) netcdf dimension not related to topology
+        /// @param dimension_name The dimension name
+        void set_unlimited_dimension(const std::string& dimension_name)
+        {
+            auto const it = m_dimensions.find(dimension_name);
+            if (it != m_dimensions.end())
+            {
+                if (!it->second.isUnlimited())
+                {
+                    throw std::invalid_argument("set_unlimited_dimension: The dimension " + dimension_name + " is already defined with a fixed size.");
+                }
+                return;
+            }
+            auto const nc_dimension = m_ncFile->addDim(dimension_name);
+            m_dimensions.emplace(dimension_name, nc_dimension);
+        }
+
         /// @brief Get the nectdf dimension from its name
         /// @param dimension_name The dimension name
         /// @return The netcdf dimension
@@ -47,7 +175,184 @@ namespace ugridapi
             return m_dimensions.at(dimension_name);
         }
 
+        /// @brief Finds a netcdf variable by name, using the cached variable index
+        /// @param variable_name The variable name
+        /// @return A pointer to the variable, or nullptr if the variable is not present in the file
+        netCDF::NcVar const* find_variable(const std::string& variable_name)
+        {
+            auto const& variables = get_variables();
+            auto const it = variables.find(variable_name);
+            return it == variables.end() ? nullptr : &it->second;
+        }
+
+        /// @brief Gets the cached index of all netcdf variables, rebuilding it if it was invalidated
+        /// @return The variables keyed by name
+        std::unordered_map<std::string, netCDF::NcVar> const& get_variables()
+        {
+            if (m_variables_invalidated)
+            {
+                rebuild_variables();
+            }
+            return m_variables;
+        }
+
+        /// @brief Adds a newly defined netcdf variable to the cached index
+        /// @param variable The netcdf variable
+        void add_variable(netCDF::NcVar const& variable)
+        {
+            m_variables.insert_or_assign(variable.getName(), variable);
+        }
+
+        /// @brief Gets the names of the data variables defined on a mesh location, using the cached index
+        /// @param mesh_name The mesh name, as stored in the "mesh" attribute of the data variables
+        /// @param location_string The location string (e.g. node, edge or face)
+        /// @return The variable names, sorted alphabetically
+        std::vector<std::string> const& get_data_variables_names(const std::string& mesh_name, const std::string& location_string)
+        {
+            if (m_variables_invalidated)
+            {
+                rebuild_variables();
+            }
+
+            static std::vector<std::string> const no_variables;
+            auto const it = m_data_variables.find({mesh_name, location_string});
+            return it == m_data_variables.end() ? no_variables : it->second;
+        }
+
+        /// @brief Updates the mesh location of a variable in the data variables index, after its "mesh" or "location" attribute changed
+        /// @param variable The netcdf variable
+        void index_data_variable(netCDF::NcVar const& variable)
+        {
+            // A stale index is rebuilt from the file on next use
+            if (m_variables_invalidated)
+            {
+                return;
+            }
+
+            auto const variable_name = variable.getName();
+            if (auto const it = m_data_variable_keys.find(variable_name); it != m_data_variable_keys.end())
+            {
+                auto& names = m_data_variables[it->second];
+                auto const name_it = std::lower_bound(names.begin(), names.end(), variable_name);
+                if (name_it != names.end() && *name_it == variable_name)
+                {
+                    names.erase(name_it);
+                }
+                m_data_variable_keys.erase(it);
+            }
+
+            if (auto const key = get_data_variable_key(variable); key.has_value())
+            {
+                auto& names = m_data_variables[*key];
+                names.insert(std::lower_bound(names.begin(), names.end(), variable_name), variable_name);
+                m_data_variable_keys.emplace(variable_name, *key);
+            }
+        }
+
+        /// @brief Marks the cached variable index as stale, e.g. after a topology defined several variables
+        void invalidate_variables()
+        {
+            m_variables_invalidated = true;
+        }
+
     private:
-        std::map<std::string, netCDF::NcDim> m_dimensions; ///< Dimensions not related to a topology
+        /// @brief Gets the topologies of one type, discovering them in the file on first use
+        /// @tparam T The topology type
+        /// @param topologies [in,out] The topologies of one type
+        /// @param discovered [in,out] If the topologies have already been discovered
+        /// @return The topologies
+        template <typename T>
+        std::vector<T>& get_topologies(std::vector<T>& topologies, bool& discovered)
+        {
+            if (discovered)
+            {
+                return topologies;
+            }
+
+            if (!m_topology_scanner)
+            {
+                m_topology_scanner = std::make_unique<ugrid::TopologyScanner>(m_ncFile);
+            }
+            topologies = m_topology_scanner->create<T>();
+            discovered = true;
+
+            // The scanner is no longer needed once all types are discovered
+            if (m_mesh1d_discovered && m_network1d_discovered && m_mesh2d_discovered && m_contacts_discovered)
+            {
+                m_topology_scanner.reset();
+            }
+            return topologies;
+        }
+
+        /// @brief Gets the mesh location of a data variable from its "mesh" and "location" attributes
+        /// @param variable The netcdf variable
+        /// @return The (mesh, location) key, or no value if it is not a data variable
+        static std::optional<std::pair<std::string, std::string>> get_data_variable_key(netCDF::NcVar const& variable)
+        {
+            auto const attributes = variable.getAtts();
+            auto const mesh_it = attributes.find("mesh");
+            auto const location_it = attributes.find("location");
+            if (mesh_it == attributes.end() || location_it == attributes.end())
+            {
+                return std::nullopt;
+            }
+
+            std::string mesh_name;
+            mesh_it->second.getValues(mesh_name);
+            std::string location_string;
+            location_it->second.getValues(location_string);
+            return std::make_pair(mesh_name, location_string);
+        }
+
+        /// @brief Rebuilds the cached variable index from the file.
+        ///        Variables on an unlimited dimension that have no record count yet take the current size of the dimension.
+        ///        Taking it for all of them before any append keeps a first append to one variable from shifting the others
+        void rebuild_variables()
+        {
+            m_variables.clear();
+            m_data_variables.clear();
+            m_data_variable_keys.clear();
+            if (m_ncFile != nullptr)
+            {
+                for (auto const& [name, variable] : m_ncFile->getVars())
+                {
+                    m_variables.emplace(name, variable);
+                    if (auto const key = get_data_variable_key(variable); key.has_value())
+                    {
+                        m_data_variables[*key].emplace_back(name);
+                        m_data_variable_keys.emplace(name, *key);
+                    }
+                    if (variable.getDimCount() > 0)
+                    {
+                        if (auto const record_dimension = variable.getDim(0); record_dimension.isUnlimited())
+                        {
+                            m_record_counts.emplace(name, record_dimension.getSize());
+                        }
+                    }
+                }
+            }
+            for (auto& [key, names] : m_data_variables)
+            {
+                std::sort(names.begin(), names.end());
+            }
+            m_variables_invalidated = false;
+        }
+
+        std::map<std::string, netCDF::NcDim> m_dimensions;          ///< Dimensions not related to a topology
+        std::unordered_map<std::string, netCDF::NcVar> m_variables; ///< Index of all variables in the file, keyed by name
+        bool m_variables_invalidated = true;                        ///< If the variable index must be (re)built before use
+
+        std::map<std::pair<std::string, std::string>, std::vector<std::string>> m_data_variables;  ///< Data variable names keyed by (mesh, location)
+        std::unordered_map<std::string, std::pair<std::string, std::string>> m_data_variable_keys; ///< The (mesh, location) of each data variable, keyed by name
+
+        std::vector<ugrid::Mesh1D> m_mesh1d;                        ///< A vector containing all Mesh1D instances
+        std::vector<ugrid::Network1D> m_network1d;                  ///< A vector containing all Network1D instances
+        std::vector<ugrid::Mesh2D> m_mesh2d;                        ///< A vector containing all Mesh2D instances
+        std::vector<ugrid::Contacts> m_contacts;                    ///< A vector containing all Contacts instances
+        bool m_mesh1d_discovered = false;                           ///< If the Mesh1D instances have been read from the file
+        bool m_network1d_discovered = false;                        ///< If the Network1D instances have been read from the file
+        bool m_mesh2d_discovered = false;                           ///< If the Mesh2D instances have been read from the file
+        bool m_contacts_discovered = false;                         ///< If the Contacts instances have been read from the file
+        std::unique_ptr<ugrid::TopologyScanner> m_topology_scanner; ///< The scanner used while not all topology types are discovered
     };
 } // namespace ugridapi
@@ -0,0 +1,56 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+namespace ugridapi
+{
+    /// @brief A struct used to describe one read of a batch of data variable reads in a C-compatible manner
+    struct VariableReadRequest
+    {
+        /// @brief The id of the file containing the variable
+        int file_id = -1;
+
+        /// @brief The name of the variable
+        char* variable_name = nullptr;
+
+        /// @brief The destination buffer, sized to the whole variable or to the product of count
+        double* data = nullptr;
+
+        /// @brief The start index along each dimension of the variable, nullptr to read the whole variable
+        int* start = nullptr;
+
+        /// @brief The number of values along each dimension of the variable, nullptr to read the whole variable
+        int* count = nullptr;
+
+        /// @brief The sampling interval along each dimension of the variable, nullptr for a contiguous selection
+        int* stride = nullptr;
+
+        /// @brief The error code of this read, set by the batch call
+        int status = 0;
+    };
+} // namespace ugridapi
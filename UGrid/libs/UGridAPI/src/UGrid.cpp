@@ -35,17 +35,32 @@
 
 #include <algorithm>
 #include <cstring>
+#include <functional>
+#include <iomanip>
+#include <limits>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <ncFile.h>
+#include <netcdf.h>
 
 #include <UGrid/Constants.hpp>
+#include <UGrid/FaceLocator.hpp>
+#include <UGrid/IndexOffset.hpp>
 #include <UGrid/Mesh2D.hpp>
+#include <UGrid/MeshConnectivity.hpp>
+#include <UGrid/MeshExtraction.hpp>
+#include <UGrid/MeshMerge.hpp>
+#include <UGrid/MeshPartition.hpp>
+#include <UGrid/MeshRenumbering.hpp>
 #include <UGrid/Operations.hpp>
+#include <UGrid/Parallel.hpp>
 #include <UGrid/UGridEntity.hpp>
 #include <UGridAPI/UGrid.hpp>
 #include <UGridAPI/UGridState.hpp>
@@ -55,7 +70,49 @@
 namespace ugridapi
 {
     static std::map<int, UGridState> ugrid_states;
-    static char exceptionMessage[error_message_buffer_size] = "";
+    static std::shared_mutex ugrid_states_mutex; ///< Guards insertion and removal of file states
+    static std::recursive_mutex netcdf_mutex;    ///< Serializes calls into the netCDF library where it is not thread-safe
+    static thread_local char exceptionMessage[error_message_buffer_size] = "";
+
+#if defined(UGRID_NETCDF_THREADSAFE)
+    static constexpr bool serialize_netcdf_calls = false;
+#else
+    static constexpr bool serialize_netcdf_calls = true;
+#endif
+
+    /// @brief Holds the locks giving one thread exclusive access to the state of a file for the duration of an API call.
+    ///        Calls on different files only share the registry lock, so their UGrid bookkeeping runs concurrently.
+    ///        Calls into netCDF are additionally serialized unless the library was built thread-safe,
+    ///        and always for NetCDF-4 files, because HDF5 is not reentrant.
+    class StateLock
+    {
+    public:
+        /// @brief Constructor, locks the state of a file
+        /// @param file_id [in] The file id
+        explicit StateLock(int file_id)
+            : m_registry_lock(ugrid_states_mutex)
+        {
+            auto const it = ugrid_states.find(file_id);
+            if (it == ugrid_states.end())
+            {
+                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+            }
+            m_file_lock = std::unique_lock(*it->second.m_mutex);
+            if (serialize_netcdf_calls || it->second.m_is_netcdf4)
+            {
+                m_netcdf_lock = std::unique_lock(netcdf_mutex);
+            }
+        }
+
+    private:
+        std::shared_lock<std::shared_mutex> m_registry_lock;  ///< Keeps the file state from being removed
+        std::unique_lock<std::recursive_mutex> m_file_lock;   ///< Serializes calls on the same file
+        std::unique_lock<std::recursive_mutex> m_netcdf_lock; ///< Serializes calls into the netCDF library
+    };
+
+    static std::unordered_map<int, std::unique_ptr<ugrid::FaceLocator>> face_locators; ///< The face locators, by locator id
+    static std::shared_mutex face_locators_mutex;                                      ///< Guards creation and removal of face locators, queries share it
+    static int next_face_locator_id = 0;                                               ///< The id of the next face locator
 
     /// @brief Hash table mapping locations to location names
     static const std::unordered_map<MeshLocations, std::string> locations_attribute_names{
@@ -65,6 +122,12 @@ namespace ugridapi
 
     };
 
+    /// @brief Hash table mapping face connectivities to topology attribute names
+    static const std::unordered_map<Mesh2DConnectivity, std::string> mesh2d_connectivity_attribute_names{
+        {Mesh2DConnectivity::FaceNodes, "face_node_connectivity"},
+        {Mesh2DConnectivity::FaceEdges, "face_edge_connectivity"},
+        {Mesh2DConnectivity::FaceFaces, "face_face_connectivity"}};
+
     /// @brief Hash table mapping locations to ugrid dimensions
     static const std::unordered_map<MeshLocations, ugrid::UGridFileDimensions> locations_ugrid_dimensions{
         {MeshLocations::Faces, ugrid::UGridFileDimensions::face},
@@ -84,20 +147,41 @@ namespace ugridapi
         }
     }
 
-    static std::unique_ptr<ugrid::UGridEntity> get_topology(int file_id,
-                                                            TopologyType topology_type,
-                                                            int topology_id)
+    /// @brief Gets a topology stored in the file state, without copying it
+    /// @tparam T The topology type
+    /// @param topologies The topologies of one type
+    /// @param topology_id The topology id
+    /// @return A reference to the topology, valid until the next topology of the same type is defined or the file is closed
+    template <typename T>
+    static ugrid::UGridEntity const& get_topology_at(std::vector<T> const& topologies, int topology_id)
+    {
+        if (topology_id < 0 || static_cast<size_t>(topology_id) >= topologies.size())
+        {
+            throw std::invalid_argument("UGrid: The selected topology_id does not exist.");
+        }
+        return topologies[topology_id];
+    }
+
+    /// @brief Gets a topology stored in the file state, without copying it
+    /// @param file_id The file id
+    /// @param topology_type The topology type
+    /// @param topology_id The topology id
+    /// @return A reference to the topology, valid until the next topology of the same type is defined or the file is closed
+    static ugrid::UGridEntity const& get_topology(int file_id,
+                                                  TopologyType topology_type,
+                                                  int topology_id)
     {
+        auto& state = ugrid_states.at(file_id);
         switch (topology_type)
         {
         case Network1dTopology:
-            return std::make_unique<ugrid::UGridEntity>(ugrid_states[file_id].m_network1d[topology_id]);
+            return get_topology_at(state.get_network1d(), topology_id);
         case Mesh1dTopology:
-            return std::make_unique<ugrid::UGridEntity>(ugrid_states[file_id].m_mesh1d[topology_id]);
+            return get_topology_at(state.get_mesh1d(), topology_id);
         case Mesh2dTopology:
-            return std::make_unique<ugrid::UGridEntity>(ugrid_states[file_id].m_mesh2d[topology_id]);
+            return get_topology_at(state.get_mesh2d(), topology_id);
         case ContactsTopology:
-            return std::make_unique<ugrid::UGridEntity>(ugrid_states[file_id].m_contacts[topology_id]);
+            return get_topology_at(state.get_contacts(), topology_id);
         default:
             throw std::runtime_error("Invalid topology.");
         }
@@ -184,12 +268,9 @@ namespace ugridapi
         // Gets the variable name
         const auto variable_name = ugrid::char_array_to_string(data_variable_name, ugrid::name_long_length);
 
-        // Gets all variables
-        const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
         // Finds the data variables using its name
-        const auto it = vars.find(variable_name);
-        if (it == vars.end())
+        const auto* const variable = ugrid_states.at(file_id).find_variable(variable_name);
+        if (variable == nullptr)
         {
             std::string const message = "get_data_array: The variable name " +
                                         variable_name +
@@ -198,17 +279,14 @@ namespace ugridapi
         }
 
         // Gets the data for all time steps
-        it->second.getVar(&data);
+        variable->getVar(&data);
     }
 
     static netCDF::NcVar get_variable(int file_id, std::string const& name)
     {
-        // Get all variables
-        const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
-        // Find the variable name
-        const auto it = vars.find(name);
-        if (it == vars.end())
+        // Find the variable in the cached index
+        const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+        if (variable == nullptr)
         {
             std::string const message = "get_variable: The variable name " +
                                         name +
@@ -216,7 +294,7 @@ namespace ugridapi
             throw std::invalid_argument(message);
         }
 
-        return it->second;
+        return *variable;
     }
 
     template <typename T>
@@ -227,12 +305,103 @@ namespace ugridapi
             throw std::invalid_argument("UGrid: The selected file_id does not exist.");
         }
 
+        ugrid_states.at(file_id).check_not_defining("put_data_array");
+
         const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
         const auto variable = get_variable(file_id, name);
 
         variable.putVar(data);
     }
 
+    /// @brief A hyperslab selection of a netcdf variable
+    struct Hyperslab
+    {
+        std::vector<size_t> start;      ///< The start index along each dimension
+        std::vector<size_t> count;      ///< The number of values along each dimension
+        std::vector<ptrdiff_t> stride;  ///< The sampling interval along each dimension
+    };
+
+    /// @brief Builds and validates a hyperslab selection against the dimensions of a variable
+    /// @param variable The netcdf variable
+    /// @param start The start index along each dimension
+    /// @param count The number of values along each dimension
+    /// @param stride The sampling interval along each dimension, or nullptr for a contiguous selection
+    /// @return The hyperslab selection
+    static Hyperslab make_hyperslab(netCDF::NcVar const& variable, int const* start, int const* count, int const* stride)
+    {
+        auto const dimensions = variable.getDims();
+        if (!dimensions.empty() && (start == nullptr || count == nullptr))
+        {
+            throw std::invalid_argument("make_hyperslab: start and count are required for variable " + variable.getName() + ".");
+        }
+
+        Hyperslab hyperslab;
+        hyperslab.start.resize(dimensions.size());
+        hyperslab.count.resize(dimensions.size());
+        hyperslab.stride.resize(dimensions.size(), 1);
+        for (size_t i = 0; i < dimensions.size(); ++i)
+        {
+            auto const dimension_size = static_cast<long long>(dimensions[i].getSize());
+            long long const dimension_start = start[i];
+            long long const dimension_count = count[i];
+            long long const dimension_stride = stride == nullptr ? 1 : stride[i];
+
+            if (dimension_start < 0 || dimension_count < 0 || dimension_stride < 1)
+            {
+                throw std::invalid_argument("make_hyperslab: Invalid start, count or stride for dimension " + dimensions[i].getName() + ".");
+            }
+            // The last sampled index must lie within the dimension (unlimited dimensions may grow on write)
+            if (dimension_count > 0 && !dimensions[i].isUnlimited() &&
+                dimension_start + (dimension_count - 1) * dimension_stride >= dimension_size)
+            {
+                throw std::invalid_argument("make_hyperslab: The selection exceeds the size of dimension " + dimensions[i].getName() + ".");
+            }
+
+            hyperslab.start[i] = static_cast<size_t>(dimension_start);
+            hyperslab.count[i] = static_cast<size_t>(dimension_count);
+            hyperslab.stride[i] = static_cast<ptrdiff_t>(dimension_stride);
+        }
+        return hyperslab;
+    }
+
+    /// @brief Gets a hyperslab of a data variable
+    /// @tparam T The value type
+    /// @param file_id The file id
+    /// @param variable_name The name of the data variable
+    /// @param start The start index along each dimension
+    /// @param count The number of values along each dimension
+    /// @param stride The sampling interval along each dimension, or nullptr for a contiguous selection
+    /// @param data The retrieved data, sized to the product of count
+    template <typename T>
+    static void get_data_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, T* data)
+    {
+        const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
+        const auto variable = get_variable(file_id, name);
+        const auto hyperslab = make_hyperslab(variable, start, count, stride);
+
+        variable.getVar(hyperslab.start, hyperslab.count, hyperslab.stride, data);
+    }
+
+    /// @brief Puts a hyperslab of a data variable
+    /// @tparam T The value type
+    /// @param file_id The file id
+    /// @param variable_name The name of the data variable
+    /// @param start The start index along each dimension
+    /// @param count The number of values along each dimension
+    /// @param stride The sampling interval along each dimension, or nullptr for a contiguous selection
+    /// @param data The data to write, sized to the product of count
+    template <typename T>
+    static void put_data_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, T const* data)
+    {
+        ugrid_states.at(file_id).check_not_defining("put_data_slice");
+
+        const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
+        const auto variable = get_variable(file_id, name);
+        const auto hyperslab = make_hyperslab(variable, start, count, stride);
+
+        variable.putVar(hyperslab.start, hyperslab.count, hyperslab.stride, data);
+    }
+
     template <typename T>
     static netCDF::NcType::ncType to_nc_type()
     {
@@ -261,7 +430,8 @@ namespace ugridapi
         }
 
         auto const var_name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
-        ugrid_states[file_id].m_ncFile->addVar(var_name, to_nc_type<T>());
+        auto const variable = ugrid_states.at(file_id).m_ncFile->addVar(var_name, to_nc_type<T>());
+        ugrid_states.at(file_id).add_variable(variable);
     }
 
     template <typename T>
@@ -281,6 +451,12 @@ namespace ugridapi
         const auto attribute_name = ugrid::char_array_to_string(att_name, ugrid::name_long_length);
 
         variable.putAtt(attribute_name, to_nc_type<T>(), num_values, attribute_values);
+
+        // Keep the data variables index current when a variable is (re)assigned to a mesh location
+        if (attribute_name == "mesh" || attribute_name == "location")
+        {
+            ugrid_states.at(file_id).index_data_variable(variable);
+        }
     }
 
     static std::string get_coordinate_variable_string(int file_id,
@@ -288,9 +464,9 @@ namespace ugridapi
                                                       int topology_id,
                                                       std::string const& var_name)
     {
-        auto topology = get_topology(file_id, topology_type, topology_id);
+        auto const& topology = get_topology(file_id, topology_type, topology_id);
 
-        auto coordinates_vector_variables = topology->get_topology_attribute_variable(var_name);
+        auto const& coordinates_vector_variables = topology.get_topology_attribute_variable(var_name);
         std::string result;
         for (size_t i = 0; i < coordinates_vector_variables.size() - 1; ++i)
         {
@@ -300,6 +476,40 @@ namespace ugridapi
         return result;
     }
 
+    /// @brief Applies the registered storage settings and the UGrid attributes to a variable defined on a topology location
+    /// @param file_id The file id
+    /// @param topology_type The topology type
+    /// @param topology_id The topology id
+    /// @param location The location on the topology
+    /// @param variable The netcdf variable
+    /// @param include_coordinates If the coordinates attribute should be added
+    static void put_location_variable_attributes(int file_id,
+                                                 TopologyType topology_type,
+                                                 int topology_id,
+                                                 MeshLocations location,
+                                                 netCDF::NcVar const& variable,
+                                                 bool include_coordinates)
+    {
+        const auto& topology = get_topology(file_id, topology_type, topology_id);
+        const auto mesh = topology.get_name();
+        const auto location_str = locations_attribute_names.at(location);
+
+        if (auto const it = ugrid_states.at(file_id).m_variable_storage.find(variable.getName()); it != ugrid_states.at(file_id).m_variable_storage.end())
+        {
+            ugrid::apply_variable_storage(variable, it->second);
+        }
+
+        variable.putAtt("mesh", netCDF::NcType::nc_CHAR, mesh.size(), mesh.c_str());
+        variable.putAtt("location", netCDF::NcType::nc_CHAR, location_str.size(), location_str.c_str());
+        ugrid_states.at(file_id).index_data_variable(variable);
+
+        if (include_coordinates)
+        {
+            const auto coordinates = get_coordinate_variable_string(file_id, topology_type, topology_id, location_str + "_coordinates");
+            variable.putAtt("coordinates", netCDF::NcType::nc_CHAR, coordinates.size(), coordinates.c_str());
+        }
+    }
+
     static void define_double_variable_on_location_impl(int file_id,
                                                         TopologyType topology_type,
                                                         int topology_id,
@@ -316,31 +526,63 @@ namespace ugridapi
 
         const auto local_variable_name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
 
-        const auto topology = get_topology(file_id, topology_type, topology_id);
-        const auto mesh = topology->get_name();
-
-        const auto location_str = locations_attribute_names.at(location);
+        const auto& topology = get_topology(file_id, topology_type, topology_id);
 
         // Register the extra dimension
         const auto local_dimension_name = ugrid::char_array_to_string(dimension_name, ugrid::name_long_length);
-        ugrid_states[file_id].set_dimension(local_dimension_name, dimension_value);
+        ugrid_states.at(file_id).set_dimension(local_dimension_name, dimension_value);
 
         // First dimension: topological; second dimension: caller-supplied
-        const auto variable_first_dimension = topology->get_dimension(locations_ugrid_dimensions.at(location));
-        const auto variable_second_dimension = ugrid_states[file_id].get_dimension(local_dimension_name);
+        const auto variable_first_dimension = topology.get_dimension(locations_ugrid_dimensions.at(location));
+        const auto variable_second_dimension = ugrid_states.at(file_id).get_dimension(local_dimension_name);
 
-        auto variable = ugrid_states[file_id].m_ncFile->addVar(local_variable_name,
+        auto variable = ugrid_states.at(file_id).m_ncFile->addVar(local_variable_name,
                                                                netCDF::NcType::nc_DOUBLE,
                                                                {variable_first_dimension, variable_second_dimension});
+        ugrid_states.at(file_id).add_variable(variable);
 
-        variable.putAtt("mesh", netCDF::NcType::nc_CHAR, mesh.size(), mesh.c_str());
-        variable.putAtt("location", netCDF::NcType::nc_CHAR, location_str.size(), location_str.c_str());
+        put_location_variable_attributes(file_id, topology_type, topology_id, location, variable, include_coordinates);
+    }
 
-        if (include_coordinates)
+    /// @brief Defines a double variable on a topology location with a leading unlimited (record) dimension
+    /// @param file_id The file id
+    /// @param topology_type The topology type
+    /// @param topology_id The topology id
+    /// @param location The location on the topology
+    /// @param variable_name The variable name
+    /// @param record_dimension_name The name of the unlimited dimension (e.g "time")
+    static void define_double_record_variable_on_location_impl(int file_id,
+                                                               TopologyType topology_type,
+                                                               int topology_id,
+                                                               MeshLocations location,
+                                                               const char* variable_name,
+                                                               const char* record_dimension_name)
+    {
+        if (ugrid_states.count(file_id) == 0)
         {
-            const auto coordinates = get_coordinate_variable_string(file_id, topology_type, topology_id, location_str + "_coordinates");
-            variable.putAtt("coordinates", netCDF::NcType::nc_CHAR, coordinates.size(), coordinates.c_str());
+            throw std::invalid_argument("UGrid: The selected file_id does not exist.");
         }
+
+        const auto local_variable_name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
+
+        const auto& topology = get_topology(file_id, topology_type, topology_id);
+
+        // Register the record dimension
+        const auto local_dimension_name = ugrid::char_array_to_string(record_dimension_name, ugrid::name_long_length);
+        ugrid_states.at(file_id).set_unlimited_dimension(local_dimension_name);
+
+        // First dimension: unlimited record; second dimension: topological
+        const auto variable_first_dimension = ugrid_states.at(file_id).get_dimension(local_dimension_name);
+        const auto variable_second_dimension = topology.get_dimension(locations_ugrid_dimensions.at(location));
+
+        auto variable = ugrid_states.at(file_id).m_ncFile->addVar(local_variable_name,
+                                                               netCDF::NcType::nc_DOUBLE,
+                                                               {variable_first_dimension, variable_second_dimension});
+        ugrid_states.at(file_id).add_variable(variable);
+
+        put_location_variable_attributes(file_id, topology_type, topology_id, location, variable, true);
+
+        ugrid_states.at(file_id).m_record_counts[local_variable_name] = 0;
     }
 
     UGRID_API int ug_error_get(char* error_message)
@@ -366,19 +608,21 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             switch (topology_type)
             {
             case Network1dTopology:
-                topology_count = static_cast<int>(ugrid_states[file_id].m_network1d.size());
+                topology_count = static_cast<int>(ugrid_states.at(file_id).get_network1d().size());
                 break;
             case Mesh1dTopology:
-                topology_count = static_cast<int>(ugrid_states[file_id].m_mesh1d.size());
+                topology_count = static_cast<int>(ugrid_states.at(file_id).get_mesh1d().size());
                 break;
             case Mesh2dTopology:
-                topology_count = static_cast<int>(ugrid_states[file_id].m_mesh2d.size());
+                topology_count = static_cast<int>(ugrid_states.at(file_id).get_mesh2d().size());
                 break;
             case ContactsTopology:
-                topology_count = static_cast<int>(ugrid_states[file_id].m_contacts.size());
+                topology_count = static_cast<int>(ugrid_states.at(file_id).get_contacts().size());
                 break;
             default:
                 throw std::runtime_error("Invalid topology");
@@ -401,16 +645,13 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
-            auto const topology = get_topology(file_id, topology_type, topology_id);
+            auto const& topology = get_topology(file_id, topology_type, topology_id);
 
-            auto const location_string = ugrid::from_location_integer_to_location_string(static_cast<int>(location));
+            auto const& location_string = locations_attribute_names.at(location);
 
-            auto const data_variables_names = topology->get_data_variables_names(location_string);
+            auto const& data_variables_names = ugrid_states.at(file_id).get_data_variables_names(topology.get_name(), location_string);
 
             // count data variables
             data_variable_count = static_cast<int>(data_variables_names.size());
@@ -432,16 +673,13 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
-            auto const topology = get_topology(file_id, topology_type, topology_id);
+            auto const& topology = get_topology(file_id, topology_type, topology_id);
 
-            auto const location_string = ugrid::from_location_integer_to_location_string(static_cast<int>(location));
+            auto const& location_string = locations_attribute_names.at(location);
 
-            auto const data_variables_names = topology->get_data_variables_names(location_string);
+            auto const& data_variables_names = ugrid_states.at(file_id).get_data_variables_names(topology.get_name(), location_string);
 
             ugrid::vector_of_strings_to_char_array(data_variables_names, ugrid::name_long_length, data_variables_names_result);
         }
@@ -463,6 +701,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             define_double_variable_on_location_impl(file_id, topology_type, topology_id, location,
                                                     variable_name, dimension_name, dimension_value,
                                                     true);
@@ -485,6 +725,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             define_double_variable_on_location_impl(file_id, topology_type, topology_id, location,
                                                     variable_name, dimension_name, dimension_value,
                                                     false);
@@ -496,25 +738,88 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_variable_count_attributes(int file_id, const char* variable_name, int& attributes_count)
+    UGRID_API int ug_topology_define_double_record_variable_on_location(int file_id,
+                                                                        TopologyType topology_type,
+                                                                        int topology_id,
+                                                                        MeshLocations location,
+                                                                        const char* variable_name,
+                                                                        const char* record_dimension_name)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            StateLock const lock(file_id);
+
+            define_double_record_variable_on_location_impl(file_id, topology_type, topology_id, location,
+                                                           variable_name, record_dimension_name);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_variable_append_data_double(int file_id, const char* variable_name, double const* data, int& record_index)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+            ugrid_states.at(file_id).check_not_defining("ug_variable_append_data_double");
+
+            const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
+            const auto variable = get_variable(file_id, name);
+
+            auto const dimensions = variable.getDims();
+            if (dimensions.empty() || !dimensions.front().isUnlimited())
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_variable_append_data_double: The variable " + name + " is not defined on an unlimited dimension.");
+            }
+
+            // Variables of files opened for appending continue after the records already present,
+            // counted for all variables when the variable index was built
+            auto& record_counts = ugrid_states.at(file_id).m_record_counts;
+            auto it = record_counts.find(name);
+            if (it == record_counts.end())
+            {
+                it = record_counts.emplace(name, dimensions.front().getSize()).first;
             }
 
+            // Write one record: all values of the remaining dimensions
+            std::vector<size_t> start(dimensions.size(), 0);
+            std::vector<size_t> count(dimensions.size());
+            start[0] = it->second;
+            count[0] = 1;
+            for (size_t i = 1; i < dimensions.size(); ++i)
+            {
+                count[i] = dimensions[i].getSize();
+            }
+            variable.putVar(start, count, data);
+
+            record_index = static_cast<int>(it->second);
+            ++it->second;
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_variable_count_attributes(int file_id, const char* variable_name, int& attributes_count)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
             // Get the variable name
             const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
 
-            // Get all variables
-            const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
-            // Find the variable name
-            const auto it = vars.find(name);
-            if (it == vars.end())
+            // Find the variable in the cached index
+            const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+            if (variable == nullptr)
             {
                 std::string const message = "ug_variable_count_attributes: The variable name " +
                                             name +
@@ -523,7 +828,7 @@ namespace ugridapi
             }
 
             // Get the dimensions
-            attributes_count = static_cast<int>(it->second.getAtts().size());
+            attributes_count = static_cast<int>(variable->getAtts().size());
         }
         catch (...)
         {
@@ -538,20 +843,14 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             // Get the variable name
             const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
 
-            // Get all variables
-            const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
-            // Find the variable name
-            const auto it = vars.find(name);
-            if (it == vars.end())
+            // Find the variable in the cached index
+            const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+            if (variable == nullptr)
             {
                 std::string const message = "ug_variable_count_attributes: The variable name " +
                                             name +
@@ -561,12 +860,12 @@ namespace ugridapi
 
             max_length = 0;
 
-            for (const auto& [key, value] : it->second.getAtts())
+            for (const auto& [key, value] : variable->getAtts())
             {
                 max_length = std::max(max_length, static_cast<int>(value.getAttLength()));
             }
 
-            if (!it->second.getAtts().empty())
+            if (!variable->getAtts().empty())
             {
                 // Add 1 for the null termination character
                 max_length += 1;
@@ -584,20 +883,14 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             // Get the variable name
             const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
 
-            // Get all variables
-            const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
-            // Find the variable name
-            const auto it = vars.find(name);
-            if (it == vars.end())
+            // Find the variable in the cached index
+            const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+            if (variable == nullptr)
             {
                 std::string const message = "ug_variable_get_attributes_values: The variable name " +
                                             name +
@@ -606,7 +899,7 @@ namespace ugridapi
             }
 
             // Get the attribute values
-            auto const attribute_values = get_attributes_values_as_strings(it->second);
+            auto const attribute_values = get_attributes_values_as_strings(*variable);
 
             ugrid::vector_of_strings_to_char_array(attribute_values, max_length, values);
         }
@@ -622,20 +915,14 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             // Get the variable name
             const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
 
-            // Get all variables
-            const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
-            // Find the variable name
-            const auto it = vars.find(name);
-            if (it == vars.end())
+            // Find the variable in the cached index
+            const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+            if (variable == nullptr)
             {
                 std::string const message = "ug_variable_get_attributes_names: The variable name " +
                                             name +
@@ -644,7 +931,7 @@ namespace ugridapi
             }
 
             // Get the attribute names
-            auto const attributes = it->second.getAtts();
+            auto const attributes = variable->getAtts();
             std::vector<std::string> attribute_names;
             for (auto const& attribute : attributes)
             {
@@ -664,20 +951,14 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             // Get the variable name
             const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
 
-            // Get all variables
-            const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
-            // Find the variable name
-            const auto it = vars.find(name);
-            if (it == vars.end())
+            // Find the variable in the cached index
+            const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+            if (variable == nullptr)
             {
                 std::string const message = "ug_variable_count_dimensions: The variable name " +
                                             name +
@@ -686,7 +967,7 @@ namespace ugridapi
             }
 
             // Get the dimensions
-            dimensions_count = static_cast<int>(it->second.getDims().size());
+            dimensions_count = static_cast<int>(variable->getDims().size());
         }
         catch (...)
         {
@@ -700,20 +981,14 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             // Get the variable name
             const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
 
-            // Get all variables
-            const auto vars = ugrid_states[file_id].m_ncFile->getVars();
-
-            // Find the variable name
-            const auto it = vars.find(name);
-            if (it == vars.end())
+            // Find the variable in the cached index
+            const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+            if (variable == nullptr)
             {
                 std::string const message = "ug_variable_get_data_dimensions: The variable name " +
                                             name +
@@ -722,9 +997,15 @@ namespace ugridapi
             }
 
             // Get the dimensions
-            auto const dimensions = it->second.getDims();
+            auto const dimensions = variable->getDims();
             for (size_t i = 0; i < dimensions.size(); ++i)
             {
+                if (dimensions[i].getSize() > static_cast<size_t>(std::numeric_limits<int>::max()))
+                {
+                    throw std::overflow_error("ug_variable_get_data_dimensions: The size of dimension " +
+                                              dimensions[i].getName() +
+                                              " exceeds the int range, use ug_variable_get_data_dimensions_long.");
+                }
                 dimension_vec[i] = static_cast<int>(dimensions[i].getSize());
             }
         }
@@ -735,15 +1016,42 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_variable_get_data_double(int file_id, const char* variable_name, double* data)
+    UGRID_API int ug_variable_get_data_dimensions_long(int file_id, const char* variable_name, int64_t* dimension_vec)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            StateLock const lock(file_id);
+
+            const auto name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
+            const auto* const variable = ugrid_states.at(file_id).find_variable(name);
+            if (variable == nullptr)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                std::string const message = "ug_variable_get_data_dimensions_long: The variable name " +
+                                            name +
+                                            " is not present in the netcdf file.";
+                throw std::invalid_argument(message);
+            }
+
+            auto const dimensions = variable->getDims();
+            for (size_t i = 0; i < dimensions.size(); ++i)
+            {
+                dimension_vec[i] = static_cast<int64_t>(dimensions[i].getSize());
             }
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_variable_get_data_double(int file_id, const char* variable_name, double* data)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
 
             get_data_array(file_id, variable_name, *data);
         }
@@ -759,10 +1067,7 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             get_data_array(file_id, variable_name, *data);
         }
@@ -778,10 +1083,7 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             get_data_array(file_id, variable_name, *data);
         }
@@ -797,6 +1099,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             put_data_array(file_id, variable_name, data);
         }
         catch (...)
@@ -811,6 +1115,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             put_data_array(file_id, variable_name, data);
         }
         catch (...)
@@ -825,6 +1131,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             put_data_array(file_id, variable_name, data);
         }
         catch (...)
@@ -834,41 +1142,14 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_file_read_mode(int& mode)
-    {
-        mode = static_cast<int>(netCDF::NcFile::read);
-        return Success;
-    }
-
-    UGRID_API int ug_file_write_mode(int& mode)
-    {
-        mode = static_cast<int>(netCDF::NcFile::write);
-        return Success;
-    }
-
-    UGRID_API int ug_file_replace_mode(int& mode) noexcept
-    {
-        mode = static_cast<int>(netCDF::NcFile::replace);
-        return Success;
-    }
-
-    UGRID_API int ug_file_open(const char* file_path, int mode, int& file_id)
+    UGRID_API int ug_variable_get_data_double_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, double* data)
     {
         int exit_code = Success;
         try
         {
-            auto local_mode = static_cast<netCDF::NcFile::FileMode>(mode);
-            auto const nc_file = std::make_shared<netCDF::NcFile>(file_path, local_mode, netCDF::NcFile::classic);
-            file_id = nc_file->getId();
-            ugrid_states.insert({nc_file->getId(), UGridState(nc_file)});
+            StateLock const lock(file_id);
 
-            if (mode == netCDF::NcFile::read || mode == netCDF::NcFile::write)
-            {
-                ugrid_states[file_id].m_mesh2d = ugrid::UGridEntity::create<ugrid::Mesh2D>(nc_file);
-                ugrid_states[file_id].m_network1d = ugrid::Network1D::create<ugrid::Network1D>(nc_file);
-                ugrid_states[file_id].m_mesh1d = ugrid::UGridEntity::create<ugrid::Mesh1D>(nc_file);
-                ugrid_states[file_id].m_contacts = ugrid::UGridEntity::create<ugrid::Contacts>(nc_file);
-            }
+            get_data_slice(file_id, variable_name, start, count, stride, data);
         }
         catch (...)
         {
@@ -877,17 +1158,14 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_file_close(int file_id)
+    UGRID_API int ug_variable_get_data_int_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, int* data)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
-            ugrid_states[file_id].m_ncFile->close();
-            ugrid_states.erase(file_id);
+            StateLock const lock(file_id);
+
+            get_data_slice(file_id, variable_name, start, count, stride, data);
         }
         catch (...)
         {
@@ -896,20 +1174,14 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_network1d_def(int file_id, Network1D const& network1d_api, int& topology_id)
+    UGRID_API int ug_variable_get_data_char_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, char* data)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
-            ugrid::Network1D network1d(ugrid_states[file_id].m_ncFile);
-            network1d.define(network1d_api);
-            ugrid_states[file_id].m_network1d.emplace_back(network1d);
-            topology_id = static_cast<int>(ugrid_states[file_id].m_network1d.size()) - 1;
+            get_data_slice(file_id, variable_name, start, count, stride, data);
         }
         catch (...)
         {
@@ -918,17 +1190,14 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_network1d_put(int file_id, int topology_id, Network1D const& network1d_api)
+    UGRID_API int ug_variable_put_data_double_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, double const* data)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
-            ugrid_states[file_id].m_network1d[topology_id].put(network1d_api);
+            put_data_slice(file_id, variable_name, start, count, stride, data);
         }
         catch (...)
         {
@@ -937,17 +1206,675 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_network1d_inq(int file_id, int topology_id, Network1D& network1d_api)
+    UGRID_API int ug_variable_put_data_int_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, int const* data)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            StateLock const lock(file_id);
+
+            put_data_slice(file_id, variable_name, start, count, stride, data);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_variable_put_data_char_slice(int file_id, const char* variable_name, int const* start, int const* count, int const* stride, char const* data)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            put_data_slice(file_id, variable_name, start, count, stride, data);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_variable_get_data_double_batch(VariableReadRequest* requests, int num_requests, int num_threads)
+    {
+        int exit_code = Success;
+        try
+        {
+            if (num_requests < 0 || (num_requests > 0 && requests == nullptr) || num_threads < 0)
+            {
+                throw std::invalid_argument("ug_variable_get_data_double_batch: Invalid requests or number of threads.");
+            }
+
+            // Reads on the same file are done in sequence, under one lock, while different files are read concurrently
+            std::map<int, std::vector<int>> requests_per_file;
+            for (int i = 0; i < num_requests; ++i)
+            {
+                requests[i].status = Success;
+                requests_per_file[requests[i].file_id].emplace_back(i);
+            }
+            std::vector<std::pair<int, std::vector<int>>> const file_requests(requests_per_file.begin(), requests_per_file.end());
+
+            // The error messages of the worker threads are thread local, keep the first one for the caller
+            std::mutex error_mutex;
+            std::string first_error_message;
+            auto const fail = [&](VariableReadRequest& request)
+            {
+                request.status = HandleExceptions(std::current_exception());
+                std::scoped_lock const error_lock(error_mutex);
+                if (first_error_message.empty())
+                {
+                    first_error_message = exceptionMessage;
+                }
+            };
+
+            ugrid::parallel_for(file_requests.size(),
+                                static_cast<size_t>(num_threads),
+                                [&](size_t file_index)
+                                {
+                                    auto const& [file_id, request_indices] = file_requests[file_index];
+
+                                    std::optional<StateLock> lock;
+                                    try
+                                    {
+                                        lock.emplace(file_id);
+                                    }
+                                    catch (...)
+                                    {
+                                        for (auto const request_index : request_indices)
+                                        {
+                                            fail(requests[request_index]);
+                                        }
+                                        return;
+                                    }
+
+                                    for (auto const request_index : request_indices)
+                                    {
+                                        auto& request = requests[request_index];
+                                        try
+                                        {
+                                            if (request.variable_name == nullptr || request.data == nullptr)
+                                            {
+                                                throw std::invalid_argument("ug_variable_get_data_double_batch: The variable name and the data buffer of a request must be set.");
+                                            }
+                                            if (request.start == nullptr && request.count == nullptr)
+                                            {
+                                                get_data_array(file_id, request.variable_name, *request.data);
+                                            }
+                                            else
+                                            {
+                                                get_data_slice(file_id, request.variable_name, request.start, request.count, request.stride, request.data);
+                                            }
+                                        }
+                                        catch (...)
+                                        {
+                                            fail(request);
+                                        }
+                                    }
+                                });
+
+            if (!first_error_message.empty())
+            {
+                std::strncpy(exceptionMessage, first_error_message.c_str(), error_message_buffer_size - 1);
+                exit_code = Exception;
+            }
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_read_mode(int& mode)
+    {
+        mode = static_cast<int>(netCDF::NcFile::read);
+        return Success;
+    }
+
+    UGRID_API int ug_file_write_mode(int& mode)
+    {
+        mode = static_cast<int>(netCDF::NcFile::write);
+        return Success;
+    }
+
+    UGRID_API int ug_file_replace_mode(int& mode) noexcept
+    {
+        mode = static_cast<int>(netCDF::NcFile::replace);
+        return Success;
+    }
+
+    UGRID_API int ug_file_classic_format(int& format)
+    {
+        format = static_cast<int>(netCDF::NcFile::classic);
+        return Success;
+    }
+
+    UGRID_API int ug_file_netcdf4_format(int& format)
+    {
+        format = static_cast<int>(netCDF::NcFile::nc4);
+        return Success;
+    }
+
+    UGRID_API int ug_file_open(const char* file_path, int mode, int& file_id)
+    {
+        return ug_file_open_with_format(file_path, mode, static_cast<int>(netCDF::NcFile::classic), file_id);
+    }
+
+    /// @brief A NcFile opened from a memory buffer with nc_open_mem, which the NetCDF C++ interface does not wrap
+    class NcMemoryFile : public netCDF::NcFile
+    {
+    public:
+        /// @brief Opens the buffer for reading
+        /// @param name [in] The name of the dataset, used in netCDF error messages only
+        /// @param buffer [in] The file contents, which must stay valid until the file is closed
+        /// @param buffer_size [in] The size of the buffer in bytes
+        NcMemoryFile(std::string const& name, char const* buffer, size_t buffer_size)
+        {
+            // The buffer is not modified when opened without NC_WRITE
+            auto const status = nc_open_mem(name.c_str(), NC_NOWRITE, buffer_size, const_cast<char*>(buffer), &myId);
+            if (status != NC_NOERR)
+            {
+                throw std::runtime_error(std::string("NcMemoryFile: ") + nc_strerror(status));
+            }
+            nullObject = false;
+        }
+    };
+
+    /// @brief Opens a netCDF file and registers its state
+    /// @param open_nc_file Opens the netCDF file, called while calls into the netCDF library are serialized
+    /// @param mode The opening mode, newly created files have no topologies to discover
+    /// @param deferred If topology discovery and the variable index are deferred until first use
+    /// @param mapped_file The memory mapping of the file, or nullptr
+    /// @return The file id
+    static int register_file(std::function<std::shared_ptr<netCDF::NcFile>()> const& open_nc_file,
+                             int mode,
+                             bool deferred,
+                             std::unique_ptr<ugrid::MappedFile> mapped_file)
+    {
+        // Opening registers the file in the global netCDF file list, so it is always serialized
+        UGridState state;
+        {
+            std::scoped_lock const netcdf_lock(netcdf_mutex);
+            state = UGridState(open_nc_file());
+
+            if (mode != netCDF::NcFile::read && mode != netCDF::NcFile::write)
+            {
+                state.set_no_topologies();
+            }
+            else if (!deferred)
+            {
+                state.discover_all();
+            }
+        }
+        state.m_mapped_file = std::move(mapped_file);
+
+        // The state is published only once it is complete
+        std::unique_lock const registry_lock(ugrid_states_mutex);
+        auto const file_id = state.m_ncFile->getId();
+        ugrid_states.insert_or_assign(file_id, std::move(state));
+        return file_id;
+    }
+
+    /// @brief Checks a file format is supported
+    /// @param format The file format
+    static void check_format(int format)
+    {
+        if (format != netCDF::NcFile::classic && format != netCDF::NcFile::nc4)
+        {
+            throw std::invalid_argument("UGrid: Unsupported file format.");
+        }
+    }
+
+    /// @brief Opens a file and registers its state
+    /// @param file_path The path of the file
+    /// @param mode The opening mode
+    /// @param format The format of newly created files
+    /// @param deferred If topology discovery and the variable index are deferred until first use
+    /// @param mapped If the file is also mapped into memory, see \ref ugrid::MappedFile
+    /// @return The file id
+    static int open_file(const char* file_path, int mode, int format, bool deferred, bool mapped)
+    {
+        check_format(format);
+
+        auto local_mode = static_cast<netCDF::NcFile::FileMode>(mode);
+        auto local_format = static_cast<netCDF::NcFile::FileFormat>(format);
+
+        // Mapping first rejects files in other formats (e.g. NetCDF-4) before the netCDF library opens them
+        std::unique_ptr<ugrid::MappedFile> mapped_file;
+        if (mapped)
+        {
+            mapped_file = std::make_unique<ugrid::MappedFile>(file_path);
+        }
+
+        return register_file([&]
+                             { return std::make_shared<netCDF::NcFile>(file_path, local_mode, local_format); },
+                             mode,
+                             deferred,
+                             std::move(mapped_file));
+    }
+
+    UGRID_API int ug_file_open_with_format(const char* file_path, int mode, int format, int& file_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            file_id = open_file(file_path, mode, format, false, false);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_open_deferred(const char* file_path, int mode, int& file_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            file_id = open_file(file_path, mode, static_cast<int>(netCDF::NcFile::classic), true, false);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_open_mapped(const char* file_path, int& file_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            file_id = open_file(file_path, static_cast<int>(netCDF::NcFile::read), static_cast<int>(netCDF::NcFile::classic), true, true);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_open_diskless(const char* file_path, int mode, int format, int& file_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            check_format(format);
+
+            // Mirrors the flags the NetCDF C++ interface derives from a mode and format
+            int flags = NC_DISKLESS | (format == netCDF::NcFile::nc4 ? NC_NETCDF4 : 0);
+            bool create = false;
+            switch (mode)
+            {
+            case netCDF::NcFile::read:
+                flags |= NC_NOWRITE;
+                break;
+            case netCDF::NcFile::write:
+                flags |= NC_WRITE | NC_PERSIST;
+                break;
+            case netCDF::NcFile::replace:
+                flags |= NC_CLOBBER | NC_PERSIST;
+                create = true;
+                break;
+            case netCDF::NcFile::newFile:
+                flags |= NC_NOCLOBBER | NC_PERSIST;
+                create = true;
+                break;
+            default:
+                throw std::invalid_argument("ug_file_open_diskless: Unsupported file mode.");
+            }
+
+            auto const open_nc_file = [&]()
+            {
+                auto nc_file = std::make_shared<netCDF::NcFile>();
+                if (create)
+                {
+                    nc_file->create(file_path, flags);
+                }
+                else
+                {
+                    nc_file->open(file_path, flags);
+                }
+                return nc_file;
+            };
+            file_id = register_file(open_nc_file, mode, false, nullptr);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_open_memory(const char* name, const char* buffer, int64_t buffer_size, int& file_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            if (name == nullptr || buffer == nullptr || buffer_size <= 0)
+            {
+                throw std::invalid_argument("ug_file_open_memory: The name must be set and the buffer must not be empty.");
+            }
+
+            file_id = register_file([&]
+                                    { return std::make_shared<NcMemoryFile>(name, buffer, static_cast<size_t>(buffer_size)); },
+                                    netCDF::NcFile::read,
+                                    false,
+                                    nullptr);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_close(int file_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            // Waits until no other call uses the file, then removes its state
+            std::unique_lock registry_lock(ugrid_states_mutex);
+            auto node = ugrid_states.extract(file_id);
+            if (node.empty())
+            {
+                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+            }
+            registry_lock.unlock();
+
+            std::scoped_lock const netcdf_lock(netcdf_mutex);
+            node.mapped().m_ncFile->close();
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_begin_define(int file_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).begin_define();
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_file_commit_define(int file_id, int header_free_space, int variable_alignment, int variable_free_space, int record_alignment)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            if (header_free_space < 0 || variable_alignment < 1 || variable_free_space < 0 || record_alignment < 1)
+            {
+                throw std::invalid_argument("ug_file_commit_define: The free space must be non-negative and the alignments positive.");
+            }
+
+            HeaderPadding padding;
+            padding.header_free_space = static_cast<size_t>(header_free_space);
+            padding.variable_alignment = static_cast<size_t>(variable_alignment);
+            padding.variable_free_space = static_cast<size_t>(variable_free_space);
+            padding.record_alignment = static_cast<size_t>(record_alignment);
+            ugrid_states.at(file_id).commit_define(padding);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_network1d_def(int file_id, Network1D const& network1d_api, int& topology_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            // Discovers the existing topologies first, a deferred discovery after the definition would also find the new one
+            auto& network1ds = ugrid_states.at(file_id).get_network1d();
+
+            ugrid::Network1D network1d(ugrid_states.at(file_id).m_ncFile);
+            network1d.set_variable_storage(ugrid_states.at(file_id).m_variable_storage);
+            network1d.define(network1d_api);
+            ugrid_states.at(file_id).end_define();
+            ugrid_states.at(file_id).invalidate_variables();
+            network1ds.emplace_back(network1d);
+            topology_id = static_cast<int>(network1ds.size()) - 1;
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_network1d_put(int file_id, int topology_id, Network1D const& network1d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).check_not_defining("ug_network1d_put");
+            ugrid_states.at(file_id).get_network1d()[topology_id].put(network1d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_network1d_inq(int file_id, int topology_id, Network1D& network1d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).get_network1d()[topology_id].inquire(network1d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_network1d_get(int file_id, int topology_id, Network1D& network1d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).get_network1d()[topology_id].get(network1d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh1d_def(int file_id, Mesh1D const& mesh1d_api, int& topology_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            // Discovers the existing topologies first, a deferred discovery after the definition would also find the new one
+            auto& mesh1ds = ugrid_states.at(file_id).get_mesh1d();
+
+            ugrid::Mesh1D mesh1d(ugrid_states.at(file_id).m_ncFile);
+            mesh1d.set_variable_storage(ugrid_states.at(file_id).m_variable_storage);
+            mesh1d.define(mesh1d_api);
+            ugrid_states.at(file_id).end_define();
+            ugrid_states.at(file_id).invalidate_variables();
+            mesh1ds.emplace_back(mesh1d);
+            topology_id = static_cast<int>(mesh1ds.size()) - 1;
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh1d_put(int file_id, int topology_id, Mesh1D const& mesh1d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).check_not_defining("ug_mesh1d_put");
+            ugrid_states.at(file_id).get_mesh1d()[topology_id].put(mesh1d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh1d_inq(int file_id, int topology_id, Mesh1D& mesh1d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).get_mesh1d()[topology_id].inquire(mesh1d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh1d_get(int file_id, int topology_id, Mesh1D& mesh1d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).get_mesh1d()[topology_id].get(mesh1d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_def(int file_id, Mesh2D const& mesh2d_api, int& topology_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            // Discovers the existing topologies first, a deferred discovery after the definition would also find the new one
+            auto& mesh2ds = ugrid_states.at(file_id).get_mesh2d();
+
+            ugrid::Mesh2D mesh2d(ugrid_states.at(file_id).m_ncFile);
+            mesh2d.set_variable_storage(ugrid_states.at(file_id).m_variable_storage);
+            mesh2d.define(mesh2d_api);
+            ugrid_states.at(file_id).end_define();
+            ugrid_states.at(file_id).invalidate_variables();
+            mesh2ds.emplace_back(mesh2d);
+            topology_id = static_cast<int>(mesh2ds.size()) - 1;
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_put(int file_id, int topology_id, Mesh2D const& mesh2d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).check_not_defining("ug_mesh2d_put");
+            ugrid_states.at(file_id).get_mesh2d()[topology_id].put(mesh2d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_inq(int file_id, int topology_id, Mesh2D& mesh2d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).get_mesh2d()[topology_id].inquire(mesh2d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_get(int file_id, int topology_id, Mesh2D& mesh2d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).get_mesh2d()[topology_id].get(mesh2d_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_get_mapped(int file_id, int topology_id, Mesh2D& mesh2d_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            auto& state = ugrid_states.at(file_id);
+            if (state.m_mapped_file == nullptr)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_get_mapped: The file was not opened with ug_file_open_mapped.");
             }
-
-            ugrid_states[file_id].m_network1d[topology_id].inquire(network1d_api);
+            get_topology_at(state.get_mesh2d(), topology_id);
+            state.get_mesh2d()[topology_id].get_mapped(*state.m_mapped_file, mesh2d_api);
         }
         catch (...)
         {
@@ -956,12 +1883,19 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_network1d_get(int file_id, int topology_id, Network1D& network1d_api)
+    UGRID_API int ug_mesh2d_derive_connectivity(int file_id, int topology_id, int num_threads)
     {
         int exit_code = Success;
         try
         {
-            ugrid_states[file_id].m_network1d[topology_id].get(network1d_api);
+            StateLock const lock(file_id);
+
+            if (num_threads < 0)
+            {
+                throw std::invalid_argument("ug_mesh2d_derive_connectivity: The number of threads must not be negative.");
+            }
+            get_topology_at(ugrid_states.at(file_id).get_mesh2d(), topology_id);
+            ugrid_states.at(file_id).get_mesh2d()[topology_id].derive_connectivity(static_cast<size_t>(num_threads));
         }
         catch (...)
         {
@@ -970,20 +1904,63 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh1d_def(int file_id, Mesh1D const& mesh1d_api, int& topology_id)
+    /// @brief Gets the connectivity of a mesh2d api structure as int indices, narrowing the 64-bit connectivity when it is set
+    /// @param values The 32-bit connectivity
+    /// @param values_long The 64-bit connectivity, used instead of values if set
+    /// @param size The number of values
+    /// @param buffer Holds the narrowed 64-bit connectivity
+    /// @param caller The name of the calling function, used in the error messages
+    /// @return The int connectivity
+    static int const* get_int_connectivity(int const* values, int64_t const* values_long, size_t size, std::vector<int>& buffer, std::string const& caller)
+    {
+        if (values_long == nullptr)
+        {
+            return values;
+        }
+        buffer.resize(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (values_long[i] < std::numeric_limits<int>::min() || values_long[i] > std::numeric_limits<int>::max())
+            {
+                throw std::overflow_error(caller + ": The 64-bit connectivity contains an index exceeding the int range.");
+            }
+            buffer[i] = static_cast<int>(values_long[i]);
+        }
+        return buffer.data();
+    }
+
+    UGRID_API int ug_mesh2d_build_node_faces(Mesh2D const& mesh2d_api, int num_threads, int* node_face_offsets, int* node_faces)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if ((mesh2d_api.face_nodes == nullptr && mesh2d_api.face_nodes_long == nullptr) || node_face_offsets == nullptr || node_faces == nullptr)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_build_node_faces: face_nodes and the output arrays are required.");
+            }
+            if (num_threads < 0 || mesh2d_api.num_face_nodes_max < 0)
+            {
+                throw std::invalid_argument("ug_mesh2d_build_node_faces: The number of face nodes and of threads must not be negative.");
             }
 
-            ugrid::Mesh1D mesh1d(ugrid_states[file_id].m_ncFile);
-            mesh1d.define(mesh1d_api);
-            ugrid_states[file_id].m_mesh1d.emplace_back(mesh1d);
-            topology_id = static_cast<int>(ugrid_states[file_id].m_mesh1d.size()) - 1;
+            auto const num_faces = ugrid::get_mesh2d_count(mesh2d_api.num_faces, mesh2d_api.num_faces_long);
+            auto const num_face_nodes_max = static_cast<size_t>(mesh2d_api.num_face_nodes_max);
+            std::vector<int> face_nodes_buffer;
+            auto const* face_nodes = get_int_connectivity(mesh2d_api.face_nodes,
+                                                          mesh2d_api.face_nodes_long,
+                                                          num_faces * num_face_nodes_max,
+                                                          face_nodes_buffer,
+                                                          "ug_mesh2d_build_node_faces");
+
+            ugrid::build_inverse_connectivity(face_nodes,
+                                              num_faces,
+                                              num_face_nodes_max,
+                                              ugrid::get_mesh2d_count(mesh2d_api.num_nodes, mesh2d_api.num_nodes_long),
+                                              mesh2d_api.start_index,
+                                              mesh2d_api.int_fill_value,
+                                              static_cast<size_t>(num_threads),
+                                              node_face_offsets,
+                                              node_faces);
         }
         catch (...)
         {
@@ -992,17 +1969,37 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh1d_put(int file_id, int topology_id, Mesh1D const& mesh1d_api)
+    UGRID_API int ug_mesh2d_build_node_edges(Mesh2D const& mesh2d_api, int num_threads, int* node_edge_offsets, int* node_edges)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if ((mesh2d_api.edge_nodes == nullptr && mesh2d_api.edge_nodes_long == nullptr) || node_edge_offsets == nullptr || node_edges == nullptr)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_build_node_edges: edge_nodes and the output arrays are required.");
+            }
+            if (num_threads < 0)
+            {
+                throw std::invalid_argument("ug_mesh2d_build_node_edges: The number of threads must not be negative.");
             }
 
-            ugrid_states[file_id].m_mesh1d[topology_id].put(mesh1d_api);
+            auto const num_edges = ugrid::get_mesh2d_count(mesh2d_api.num_edges, mesh2d_api.num_edges_long);
+            std::vector<int> edge_nodes_buffer;
+            auto const* edge_nodes = get_int_connectivity(mesh2d_api.edge_nodes,
+                                                          mesh2d_api.edge_nodes_long,
+                                                          num_edges * 2,
+                                                          edge_nodes_buffer,
+                                                          "ug_mesh2d_build_node_edges");
+
+            ugrid::build_inverse_connectivity(edge_nodes,
+                                              num_edges,
+                                              2,
+                                              ugrid::get_mesh2d_count(mesh2d_api.num_nodes, mesh2d_api.num_nodes_long),
+                                              mesh2d_api.start_index,
+                                              mesh2d_api.int_fill_value,
+                                              static_cast<size_t>(num_threads),
+                                              node_edge_offsets,
+                                              node_edges);
         }
         catch (...)
         {
@@ -1011,17 +2008,80 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh1d_inq(int file_id, int topology_id, Mesh1D& mesh1d_api)
+    /// @brief Extracts the faces of a mesh2d lying inside a region, with their nodes, edges and data variables, to a new file
+    /// @param file_id The file id
+    /// @param topology_id The topology id
+    /// @param is_inside Tells if a point lies inside the region
+    /// @param output_file_path The path of the new file, replaced if it exists
+    /// @return The number of extracted faces
+    static int extract_mesh2d_to_file(int file_id, int topology_id, std::function<bool(double, double)> const& is_inside, const char* output_file_path)
+    {
+        StateLock const lock(file_id);
+
+        auto& state = ugrid_states.at(file_id);
+        state.check_not_defining("extract_mesh2d");
+        get_topology_at(state.get_mesh2d(), topology_id);
+        auto& mesh = state.get_mesh2d()[topology_id];
+
+        // The output file is created in the format and with the header padding of the input file, and closed when leaving the scope
+        std::scoped_lock const netcdf_lock(netcdf_mutex);
+        auto const output_file = std::make_shared<netCDF::NcFile>(output_file_path,
+                                                                  netCDF::NcFile::replace,
+                                                                  state.m_is_netcdf4 ? netCDF::NcFile::nc4 : netCDF::NcFile::classic);
+        return static_cast<int>(ugrid::extract_mesh2d(mesh, state.m_ncFile, is_inside, output_file, state.m_header_padding));
+    }
+
+    UGRID_API int ug_mesh2d_extract_bounding_box(int file_id,
+                                                 int topology_id,
+                                                 double min_x,
+                                                 double min_y,
+                                                 double max_x,
+                                                 double max_y,
+                                                 const char* output_file_path,
+                                                 int& num_faces)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if (min_x > max_x || min_y > max_y)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_extract_bounding_box: The minimum corner must not exceed the maximum corner.");
             }
+            num_faces = extract_mesh2d_to_file(
+                file_id,
+                topology_id,
+                [=](double x, double y)
+                { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; },
+                output_file_path);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
 
-            ugrid_states[file_id].m_mesh1d[topology_id].inquire(mesh1d_api);
+    UGRID_API int ug_mesh2d_extract_polygon(int file_id,
+                                            int topology_id,
+                                            int num_polygon_nodes,
+                                            double const* polygon_x,
+                                            double const* polygon_y,
+                                            const char* output_file_path,
+                                            int& num_faces)
+    {
+        int exit_code = Success;
+        try
+        {
+            if (num_polygon_nodes < 3)
+            {
+                throw std::invalid_argument("ug_mesh2d_extract_polygon: The polygon must have at least 3 nodes.");
+            }
+            num_faces = extract_mesh2d_to_file(
+                file_id,
+                topology_id,
+                [=](double x, double y)
+                { return ugrid::is_point_in_polygon(x, y, polygon_x, polygon_y, static_cast<size_t>(num_polygon_nodes)); },
+                output_file_path);
         }
         catch (...)
         {
@@ -1030,17 +2090,31 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh1d_get(int file_id, int topology_id, Mesh1D& mesh1d_api)
+    UGRID_API int ug_mesh2d_partition_faces(Mesh2D const& mesh2d_api, int num_domains, int num_threads, int* face_domains)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if (mesh2d_api.node_x == nullptr || mesh2d_api.node_y == nullptr || mesh2d_api.face_nodes == nullptr || face_domains == nullptr)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_partition_faces: node_x, node_y, face_nodes and face_domains are required.");
+            }
+            if (num_threads < 0 || num_domains < 1 || mesh2d_api.num_nodes < 0 || mesh2d_api.num_faces < 0 || mesh2d_api.num_face_nodes_max < 0)
+            {
+                throw std::invalid_argument("ug_mesh2d_partition_faces: The counts and the number of threads must not be negative, and there must be a domain.");
             }
 
-            ugrid_states[file_id].m_mesh1d[topology_id].get(mesh1d_api);
+            ugrid::Mesh2DArrays arrays;
+            auto const num_nodes = static_cast<size_t>(mesh2d_api.num_nodes);
+            arrays.node_x.assign(mesh2d_api.node_x, mesh2d_api.node_x + num_nodes);
+            arrays.node_y.assign(mesh2d_api.node_y, mesh2d_api.node_y + num_nodes);
+            arrays.num_face_nodes_max = static_cast<size_t>(mesh2d_api.num_face_nodes_max);
+            arrays.fill_value = mesh2d_api.int_fill_value;
+            arrays.face_nodes.assign(mesh2d_api.face_nodes, mesh2d_api.face_nodes + static_cast<size_t>(mesh2d_api.num_faces) * arrays.num_face_nodes_max);
+            ugrid::add_index_offset(-mesh2d_api.start_index, arrays.fill_value, arrays.face_nodes.size(), arrays.face_nodes.data());
+
+            auto const domains = ugrid::partition_mesh2d_faces(arrays, static_cast<size_t>(num_domains), static_cast<size_t>(num_threads));
+            std::copy(domains.begin(), domains.end(), face_domains);
         }
         catch (...)
         {
@@ -1049,20 +2123,58 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh2d_def(int file_id, Mesh2D const& mesh2d_api, int& topology_id)
+    UGRID_API int ug_mesh2d_write_partitions(int file_id,
+                                             int topology_id,
+                                             int num_domains,
+                                             int num_ghost_layers,
+                                             int const* face_domains,
+                                             const char* output_file_prefix,
+                                             int num_threads)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if (num_threads < 0 || num_domains < 1 || num_ghost_layers < 0)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_write_partitions: The number of ghost layers and threads must not be negative, and there must be a domain.");
             }
 
-            ugrid::Mesh2D mesh2d(ugrid_states[file_id].m_ncFile);
-            mesh2d.define(mesh2d_api);
-            ugrid_states[file_id].m_mesh2d.emplace_back(mesh2d);
-            topology_id = static_cast<int>(ugrid_states[file_id].m_mesh2d.size()) - 1;
+            StateLock const lock(file_id);
+            auto& state = ugrid_states.at(file_id);
+            state.check_not_defining("ug_mesh2d_write_partitions");
+            get_topology_at(state.get_mesh2d(), topology_id);
+            auto& mesh = state.get_mesh2d()[topology_id];
+
+            std::vector<int> domains;
+            if (face_domains == nullptr)
+            {
+                domains = ugrid::partition_mesh2d_faces(ugrid::read_mesh2d_arrays(mesh), static_cast<size_t>(num_domains), static_cast<size_t>(num_threads));
+            }
+            else
+            {
+                ugridapi::Mesh2D mesh2d_api;
+                mesh.inquire(mesh2d_api);
+                domains.assign(face_domains, face_domains + mesh2d_api.num_faces);
+            }
+
+            // The files are created in the format and with the header padding of the input file, and each one is closed once written
+            std::string const prefix(output_file_prefix);
+            auto const format = state.m_is_netcdf4 ? netCDF::NcFile::nc4 : netCDF::NcFile::classic;
+            std::scoped_lock const netcdf_lock(netcdf_mutex);
+            ugrid::write_mesh2d_partitions(
+                mesh,
+                state.m_ncFile,
+                domains,
+                static_cast<size_t>(num_domains),
+                static_cast<size_t>(num_ghost_layers),
+                [&prefix, format](size_t domain)
+                {
+                    std::ostringstream file_path;
+                    file_path << prefix << "_" << std::setw(4) << std::setfill('0') << domain << ".nc";
+                    return std::make_shared<netCDF::NcFile>(file_path.str(), netCDF::NcFile::replace, format);
+                },
+                state.m_header_padding,
+                static_cast<size_t>(num_threads));
         }
         catch (...)
         {
@@ -1071,17 +2183,52 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh2d_put(int file_id, int topology_id, Mesh2D const& mesh2d_api)
+    UGRID_API int ug_mesh2d_merge_partitions(const char* input_file_prefix,
+                                             const char* input_file_suffix,
+                                             int num_domains,
+                                             int topology_id,
+                                             double tolerance,
+                                             const char* output_file_path,
+                                             int num_threads,
+                                             int& num_faces)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if (num_threads < 0 || num_domains < 1 || topology_id < 0)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_merge_partitions: The topology id and the number of threads must not be negative, and there must be a domain.");
+            }
+
+            // The domain files are opened outside the registry, only for the duration of the merge
+            std::string const prefix(input_file_prefix);
+            std::string const suffix(input_file_suffix);
+            std::scoped_lock const netcdf_lock(netcdf_mutex);
+            std::vector<std::shared_ptr<netCDF::NcFile>> sources;
+            std::vector<ugrid::Mesh2D> domains;
+            bool has_netcdf4_source = false;
+            for (int domain = 0; domain < num_domains; ++domain)
+            {
+                std::ostringstream file_path;
+                file_path << prefix << "_" << std::setw(4) << std::setfill('0') << domain << suffix;
+                auto const source = std::make_shared<netCDF::NcFile>(file_path.str(), netCDF::NcFile::read);
+                auto meshes = ugrid::UGridEntity::create<ugrid::Mesh2D>(source);
+                if (static_cast<size_t>(topology_id) >= meshes.size())
+                {
+                    throw std::invalid_argument("ug_mesh2d_merge_partitions: " + file_path.str() + " has no mesh2d topology " + std::to_string(topology_id) + ".");
+                }
+                domains.emplace_back(std::move(meshes[topology_id]));
+                sources.emplace_back(source);
+                has_netcdf4_source = has_netcdf4_source || ugrid::is_netcdf4_format(*source);
             }
 
-            ugrid_states[file_id].m_mesh2d[topology_id].put(mesh2d_api);
+            // The domains are read concurrently only if the netCDF library allows it
+            auto const max_read_threads = serialize_netcdf_calls || has_netcdf4_source ? size_t{1} : static_cast<size_t>(num_threads);
+            // The domain files have no registered state, so the output file gets the default header padding
+            auto const output_file = std::make_shared<netCDF::NcFile>(output_file_path,
+                                                                      netCDF::NcFile::replace,
+                                                                      ugrid::is_netcdf4_format(*sources[0]) ? netCDF::NcFile::nc4 : netCDF::NcFile::classic);
+            num_faces = static_cast<int>(ugrid::merge_mesh2d_partitions(domains, sources, tolerance, output_file, ugrid::HeaderPadding{}, max_read_threads));
         }
         catch (...)
         {
@@ -1090,17 +2237,44 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh2d_inq(int file_id, int topology_id, Mesh2D& mesh2d_api)
+    UGRID_API int ug_mesh2d_renumber_hilbert(Mesh2D& mesh2d_api,
+                                             int num_threads,
+                                             int* node_permutation,
+                                             int* edge_permutation,
+                                             int* face_permutation)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if (num_threads < 0)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_mesh2d_renumber_hilbert: The number of threads must not be negative.");
+            }
+
+            auto const permutations = ugrid::compute_mesh2d_hilbert_order(mesh2d_api, static_cast<size_t>(num_threads));
+            for (auto const* permutation : {&permutations.nodes, &permutations.edges, &permutations.faces})
+            {
+                if (permutation->size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+                {
+                    throw std::invalid_argument("ug_mesh2d_renumber_hilbert: The number of entities exceeds the int range of the permutations.");
+                }
             }
+            ugrid::renumber_mesh2d(permutations, static_cast<size_t>(num_threads), mesh2d_api);
 
-            ugrid_states[file_id].m_mesh2d[topology_id].inquire(mesh2d_api);
+            auto const copy_permutation = [start_index = mesh2d_api.start_index](std::vector<size_t> const& permutation, int* values)
+            {
+                if (values == nullptr)
+                {
+                    return;
+                }
+                for (size_t i = 0; i < permutation.size(); ++i)
+                {
+                    values[i] = static_cast<int>(permutation[i]) + start_index;
+                }
+            };
+            copy_permutation(permutations.nodes, node_permutation);
+            copy_permutation(permutations.edges, edge_permutation);
+            copy_permutation(permutations.faces, face_permutation);
         }
         catch (...)
         {
@@ -1109,12 +2283,36 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_mesh2d_get(int file_id, int topology_id, Mesh2D& mesh2d_api)
+    UGRID_API int ug_mesh2d_permute_data_double(int const* permutation,
+                                                int num_entities,
+                                                int num_values_per_entity,
+                                                int start_index,
+                                                double* values)
     {
         int exit_code = Success;
         try
         {
-            ugrid_states[file_id].m_mesh2d[topology_id].get(mesh2d_api);
+            if (permutation == nullptr || values == nullptr)
+            {
+                throw std::invalid_argument("ug_mesh2d_permute_data_double: permutation and values are required.");
+            }
+            if (num_entities < 0 || num_values_per_entity < 0)
+            {
+                throw std::invalid_argument("ug_mesh2d_permute_data_double: The counts must not be negative.");
+            }
+
+            std::vector<size_t> entity_permutation(static_cast<size_t>(num_entities));
+            for (size_t i = 0; i < entity_permutation.size(); ++i)
+            {
+                if (permutation[i] < start_index)
+                {
+                    throw std::invalid_argument("ug_mesh2d_permute_data_double: The permutation contains an index below the start index.");
+                }
+                entity_permutation[i] = static_cast<size_t>(permutation[i] - start_index);
+            }
+            // Inverting checks that every entity appears exactly once, before any value is moved
+            [[maybe_unused]] auto const inverse = ugrid::invert_permutation(entity_permutation);
+            ugrid::permute_values(entity_permutation, static_cast<size_t>(num_values_per_entity), values);
         }
         catch (...)
         {
@@ -1123,20 +2321,44 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_contacts_def(int file_id, Contacts const& contacts_api, int& topology_id)
+    UGRID_API int ug_face_locator_create(Mesh2D const& mesh2d_api, int num_threads, int& locator_id)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if (mesh2d_api.node_x == nullptr || mesh2d_api.node_y == nullptr || (mesh2d_api.face_nodes == nullptr && mesh2d_api.face_nodes_long == nullptr))
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_face_locator_create: node_x, node_y and face_nodes are required.");
+            }
+            if (num_threads < 0 || mesh2d_api.num_face_nodes_max < 0)
+            {
+                throw std::invalid_argument("ug_face_locator_create: The number of face nodes and of threads must not be negative.");
             }
 
-            ugrid::Contacts contacts(ugrid_states[file_id].m_ncFile);
-            contacts.define(contacts_api);
-            ugrid_states[file_id].m_contacts.emplace_back(contacts);
-            topology_id = static_cast<int>(ugrid_states[file_id].m_contacts.size()) - 1;
+            auto const num_faces = ugrid::get_mesh2d_count(mesh2d_api.num_faces, mesh2d_api.num_faces_long);
+            auto const num_face_nodes_max = static_cast<size_t>(mesh2d_api.num_face_nodes_max);
+            std::vector<int> face_nodes_buffer;
+            auto const* face_nodes = get_int_connectivity(mesh2d_api.face_nodes,
+                                                          mesh2d_api.face_nodes_long,
+                                                          num_faces * num_face_nodes_max,
+                                                          face_nodes_buffer,
+                                                          "ug_face_locator_create");
+
+            // Built outside the registry lock, queries on other locators are not blocked meanwhile
+            auto locator = std::make_unique<ugrid::FaceLocator>(mesh2d_api.node_x,
+                                                                mesh2d_api.node_y,
+                                                                ugrid::get_mesh2d_count(mesh2d_api.num_nodes, mesh2d_api.num_nodes_long),
+                                                                face_nodes,
+                                                                num_faces,
+                                                                num_face_nodes_max,
+                                                                mesh2d_api.start_index,
+                                                                mesh2d_api.int_fill_value,
+                                                                mesh2d_api.is_spherical != 0,
+                                                                static_cast<size_t>(num_threads));
+
+            std::unique_lock const lock(face_locators_mutex);
+            locator_id = next_face_locator_id++;
+            face_locators.emplace(locator_id, std::move(locator));
         }
         catch (...)
         {
@@ -1145,17 +2367,23 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_contacts_put(int file_id, int topology_id, Contacts const& contacts_api)
+    UGRID_API int ug_face_locator_find_faces(int locator_id, int num_points, double const* x, double const* y, int num_threads, int* faces)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            if (num_points < 0 || num_threads < 0)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_face_locator_find_faces: The number of points and threads must not be negative.");
             }
 
-            ugrid_states[file_id].m_contacts[topology_id].put(contacts_api);
+            std::shared_lock const lock(face_locators_mutex);
+            auto const it = face_locators.find(locator_id);
+            if (it == face_locators.end())
+            {
+                throw std::invalid_argument("ug_face_locator_find_faces: The selected locator_id does not exist.");
+            }
+            it->second->locate(x, y, static_cast<size_t>(num_points), static_cast<size_t>(num_threads), faces);
         }
         catch (...)
         {
@@ -1164,17 +2392,142 @@ namespace ugridapi
         return exit_code;
     }
 
-    UGRID_API int ug_contacts_inq(int file_id, int topology_id, Contacts& contacts_api)
+    UGRID_API int ug_face_locator_destroy(int locator_id)
     {
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            std::unique_lock const lock(face_locators_mutex);
+            if (face_locators.erase(locator_id) == 0)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("ug_face_locator_destroy: The selected locator_id does not exist.");
             }
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_get_face_offsets(int file_id, int topology_id, int* face_offsets)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            get_topology_at(ugrid_states.at(file_id).get_mesh2d(), topology_id);
+            ugrid_states.at(file_id).get_mesh2d()[topology_id].get_face_offsets(face_offsets);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_get_face_connectivity_ragged(int file_id,
+                                                         int topology_id,
+                                                         Mesh2DConnectivity connectivity,
+                                                         int start_index,
+                                                         int const* face_offsets,
+                                                         int* indices)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            get_topology_at(ugrid_states.at(file_id).get_mesh2d(), topology_id);
+            ugrid_states.at(file_id).get_mesh2d()[topology_id].get_ragged_face_connectivity(mesh2d_connectivity_attribute_names.at(connectivity),
+                                                                                            start_index,
+                                                                                            face_offsets,
+                                                                                            indices);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_mesh2d_put_face_connectivity_ragged(int file_id,
+                                                         int topology_id,
+                                                         Mesh2DConnectivity connectivity,
+                                                         int start_index,
+                                                         int const* face_offsets,
+                                                         int const* indices)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+            ugrid_states.at(file_id).check_not_defining("ug_mesh2d_put_face_connectivity_ragged");
+
+            get_topology_at(ugrid_states.at(file_id).get_mesh2d(), topology_id);
+            ugrid_states.at(file_id).get_mesh2d()[topology_id].put_ragged_face_connectivity(mesh2d_connectivity_attribute_names.at(connectivity),
+                                                                                            start_index,
+                                                                                            face_offsets,
+                                                                                            indices);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_contacts_def(int file_id, Contacts const& contacts_api, int& topology_id)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            // Discovers the existing topologies first, a deferred discovery after the definition would also find the new one
+            auto& contacts_topologies = ugrid_states.at(file_id).get_contacts();
+
+            ugrid::Contacts contacts(ugrid_states.at(file_id).m_ncFile);
+            contacts.set_variable_storage(ugrid_states.at(file_id).m_variable_storage);
+            contacts.define(contacts_api);
+            ugrid_states.at(file_id).end_define();
+            ugrid_states.at(file_id).invalidate_variables();
+            contacts_topologies.emplace_back(contacts);
+            topology_id = static_cast<int>(contacts_topologies.size()) - 1;
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_contacts_put(int file_id, int topology_id, Contacts const& contacts_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).check_not_defining("ug_contacts_put");
+            ugrid_states.at(file_id).get_contacts()[topology_id].put(contacts_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_contacts_inq(int file_id, int topology_id, Contacts& contacts_api)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
 
-            ugrid_states[file_id].m_contacts[topology_id].inquire(contacts_api);
+            ugrid_states.at(file_id).get_contacts()[topology_id].inquire(contacts_api);
         }
         catch (...)
         {
@@ -1188,12 +2541,59 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
+            StateLock const lock(file_id);
+
+            ugrid_states.at(file_id).get_contacts()[topology_id].get(contacts_api);
+        }
+        catch (...)
+        {
+            exit_code = HandleExceptions(std::current_exception());
+        }
+        return exit_code;
+    }
+
+    UGRID_API int ug_variable_storage_define(int file_id,
+                                             const char* variable_name,
+                                             int deflate_level,
+                                             int const* chunk_sizes,
+                                             int num_chunk_dimensions)
+    {
+        int exit_code = Success;
+        try
+        {
+            StateLock const lock(file_id);
+            if (!ugrid_states.at(file_id).m_is_netcdf4)
             {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
+                throw std::invalid_argument("UGrid: Chunking and compression are only supported for NetCDF-4 files.");
+            }
+            if (deflate_level < 0 || deflate_level > 9)
+            {
+                throw std::invalid_argument("UGrid: The deflate level must be between 0 and 9.");
+            }
+            if (num_chunk_dimensions > 0 && chunk_sizes == nullptr)
+            {
+                throw std::invalid_argument("UGrid: The chunk sizes are missing.");
+            }
+
+            ugrid::VariableStorage storage;
+            storage.deflate_level = deflate_level;
+            for (int i = 0; i < num_chunk_dimensions; ++i)
+            {
+                if (chunk_sizes[i] <= 0)
+                {
+                    throw std::invalid_argument("UGrid: The chunk sizes must be positive.");
+                }
+                storage.chunk_sizes.emplace_back(static_cast<size_t>(chunk_sizes[i]));
             }
 
-            ugrid_states[file_id].m_contacts[topology_id].get(contacts_api);
+            auto const name = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
+            ugrid_states.at(file_id).m_variable_storage[name] = storage;
+
+            // The variable might already be defined
+            if (const auto* const variable = ugrid_states.at(file_id).find_variable(name); variable != nullptr)
+            {
+                ugrid::apply_variable_storage(*variable, storage);
+            }
         }
         catch (...)
         {
@@ -1207,6 +2607,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             define_variable<int>(file_id, variable_name);
         }
         catch (...)
@@ -1221,6 +2623,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             define_variable<double>(file_id, variable_name);
         }
         catch (...)
@@ -1239,6 +2643,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             define_attribute(file_id, variable_name, att_name, attribute_values, num_values);
         }
         catch (...)
@@ -1257,6 +2663,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             define_attribute(file_id, variable_name, att_name, attribute_values, num_values);
         }
         catch (...)
@@ -1275,6 +2683,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             define_attribute(file_id, variable_name, att_name, attribute_values, num_values);
         }
         catch (...)
@@ -1292,16 +2702,13 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             // Get the attribute name
             const auto attribute_name_str = ugrid::char_array_to_string(attribute_name, ugrid::name_long_length);
 
             // Put the attribute values
-            ugrid_states[file_id].m_ncFile->putAtt(attribute_name_str, netCDF::NcType::nc_CHAR, num_values, attribute_values);
+            ugrid_states.at(file_id).m_ncFile->putAtt(attribute_name_str, netCDF::NcType::nc_CHAR, num_values, attribute_values);
         }
         catch (...)
         {
@@ -1317,16 +2724,13 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
-            if (ugrid_states.count(file_id) == 0)
-            {
-                throw std::invalid_argument("UGrid: The selected file_id does not exist.");
-            }
+            StateLock const lock(file_id);
 
             // Get the attribute name
             const auto attribute_name_str = ugrid::char_array_to_string(attribute_name, ugrid::name_long_length);
 
             // Put the attribute values
-            netCDF::NcGroupAtt attribute = ugrid_states[file_id].m_ncFile->getAtt(attribute_name_str);
+            netCDF::NcGroupAtt attribute = ugrid_states.at(file_id).m_ncFile->getAtt(attribute_name_str);
             std::string value;
             attribute.getValues(value);
             ugrid::string_to_char_array(value, ugrid::name_long_length, attribute_values);
@@ -1343,6 +2747,8 @@ namespace ugridapi
         int exit_code = Success;
         try
         {
+            StateLock const lock(file_id);
+
             if (exists == nullptr)
             {
                 throw std::invalid_argument("UGrid: Output parameter 'exists' is null.");
@@ -1355,9 +2761,7 @@ namespace ugridapi
 
             // Figure attribute name string
             const auto variable_name_str = ugrid::char_array_to_string(variable_name, ugrid::name_long_length);
-            const auto& variable_names = ugrid_states[file_id].m_ncFile->getVars();
-
-            *exists = variable_names.find(variable_name_str) != variable_names.end() ? 1 : 0;
+            *exists = ugrid_states.at(file_id).find_variable(variable_name_str) != nullptr ? 1 : 0;
         }
         catch (...)
         {
@@ -1,19 +1,23 @@
 #define UGRID_API
 
 %include "windows.i"
+%include "stdint.i"
 %include "std_string.i"
 %include "std_vector.i"
 %include "std_map.i"
 %include "std_unordered_map.i"
 %include "std_unique_ptr.i"
 %include "std_shared_ptr.i"
+%include "carrays.i"
 
 %{
   #include "UGridAPI/Mesh1D.hpp"
   #include "UGridAPI/Mesh2D.hpp"
+  #include "UGridAPI/Mesh2DConnectivity.hpp"
   #include "UGridAPI/MeshLocations.hpp"
   #include "UGridAPI/Contacts.hpp"
   #include "UGridAPI/Network1D.hpp"
+  #include "UGridAPI/VariableReadRequest.hpp"
   #include "UGridAPI/UGrid.hpp"
 %}
 
@@ -21,7 +25,11 @@
 
 %include "UGridAPI/Mesh1D.hpp"
 %include "UGridAPI/Mesh2D.hpp"
+%include "UGridAPI/Mesh2DConnectivity.hpp"
 %include "UGridAPI/MeshLocations.hpp"
 %include "UGridAPI/Contacts.hpp"
 %include "UGridAPI/Network1D.hpp"
+%include "UGridAPI/VariableReadRequest.hpp"
+// ug_variable_get_data_double_batch takes an array of requests: fill a VariableReadRequestArray and pass its cast()
+%array_class(ugridapi::VariableReadRequest, VariableReadRequestArray);
 %include "UGridAPI/UGrid.hpp"
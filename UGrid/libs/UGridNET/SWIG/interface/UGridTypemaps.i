@@ -38,6 +38,60 @@ CSHARP_ARRAYS(char, byte)
                      int& file_id);
 %}
 
+%csmethodmodifiers ug_file_open_with_format "public unsafe";
+%apply char FIXED[] { const char* file_path };
+ %{
+    int ug_file_open_with_format(const char* file_path,
+                                 int mode,
+                                 int format,
+                                 int& file_id);
+%}
+
+%csmethodmodifiers ug_file_open_deferred "public unsafe";
+%apply char FIXED[] { const char* file_path };
+ %{
+    int ug_file_open_deferred(const char* file_path,
+                              int mode,
+                              int& file_id);
+%}
+
+%csmethodmodifiers ug_file_open_mapped "public unsafe";
+%apply char FIXED[] { const char* file_path };
+ %{
+    int ug_file_open_mapped(const char* file_path,
+                            int& file_id);
+%}
+
+%csmethodmodifiers ug_file_open_diskless "public unsafe";
+%apply char FIXED[] { const char* file_path };
+ %{
+    int ug_file_open_diskless(const char* file_path,
+                              int mode,
+                              int format,
+                              int& file_id);
+%}
+
+%csmethodmodifiers ug_file_open_memory "public unsafe";
+%apply char FIXED[] { const char* name };
+%apply char FIXED[] { const char* buffer };
+ %{
+    int ug_file_open_memory(const char* name,
+                            const char* buffer,
+                            int64_t buffer_size,
+                            int& file_id);
+%}
+
+%csmethodmodifiers ug_variable_storage_define "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply int FIXED[] { int const* chunk_sizes };
+%{
+    int ug_variable_storage_define(int file_id,
+                                   const char* variable_name,
+                                   int deflate_level,
+                                   int const* chunk_sizes,
+                                   int num_chunk_dimensions);
+%}
+
 %csmethodmodifiers ug_topology_get_data_variables_names "public unsafe";
 %apply char FIXED[] { char* data_variables_names_result } %{
     int ug_topology_get_data_variables_names(int file_id,
@@ -73,6 +127,27 @@ CSHARP_ARRAYS(char, byte)
                                                          const int dimension_value);
 %}
 
+%csmethodmodifiers ug_topology_define_double_record_variable_on_location "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply char FIXED[] { const char* record_dimension_name };
+%{
+    int ug_topology_define_double_record_variable_on_location(int file_id,
+                                                              ugridapi::TopologyType topology_type,
+                                                              int topology_id,
+                                                              ugridapi::MeshLocations location,
+                                                              const char* variable_name,
+                                                              const char* record_dimension_name);
+%}
+
+%csmethodmodifiers ug_variable_append_data_double "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply double FIXED[] { double const* data } %{
+    int ug_variable_append_data_double(int file_id,
+                                       const char* variable_name,
+                                       double const* data,
+                                       int& record_index);
+%}
+
 %csmethodmodifiers ug_variable_count_attributes "public unsafe";
 %csmethodmodifiers ug_variable_count_dimensions "public unsafe";
 %csmethodmodifiers ug_variable_int_define "public unsafe";
@@ -144,6 +219,78 @@ int ug_variable_get_attributes_max_length(int file_id,
 %csmethodmodifiers ug_variable_put_data_int "public unsafe";
 %csmethodmodifiers ug_variable_put_data_char "public unsafe";
 
+%csmethodmodifiers ug_variable_get_data_double_slice "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply int FIXED[] { int const* start, int const* count, int const* stride };
+%apply double FIXED[] { double* data } %{
+    int ug_variable_get_data_double_slice(int file_id,
+                                          const char* variable_name,
+                                          int const* start,
+                                          int const* count,
+                                          int const* stride,
+                                          double* data);
+%}
+
+%csmethodmodifiers ug_variable_get_data_int_slice "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply int FIXED[] { int const* start, int const* count, int const* stride };
+%apply int FIXED[] { int* data } %{
+    int ug_variable_get_data_int_slice(int file_id,
+                                       const char* variable_name,
+                                       int const* start,
+                                       int const* count,
+                                       int const* stride,
+                                       int* data);
+%}
+
+%csmethodmodifiers ug_variable_get_data_char_slice "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply int FIXED[] { int const* start, int const* count, int const* stride };
+%apply char FIXED[] { char* data } %{
+    int ug_variable_get_data_char_slice(int file_id,
+                                        const char* variable_name,
+                                        int const* start,
+                                        int const* count,
+                                        int const* stride,
+                                        char* data);
+%}
+
+%csmethodmodifiers ug_variable_put_data_double_slice "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply int FIXED[] { int const* start, int const* count, int const* stride };
+%apply double FIXED[] { double const* data } %{
+    int ug_variable_put_data_double_slice(int file_id,
+                                          const char* variable_name,
+                                          int const* start,
+                                          int const* count,
+                                          int const* stride,
+                                          double const* data);
+%}
+
+%csmethodmodifiers ug_variable_put_data_int_slice "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply int FIXED[] { int const* start, int const* count, int const* stride };
+%apply int FIXED[] { int const* data } %{
+    int ug_variable_put_data_int_slice(int file_id,
+                                       const char* variable_name,
+                                       int const* start,
+                                       int const* count,
+                                       int const* stride,
+                                       int const* data);
+%}
+
+%csmethodmodifiers ug_variable_put_data_char_slice "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply int FIXED[] { int const* start, int const* count, int const* stride };
+%apply char FIXED[] { char const* data } %{
+    int ug_variable_put_data_char_slice(int file_id,
+                                        const char* variable_name,
+                                        int const* start,
+                                        int const* count,
+                                        int const* stride,
+                                        char const* data);
+%}
+
 %csmethodmodifiers ug_variable_inq "public unsafe";
 %apply char FIXED[] { const char* variable_name };
 %apply int FIXED[] { int* exists } %{
@@ -160,6 +307,159 @@ int ug_variable_get_attributes_max_length(int file_id,
                                         int* dimension_vec);
 %}
 
+%csmethodmodifiers ug_variable_get_data_dimensions_long "public unsafe";
+%apply char FIXED[] { const char* variable_name };
+%apply long long FIXED[] {int64_t *dimension_vec} %{
+    int ug_variable_get_data_dimensions_long(int file_id,
+                                             const char* variable_name,
+                                             int64_t* dimension_vec);
+%}
+
+%csmethodmodifiers ug_mesh2d_build_node_faces "public unsafe";
+%apply int FIXED[] {int* node_face_offsets}
+%apply int FIXED[] {int* node_faces} %{
+    int ug_mesh2d_build_node_faces(Mesh2D const& mesh2d_api,
+                                   int num_threads,
+                                   int* node_face_offsets,
+                                   int* node_faces);
+%}
+
+%csmethodmodifiers ug_mesh2d_build_node_edges "public unsafe";
+%apply int FIXED[] {int* node_edge_offsets}
+%apply int FIXED[] {int* node_edges} %{
+    int ug_mesh2d_build_node_edges(Mesh2D const& mesh2d_api,
+                                   int num_threads,
+                                   int* node_edge_offsets,
+                                   int* node_edges);
+%}
+
+%csmethodmodifiers ug_mesh2d_get_face_offsets "public unsafe";
+%apply int FIXED[] {int* face_offsets} %{
+    int ug_mesh2d_get_face_offsets(int file_id,
+                                   int topology_id,
+                                   int* face_offsets);
+%}
+
+%csmethodmodifiers ug_mesh2d_get_face_connectivity_ragged "public unsafe";
+%apply int FIXED[] {int const* face_offsets}
+%apply int FIXED[] {int* indices} %{
+    int ug_mesh2d_get_face_connectivity_ragged(int file_id,
+                                               int topology_id,
+                                               Mesh2DConnectivity connectivity,
+                                               int start_index,
+                                               int const* face_offsets,
+                                               int* indices);
+%}
+
+%csmethodmodifiers ug_mesh2d_put_face_connectivity_ragged "public unsafe";
+%apply int FIXED[] {int const* face_offsets}
+%apply int FIXED[] {int const* indices} %{
+    int ug_mesh2d_put_face_connectivity_ragged(int file_id,
+                                               int topology_id,
+                                               Mesh2DConnectivity connectivity,
+                                               int start_index,
+                                               int const* face_offsets,
+                                               int const* indices);
+%}
+
+%csmethodmodifiers ug_mesh2d_extract_bounding_box "public unsafe";
+%apply char FIXED[] { const char* output_file_path };
+ %{
+    int ug_mesh2d_extract_bounding_box(int file_id,
+                                       int topology_id,
+                                       double min_x,
+                                       double min_y,
+                                       double max_x,
+                                       double max_y,
+                                       const char* output_file_path,
+                                       int& num_faces);
+%}
+
+%csmethodmodifiers ug_mesh2d_extract_polygon "public unsafe";
+%apply double FIXED[] {double const* polygon_x}
+%apply double FIXED[] {double const* polygon_y}
+%apply char FIXED[] { const char* output_file_path };
+ %{
+    int ug_mesh2d_extract_polygon(int file_id,
+                                  int topology_id,
+                                  int num_polygon_nodes,
+                                  double const* polygon_x,
+                                  double const* polygon_y,
+                                  const char* output_file_path,
+                                  int& num_faces);
+%}
+
+%csmethodmodifiers ug_mesh2d_partition_faces "public unsafe";
+%apply int FIXED[] {int* face_domains} %{
+    int ug_mesh2d_partition_faces(Mesh2D const& mesh2d_api,
+                                  int num_domains,
+                                  int num_threads,
+                                  int* face_domains);
+%}
+
+%csmethodmodifiers ug_mesh2d_write_partitions "public unsafe";
+%apply int FIXED[] {int const* face_domains}
+%apply char FIXED[] { const char* output_file_prefix };
+ %{
+    int ug_mesh2d_write_partitions(int file_id,
+                                   int topology_id,
+                                   int num_domains,
+                                   int num_ghost_layers,
+                                   int const* face_domains,
+                                   const char* output_file_prefix,
+                                   int num_threads);
+%}
+
+%csmethodmodifiers ug_mesh2d_merge_partitions "public unsafe";
+%apply char FIXED[] { const char* input_file_prefix };
+%apply char FIXED[] { const char* input_file_suffix };
+%apply char FIXED[] { const char* output_file_path };
+ %{
+    int ug_mesh2d_merge_partitions(const char* input_file_prefix,
+                                   const char* input_file_suffix,
+                                   int num_domains,
+                                   int topology_id,
+                                   double tolerance,
+                                   const char* output_file_path,
+                                   int num_threads,
+                                   int& num_faces);
+%}
+
+%csmethodmodifiers ug_mesh2d_renumber_hilbert "public unsafe";
+%apply int FIXED[] {int* node_permutation}
+%apply int FIXED[] {int* edge_permutation}
+%apply int FIXED[] {int* face_permutation}
+ %{
+    int ug_mesh2d_renumber_hilbert(Mesh2D& mesh2d_api,
+                                   int num_threads,
+                                   int* node_permutation,
+                                   int* edge_permutation,
+                                   int* face_permutation);
+%}
+
+%csmethodmodifiers ug_mesh2d_permute_data_double "public unsafe";
+%apply int FIXED[] {int const* permutation}
+%apply double FIXED[] {double* values}
+ %{
+    int ug_mesh2d_permute_data_double(int const* permutation,
+                                      int num_entities,
+                                      int num_values_per_entity,
+                                      int start_index,
+                                      double* values);
+%}
+
+%csmethodmodifiers ug_face_locator_find_faces "public unsafe";
+%apply double FIXED[] {double const* x}
+%apply double FIXED[] {double const* y}
+%apply int FIXED[] {int* faces} %{
+    int ug_face_locator_find_faces(int locator_id,
+                                   int num_points,
+                                   double const* x,
+                                   double const* y,
+                                   int num_threads,
+                                   int* faces);
+%}
+
 
 %csmethodmodifiers ug_attribute_int_define "public unsafe";
 %apply char FIXED[] { const char* variable_name };
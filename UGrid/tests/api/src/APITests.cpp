@@ -1,7 +1,16 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <thread>
+
 #include <TestUtils/Definitions.hpp>
+#include <TestUtils/MeshGenerator.hpp>
 #include <TestUtils/Utils.hpp>
 #include <UGridAPI/UGrid.hpp>
 
@@ -1584,4 +1593,2100 @@ TEST(ApiTest, DefineAndPutGeometryVariable_OnMesh2D_ShouldDefineGeometryVariable
     // Close the file
     error_code = ugridapi::ug_file_close(file_id);
     ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
-}
\ No newline at end of file
+}
+TEST(ApiTest, DefineAndPut_OneMesh2DInNetCDF4FormatWithCompression_ShouldReadBackData)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/CompressedMesh2D.nc";
+
+    // Open a file in NetCDF-4 format
+    int file_id = -1;
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_format = -1;
+    error_code = ugridapi::ug_file_netcdf4_format(file_format);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open_with_format(file_path.c_str(), file_mode, file_format, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    int name_long_length;
+    error_code = ugridapi::ug_name_get_long_length(name_long_length);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Register chunking and compression before the variables are defined
+    std::vector<char> face_nodes_name(name_long_length);
+    string_to_char_array("mesh2d_face_nodes", name_long_length, face_nodes_name.data());
+    std::vector<int> face_nodes_chunks{3, 4};
+    error_code = ugridapi::ug_variable_storage_define(file_id, face_nodes_name.data(), 5, face_nodes_chunks.data(), static_cast<int>(face_nodes_chunks.size()));
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<char> variable_name(name_long_length);
+    string_to_char_array("mesh2d_s0", name_long_length, variable_name.data());
+    std::vector<int> variable_chunks{16, 1};
+    error_code = ugridapi::ug_variable_storage_define(file_id, variable_name.data(), 9, variable_chunks.data(), static_cast<int>(variable_chunks.size()));
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    create_ugrid_mesh("mesh2d", file_id);
+
+    std::vector<char> dimension_name(name_long_length);
+    string_to_char_array("numTimeSteps", name_long_length, dimension_name.data());
+    const int num_time_steps = 3;
+    const int num_nodes = 16;
+    error_code = ugridapi::ug_topology_define_double_variable_on_location(file_id,
+                                                                          ugridapi::TopologyType::Mesh2dTopology,
+                                                                          0,
+                                                                          ugridapi::MeshLocations::Nodes,
+                                                                          variable_name.data(),
+                                                                          dimension_name.data(),
+                                                                          num_time_steps);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<double> s0_data(num_time_steps * num_nodes);
+    for (size_t i = 0; i < s0_data.size(); ++i)
+    {
+        s0_data[i] = static_cast<double>(i) * 0.5;
+    }
+    error_code = ugridapi::ug_variable_put_data_double(file_id, variable_name.data(), s0_data.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Re-open and read back
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    ugridapi::Mesh2D mesh2d;
+    error_code = ug_mesh2d_inq(file_id, 0, mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(9, mesh2d.num_faces);
+
+    std::vector<int> face_nodes(mesh2d.num_faces * mesh2d.num_face_nodes_max);
+    mesh2d.face_nodes = face_nodes.data();
+    error_code = ug_mesh2d_get(file_id, 0, mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<int> face_nodes_expected{
+        1, 2, 4, 3,
+        3, 4, 6, 5,
+        5, 6, 8, 7,
+        2, 9, 10, 4,
+        4, 10, 11, 6,
+        6, 11, 12, 8,
+        9, 13, 14, 10,
+        10, 14, 15, 11,
+        11, 15, 16, 12};
+    ASSERT_THAT(face_nodes, ::testing::ContainerEq(face_nodes_expected));
+
+    std::vector<double> s0_read(num_time_steps * num_nodes);
+    error_code = ugridapi::ug_variable_get_data_double(file_id, variable_name.data(), s0_read.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_THAT(s0_read, ::testing::ContainerEq(s0_data));
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, DefineVariableStorage_OnClassicFile_ShouldFail)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/ClassicStorage.nc";
+
+    int file_id = -1;
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_face_nodes", ugridapi::name_long_length, variable_name.data());
+    error_code = ugridapi::ug_variable_storage_define(file_id, variable_name.data(), 5, nullptr, 0);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, PutAndGetDataSlice_OnNodeVariable_ShouldReadBackSelection)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/DataSlice.nc";
+
+    int file_id = -1;
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    create_ugrid_mesh("mesh2d", file_id);
+
+    int name_long_length;
+    error_code = ugridapi::ug_name_get_long_length(name_long_length);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<char> variable_name(name_long_length);
+    string_to_char_array("mesh2d_s0", name_long_length, variable_name.data());
+    std::vector<char> dimension_name(name_long_length);
+    string_to_char_array("numTimeSteps", name_long_length, dimension_name.data());
+    const int num_time_steps = 3;
+    const int num_nodes = 16;
+    error_code = ugridapi::ug_topology_define_double_variable_on_location(file_id,
+                                                                          ugridapi::TopologyType::Mesh2dTopology,
+                                                                          0,
+                                                                          ugridapi::MeshLocations::Nodes,
+                                                                          variable_name.data(),
+                                                                          dimension_name.data(),
+                                                                          num_time_steps);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Write one time step at a time
+    for (int t = 0; t < num_time_steps; ++t)
+    {
+        std::vector<double> time_step(num_nodes);
+        for (int n = 0; n < num_nodes; ++n)
+        {
+            time_step[n] = t * 100.0 + n;
+        }
+        std::vector<int> start{t, 0};
+        std::vector<int> count{1, num_nodes};
+        error_code = ugridapi::ug_variable_put_data_double_slice(file_id, variable_name.data(), start.data(), count.data(), nullptr, time_step.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Read a single time step
+    {
+        std::vector<int> start{1, 0};
+        std::vector<int> count{1, num_nodes};
+        std::vector<double> data(num_nodes);
+        error_code = ugridapi::ug_variable_get_data_double_slice(file_id, variable_name.data(), start.data(), count.data(), nullptr, data.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        for (int n = 0; n < num_nodes; ++n)
+        {
+            ASSERT_DOUBLE_EQ(100.0 + n, data[n]);
+        }
+    }
+
+    // Read the time series of a single node
+    {
+        std::vector<int> start{0, 5};
+        std::vector<int> count{num_time_steps, 1};
+        std::vector<double> data(num_time_steps);
+        error_code = ugridapi::ug_variable_get_data_double_slice(file_id, variable_name.data(), start.data(), count.data(), nullptr, data.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<double> const expected{5.0, 105.0, 205.0};
+        ASSERT_THAT(data, ::testing::ContainerEq(expected));
+    }
+
+    // Read every fourth node of the last time step
+    {
+        std::vector<int> start{2, 1};
+        std::vector<int> count{1, 4};
+        std::vector<int> stride{1, 4};
+        std::vector<double> data(4);
+        error_code = ugridapi::ug_variable_get_data_double_slice(file_id, variable_name.data(), start.data(), count.data(), stride.data(), data.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<double> const expected{201.0, 205.0, 209.0, 213.0};
+        ASSERT_THAT(data, ::testing::ContainerEq(expected));
+    }
+
+    // A selection outside the variable is rejected
+    {
+        std::vector<int> start{0, 10};
+        std::vector<int> count{1, 4};
+        std::vector<int> stride{1, 2};
+        std::vector<double> data(4);
+        error_code = ugridapi::ug_variable_get_data_double_slice(file_id, variable_name.data(), start.data(), count.data(), stride.data(), data.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+    }
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, AppendData_OnRecordVariable_ShouldGrowUnlimitedDimension)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/AppendRecords.nc";
+
+    int file_id = -1;
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    create_ugrid_mesh("mesh2d", file_id);
+
+    // Two variables sharing the record dimension
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_waterlevel", ugridapi::name_long_length, variable_name.data());
+    std::vector<char> second_variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_discharge", ugridapi::name_long_length, second_variable_name.data());
+    std::vector<char> dimension_name(ugridapi::name_long_length);
+    string_to_char_array("time", ugridapi::name_long_length, dimension_name.data());
+    for (auto const* name : {variable_name.data(), second_variable_name.data()})
+    {
+        error_code = ugridapi::ug_topology_define_double_record_variable_on_location(file_id,
+                                                                                     ugridapi::TopologyType::Mesh2dTopology,
+                                                                                     0,
+                                                                                     ugridapi::MeshLocations::Faces,
+                                                                                     name,
+                                                                                     dimension_name.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+
+    const int num_faces = 9;
+    auto make_record = [](int record, double offset)
+    {
+        std::vector<double> values(num_faces);
+        for (int f = 0; f < num_faces; ++f)
+        {
+            values[f] = offset + record * 10.0 + f;
+        }
+        return values;
+    };
+    double const second_offset = 1000.0;
+
+    for (int record = 0; record < 3; ++record)
+    {
+        auto const values = make_record(record, 0.0);
+        int record_index = -1;
+        error_code = ugridapi::ug_variable_append_data_double(file_id, variable_name.data(), values.data(), record_index);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ASSERT_EQ(record, record_index);
+
+        auto const second_values = make_record(record, second_offset);
+        error_code = ugridapi::ug_variable_append_data_double(file_id, second_variable_name.data(), second_values.data(), record_index);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ASSERT_EQ(record, record_index);
+    }
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Re-open for writing and continue after the existing records
+    error_code = ugridapi::ug_file_write_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // The first append grows the record dimension, the second variable still continues at its own next record
+    auto const last_values = make_record(3, 0.0);
+    int record_index = -1;
+    error_code = ugridapi::ug_variable_append_data_double(file_id, variable_name.data(), last_values.data(), record_index);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(3, record_index);
+    auto const second_last_values = make_record(3, second_offset);
+    error_code = ugridapi::ug_variable_append_data_double(file_id, second_variable_name.data(), second_last_values.data(), record_index);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(3, record_index);
+
+    std::vector<int> dimensions(2);
+    error_code = ugridapi::ug_variable_get_data_dimensions(file_id, variable_name.data(), dimensions.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(4, dimensions[0]);
+    ASSERT_EQ(num_faces, dimensions[1]);
+
+    std::vector<double> data(4 * num_faces);
+    error_code = ugridapi::ug_variable_get_data_double(file_id, variable_name.data(), data.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (int record = 0; record < 4; ++record)
+    {
+        auto const expected = make_record(record, 0.0);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), data.begin() + record * num_faces));
+    }
+
+    error_code = ugridapi::ug_variable_get_data_dimensions(file_id, second_variable_name.data(), dimensions.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(4, dimensions[0]);
+    error_code = ugridapi::ug_variable_get_data_double(file_id, second_variable_name.data(), data.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (int record = 0; record < 4; ++record)
+    {
+        auto const expected = make_record(record, second_offset);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), data.begin() + record * num_faces));
+    }
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, VariableInq_AfterDefiningTopologyAndVariables_ShouldFindNewVariables)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/VariableIndex.nc";
+
+    int file_id = -1;
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_face_nodes", ugridapi::name_long_length, variable_name.data());
+    int exists = -1;
+    error_code = ugridapi::ug_variable_inq(file_id, variable_name.data(), &exists);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(0, exists);
+
+    // Variables defined by a topology are visible after the definition
+    create_ugrid_mesh("mesh2d", file_id);
+    error_code = ugridapi::ug_variable_inq(file_id, variable_name.data(), &exists);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(1, exists);
+
+    // Variables defined directly are visible immediately
+    string_to_char_array("scalar_variable", ugridapi::name_long_length, variable_name.data());
+    error_code = ugridapi::ug_variable_double_define(file_id, variable_name.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_variable_inq(file_id, variable_name.data(), &exists);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(1, exists);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, GetDataVariablesNames_AfterDefiningVariables_ShouldReturnSortedNamesPerLocation)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/DataVariablesIndex.nc";
+
+    int file_id = -1;
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    create_ugrid_mesh("mesh2d", file_id);
+
+    auto count_face_variables = [&file_id]()
+    {
+        int count = -1;
+        auto const code = ugridapi::ug_topology_count_data_variables(file_id, ugridapi::TopologyType::Mesh2dTopology, 0, ugridapi::MeshLocations::Faces, count);
+        EXPECT_EQ(ugridapi::UGridioApiErrors::Success, code);
+        return count;
+    };
+    int const num_topology_face_variables = count_face_variables();
+
+    std::vector<char> dimension_name(ugridapi::name_long_length);
+    string_to_char_array("numTimeSteps", ugridapi::name_long_length, dimension_name.data());
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    for (auto const& name : {"mesh2d_zeta", "mesh2d_alpha"})
+    {
+        string_to_char_array(name, ugridapi::name_long_length, variable_name.data());
+        error_code = ugridapi::ug_topology_define_double_variable_on_location(file_id,
+                                                                              ugridapi::TopologyType::Mesh2dTopology,
+                                                                              0,
+                                                                              ugridapi::MeshLocations::Faces,
+                                                                              variable_name.data(),
+                                                                              dimension_name.data(),
+                                                                              2);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+    ASSERT_EQ(num_topology_face_variables + 2, count_face_variables());
+
+    // A variable assigned to a mesh location through its attributes is indexed as well
+    string_to_char_array("mesh2d_beta", ugridapi::name_long_length, variable_name.data());
+    error_code = ugridapi::ug_variable_double_define(file_id, variable_name.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(num_topology_face_variables + 2, count_face_variables());
+
+    std::vector<char> attribute_name(ugridapi::name_long_length);
+    string_to_char_array("mesh", ugridapi::name_long_length, attribute_name.data());
+    error_code = ugridapi::ug_attribute_char_define(file_id, variable_name.data(), attribute_name.data(), "mesh2d", 6);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    string_to_char_array("location", ugridapi::name_long_length, attribute_name.data());
+    error_code = ugridapi::ug_attribute_char_define(file_id, variable_name.data(), attribute_name.data(), "face", 4);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    int const num_face_variables = count_face_variables();
+    ASSERT_EQ(num_topology_face_variables + 3, num_face_variables);
+
+    std::vector<char> names(num_face_variables * ugridapi::name_long_length);
+    error_code = ugridapi::ug_topology_get_data_variables_names(file_id, ugridapi::TopologyType::Mesh2dTopology, 0, ugridapi::MeshLocations::Faces, names.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    auto names_vector = split_string(std::string(names.data(), names.size()), num_face_variables, ugridapi::name_long_length);
+    right_trim_string_vector(names_vector);
+    ASSERT_TRUE(std::is_sorted(names_vector.begin(), names_vector.end()));
+    for (auto const& name : {"mesh2d_alpha", "mesh2d_beta", "mesh2d_zeta"})
+    {
+        ASSERT_NE(std::find(names_vector.begin(), names_vector.end(), name), names_vector.end());
+    }
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, CountDataVariables_WithInvalidTopologyId_ShouldFail)
+{
+    std::string const file_path = TEST_FOLDER + "/OneMesh2D.nc";
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    int data_variable_count = -1;
+    error_code = ugridapi::ug_topology_count_data_variables(file_id, ugridapi::TopologyType::Mesh2dTopology, 0, ugridapi::MeshLocations::Faces, data_variable_count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_topology_count_data_variables(file_id, ugridapi::TopologyType::Mesh2dTopology, 1, ugridapi::MeshLocations::Faces, data_variable_count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    error_code = ugridapi::ug_topology_count_data_variables(file_id, ugridapi::TopologyType::Mesh2dTopology, -1, ugridapi::MeshLocations::Faces, data_variable_count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, OpenReadAndClose_FromMultipleThreads_ShouldSucceed)
+{
+    std::string const file_path = TEST_FOLDER + "/OneMesh2D.nc";
+    int constexpr num_threads = 8;
+    int constexpr num_iterations = 20;
+
+    std::atomic<int> num_failures{0};
+    auto const worker = [&](int thread_index)
+    {
+        int file_mode = -1;
+        ugridapi::ug_file_read_mode(file_mode);
+
+        for (int iteration = 0; iteration < num_iterations; ++iteration)
+        {
+            int file_id = -1;
+            if (ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id) != ugridapi::UGridioApiErrors::Success)
+            {
+                ++num_failures;
+                continue;
+            }
+
+            ugridapi::Mesh2D mesh2d;
+            bool success = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d) == ugridapi::UGridioApiErrors::Success;
+
+            std::vector<double> node_x(mesh2d.num_nodes);
+            std::vector<double> node_y(mesh2d.num_nodes);
+            std::vector<int> face_nodes(mesh2d.num_faces * mesh2d.num_face_nodes_max);
+            mesh2d.node_x = node_x.data();
+            mesh2d.node_y = node_y.data();
+            mesh2d.face_nodes = face_nodes.data();
+            success = success && ugridapi::ug_mesh2d_get(file_id, 0, mesh2d) == ugridapi::UGridioApiErrors::Success;
+
+            int data_variable_count = 0;
+            success = success && ugridapi::ug_topology_count_data_variables(file_id,
+                                                                            ugridapi::TopologyType::Mesh2dTopology,
+                                                                            0,
+                                                                            ugridapi::MeshLocations::Faces,
+                                                                            data_variable_count) == ugridapi::UGridioApiErrors::Success;
+
+            // Errors are reported per thread
+            int const invalid_file_id = -1000 - thread_index;
+            success = success && ugridapi::ug_file_close(invalid_file_id) == ugridapi::UGridioApiErrors::Exception;
+            std::vector<char> error_message(ugridapi::error_message_buffer_size);
+            ugridapi::ug_error_get(error_message.data());
+            success = success && std::string(error_message.data()) == "UGrid: The selected file_id does not exist.";
+
+            success = ugridapi::ug_file_close(file_id) == ugridapi::UGridioApiErrors::Success && success;
+            if (!success)
+            {
+                ++num_failures;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(0, num_failures.load());
+}
+
+TEST(ApiTest, GetDataDoubleBatch_FromTwoFiles_ShouldReadAllRequestsAndReportFailures)
+{
+    int const num_time_steps = 2;
+    int const num_nodes = 16;
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_s0", ugridapi::name_long_length, variable_name.data());
+    std::vector<char> dimension_name(ugridapi::name_long_length);
+    string_to_char_array("numTimeSteps", ugridapi::name_long_length, dimension_name.data());
+
+    // Write two files with different data
+    std::vector<std::string> const file_paths{TEST_WRITE_FOLDER + "/BatchRead0.nc", TEST_WRITE_FOLDER + "/BatchRead1.nc"};
+    for (size_t f = 0; f < file_paths.size(); ++f)
+    {
+        int file_mode = -1;
+        ugridapi::ug_file_replace_mode(file_mode);
+        int file_id = -1;
+        auto error_code = ugridapi::ug_file_open(file_paths[f].c_str(), file_mode, file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        create_ugrid_mesh("mesh2d", file_id);
+        error_code = ugridapi::ug_topology_define_double_variable_on_location(file_id,
+                                                                              ugridapi::TopologyType::Mesh2dTopology,
+                                                                              0,
+                                                                              ugridapi::MeshLocations::Nodes,
+                                                                              variable_name.data(),
+                                                                              dimension_name.data(),
+                                                                              num_time_steps);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<double> data(num_time_steps * num_nodes);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = static_cast<double>(f * 1000 + i);
+        }
+        error_code = ugridapi::ug_variable_put_data_double(file_id, variable_name.data(), data.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        error_code = ugridapi::ug_file_close(file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+
+    // Open both files for reading
+    std::vector<int> file_ids(file_paths.size());
+    for (size_t f = 0; f < file_paths.size(); ++f)
+    {
+        int file_mode = -1;
+        ugridapi::ug_file_read_mode(file_mode);
+        auto const error_code = ugridapi::ug_file_open(file_paths[f].c_str(), file_mode, file_ids[f]);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+
+    std::vector<char> missing_variable_name(ugridapi::name_long_length);
+    string_to_char_array("not_a_variable", ugridapi::name_long_length, missing_variable_name.data());
+
+    std::vector<double> whole_variable(num_time_steps * num_nodes);
+    std::vector<double> second_time_step(num_nodes);
+    std::vector<int> start{1, 0};
+    std::vector<int> count{1, num_nodes};
+    std::vector<double> missing(1);
+
+    std::vector<ugridapi::VariableReadRequest> requests(3);
+    requests[0].file_id = file_ids[0];
+    requests[0].variable_name = variable_name.data();
+    requests[0].data = whole_variable.data();
+    requests[1].file_id = file_ids[1];
+    requests[1].variable_name = variable_name.data();
+    requests[1].data = second_time_step.data();
+    requests[1].start = start.data();
+    requests[1].count = count.data();
+    requests[2].file_id = file_ids[1];
+    requests[2].variable_name = missing_variable_name.data();
+    requests[2].data = missing.data();
+
+    // Malformed requests fail on their own, without affecting the others
+    ugridapi::VariableReadRequest null_buffer_request;
+    null_buffer_request.file_id = file_ids[0];
+    null_buffer_request.variable_name = variable_name.data();
+    requests.emplace_back(null_buffer_request);
+    ugridapi::VariableReadRequest null_name_request;
+    null_name_request.file_id = file_ids[1];
+    null_name_request.data = missing.data();
+    requests.emplace_back(null_name_request);
+
+    auto error_code = ugridapi::ug_variable_get_data_double_batch(requests.data(), static_cast<int>(requests.size()), 2);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, requests[0].status);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, requests[1].status);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, requests[2].status);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, requests[3].status);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, requests[4].status);
+
+    for (int i = 0; i < num_time_steps * num_nodes; ++i)
+    {
+        ASSERT_DOUBLE_EQ(static_cast<double>(i), whole_variable[i]);
+    }
+    for (int n = 0; n < num_nodes; ++n)
+    {
+        ASSERT_DOUBLE_EQ(static_cast<double>(1000 + num_nodes + n), second_time_step[n]);
+    }
+
+    for (auto const file_id : file_ids)
+    {
+        error_code = ugridapi::ug_file_close(file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+}
+
+TEST(ApiTest, OpenDeferred_AllUGridEntities_ShouldDiscoverTheSameTopologiesOnFirstUse)
+{
+    std::string const file_path = TEST_FOLDER + "/AllUGridEntities.nc";
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    int eager_file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, eager_file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int deferred_file_id = -1;
+    error_code = ugridapi::ug_file_open_deferred(file_path.c_str(), file_mode, deferred_file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Reading a data variable does not need any topology
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("1dmesh_edge_nodes", ugridapi::name_long_length, variable_name.data());
+    int exists = 0;
+    error_code = ugridapi::ug_variable_inq(deferred_file_id, variable_name.data(), &exists);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(1, exists);
+
+    for (auto const topology_type : {ugridapi::TopologyType::Mesh1dTopology,
+                                     ugridapi::TopologyType::Network1dTopology,
+                                     ugridapi::TopologyType::Mesh2dTopology,
+                                     ugridapi::TopologyType::ContactsTopology})
+    {
+        int eager_count = -1;
+        error_code = ugridapi::ug_topology_get_count(eager_file_id, topology_type, eager_count);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        int deferred_count = -1;
+        error_code = ugridapi::ug_topology_get_count(deferred_file_id, topology_type, deferred_count);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ASSERT_EQ(eager_count, deferred_count);
+    }
+
+    ugridapi::Mesh1D mesh1d;
+    error_code = ugridapi::ug_mesh1d_inq(deferred_file_id, 0, mesh1d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(25, mesh1d.num_nodes);
+    ASSERT_EQ(24, mesh1d.num_edges);
+
+    error_code = ugridapi::ug_file_close(deferred_file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(eager_file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, OpenDeferred_DefineInWriteMode_ShouldNotDuplicateTheNewTopology)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/DeferredWriteEntities.nc";
+    std::filesystem::copy_file(TEST_FOLDER + "/AllUGridEntities.nc", file_path, std::filesystem::copy_options::overwrite_existing);
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int mesh2d_count = -1;
+    error_code = ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::Mesh2dTopology, mesh2d_count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int network1d_count = -1;
+    error_code = ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::Network1dTopology, network1d_count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // No topology is discovered before the definitions
+    error_code = ugridapi::ug_file_write_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open_deferred(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    auto const mesh2d = generate_mixed_polygons("added_mesh2d", 6, 4, 5, 3);
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d_count, topology_id);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    auto const network1d = generate_dendritic_network1d("added_network1d", 10, 3);
+    error_code = ugridapi::ug_network1d_def(file_id, network1d.network1d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(network1d_count, topology_id);
+
+    int count = -1;
+    error_code = ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::Mesh2dTopology, count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d_count + 1, count);
+    error_code = ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::Network1dTopology, count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(network1d_count + 1, count);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // The file holds the new topology once
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::Mesh2dTopology, count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d_count + 1, count);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, BeginAndCommitDefine_WithHeaderPadding_ShouldRejectWritesUntilCommitted)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/BatchDefine.nc";
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_begin_define(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_begin_define(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    std::vector<char> first_name(ugridapi::name_long_length);
+    string_to_char_array("first", ugridapi::name_long_length, first_name.data());
+    error_code = ugridapi::ug_variable_double_define(file_id, first_name.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<char> second_name(ugridapi::name_long_length);
+    string_to_char_array("second", ugridapi::name_long_length, second_name.data());
+    error_code = ugridapi::ug_variable_double_define(file_id, second_name.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Writing would leave define mode, so it is rejected until the batch is committed
+    double const first_value = 1.5;
+    error_code = ugridapi::ug_variable_put_data_double(file_id, first_name.data(), &first_value);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    int const header_free_space = 4096;
+    error_code = ugridapi::ug_file_commit_define(file_id, header_free_space, 4, 0, 4);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_commit_define(file_id, header_free_space, 4, 0, 4);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    error_code = ugridapi::ug_variable_put_data_double(file_id, first_name.data(), &first_value);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    double const second_value = 2.5;
+    error_code = ugridapi::ug_variable_put_data_double(file_id, second_name.data(), &second_value);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // The reserved header space precedes the data
+    ASSERT_GT(std::filesystem::file_size(file_path), static_cast<std::uintmax_t>(header_free_space));
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    double value = 0.0;
+    error_code = ugridapi::ug_variable_get_data_double(file_id, second_name.data(), &value);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_DOUBLE_EQ(second_value, value);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, DefineAndPut_GeneratedMixedPolygonsAndNetwork_ShouldReadBackMesh2D)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/GeneratedEntities.nc";
+
+    // The same seed gives the same mesh
+    auto const mesh2d = generate_mixed_polygons("mesh2d", 20, 10, 6, 7);
+    ASSERT_EQ(mesh2d.face_nodes, generate_mixed_polygons("mesh2d", 20, 10, 6, 7).face_nodes);
+    auto const network1d = generate_dendritic_network1d("network1d", 50, 7);
+    auto const mesh1d = generate_mesh1d("mesh1d", network1d, 3);
+    auto const contacts = generate_contacts("contacts", mesh1d, mesh2d, 25, 7);
+    ASSERT_EQ(1 + 3 * 50, mesh1d.mesh1d.num_nodes);
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_network1d_def(file_id, network1d.network1d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_network1d_put(file_id, topology_id, network1d.network1d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh1d_def(file_id, mesh1d.mesh1d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh1d_put(file_id, topology_id, mesh1d.mesh1d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_contacts_def(file_id, contacts.contacts, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_contacts_put(file_id, topology_id, contacts.contacts);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Read back the mixed polygons
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    ugridapi::Mesh2D mesh2d_api;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.mesh2d.num_faces, mesh2d_api.num_faces);
+    ASSERT_EQ(mesh2d.mesh2d.num_edges, mesh2d_api.num_edges);
+    ASSERT_EQ(6, mesh2d_api.num_face_nodes_max);
+
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<int> face_nodes(mesh2d.face_nodes.size());
+    mesh2d_api.name = name.data();
+    mesh2d_api.face_nodes = face_nodes.data();
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.face_nodes, face_nodes);
+
+    int contacts_count = 0;
+    error_code = ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::ContactsTopology, contacts_count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(1, contacts_count);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, GetMesh2D_WithOneBasedStartIndex_ShouldOffsetIndicesButNotFillValues)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/StartIndexConversion.nc";
+
+    // Mixed polygons pad the faces with fill values
+    auto const mesh2d = generate_mixed_polygons("mesh2d", 17, 9, 8, 3);
+    auto const fill_value = mesh2d.mesh2d.int_fill_value;
+    ASSERT_NE(mesh2d.face_nodes.end(), std::find(mesh2d.face_nodes.begin(), mesh2d.face_nodes.end(), fill_value));
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    ugridapi::Mesh2D mesh2d_api;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<int> edge_nodes(mesh2d.edge_nodes.size());
+    std::vector<int> face_nodes(mesh2d.face_nodes.size());
+    mesh2d_api.name = name.data();
+    mesh2d_api.edge_nodes = edge_nodes.data();
+    mesh2d_api.face_nodes = face_nodes.data();
+    mesh2d_api.start_index = 1;
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    for (size_t i = 0; i < edge_nodes.size(); ++i)
+    {
+        ASSERT_EQ(mesh2d.edge_nodes[i] + 1, edge_nodes[i]);
+    }
+    for (size_t i = 0; i < face_nodes.size(); ++i)
+    {
+        auto const expected = mesh2d.face_nodes[i] == fill_value ? fill_value : mesh2d.face_nodes[i] + 1;
+        ASSERT_EQ(expected, face_nodes[i]);
+    }
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, RaggedFaceConnectivity_OnMixedPolygons_ShouldMatchPaddedRows)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/RaggedFaceConnectivity.nc";
+    std::string const ragged_file_path = TEST_WRITE_FOLDER + "/RaggedFaceConnectivityPut.nc";
+
+    auto const mesh2d = generate_mixed_polygons("mesh2d", 23, 11, 7, 5);
+    auto const num_faces = static_cast<size_t>(mesh2d.mesh2d.num_faces);
+    auto const num_face_nodes_max = static_cast<size_t>(mesh2d.mesh2d.num_face_nodes_max);
+    auto const fill_value = mesh2d.mesh2d.int_fill_value;
+
+    // The expected ragged layout drops the fill values of the padded rows
+    std::vector<int> expected_offsets{0};
+    std::vector<int> expected_indices;
+    for (size_t f = 0; f < num_faces; ++f)
+    {
+        for (size_t n = 0; n < num_face_nodes_max; ++n)
+        {
+            auto const node = mesh2d.face_nodes[f * num_face_nodes_max + n];
+            if (node != fill_value)
+            {
+                expected_indices.push_back(node);
+            }
+        }
+        expected_offsets.push_back(static_cast<int>(expected_indices.size()));
+    }
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Read the ragged face nodes
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<int> face_offsets(num_faces + 1);
+    error_code = ugridapi::ug_mesh2d_get_face_offsets(file_id, 0, face_offsets.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(expected_offsets, face_offsets);
+
+    std::vector<int> face_nodes(face_offsets.back());
+    error_code = ugridapi::ug_mesh2d_get_face_connectivity_ragged(file_id,
+                                                                  0,
+                                                                  ugridapi::Mesh2DConnectivity::FaceNodes,
+                                                                  0,
+                                                                  face_offsets.data(),
+                                                                  face_nodes.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(expected_indices, face_nodes);
+
+    // Invalid topology ids are rejected
+    error_code = ugridapi::ug_mesh2d_get_face_offsets(file_id, 1, face_offsets.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Put one-based ragged face nodes and read them back padded
+    std::vector<int> one_based_face_nodes(face_nodes);
+    for (auto& node : one_based_face_nodes)
+    {
+        node += 1;
+    }
+
+    error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(ragged_file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put_face_connectivity_ragged(file_id,
+                                                                  topology_id,
+                                                                  ugridapi::Mesh2DConnectivity::FaceNodes,
+                                                                  1,
+                                                                  face_offsets.data(),
+                                                                  one_based_face_nodes.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(ragged_file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    ugridapi::Mesh2D mesh2d_api;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<int> padded_face_nodes(mesh2d.face_nodes.size());
+    mesh2d_api.name = name.data();
+    mesh2d_api.face_nodes = padded_face_nodes.data();
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.face_nodes, padded_face_nodes);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, DefineAndPut_Mesh2DWith64BitConnectivity_ShouldReadBackAs32And64Bit)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/Mesh2DConnectivityInt64.nc";
+
+    auto const mesh2d = generate_triangles("mesh2d", 12, 8, 11);
+    std::vector<int64_t> face_nodes_long(mesh2d.face_nodes.begin(), mesh2d.face_nodes.end());
+    std::vector<int64_t> edge_nodes_long(mesh2d.edge_nodes.begin(), mesh2d.edge_nodes.end());
+
+    // Describe the mesh with the 64-bit fields only
+    auto mesh2d_long = mesh2d.mesh2d;
+    mesh2d_long.face_nodes = nullptr;
+    mesh2d_long.edge_nodes = nullptr;
+    mesh2d_long.face_nodes_long = face_nodes_long.data();
+    mesh2d_long.edge_nodes_long = edge_nodes_long.data();
+    mesh2d_long.num_nodes_long = mesh2d.mesh2d.num_nodes;
+    mesh2d_long.num_edges_long = mesh2d.mesh2d.num_edges;
+    mesh2d_long.num_faces_long = mesh2d.mesh2d.num_faces;
+    mesh2d_long.num_nodes = -1;
+    mesh2d_long.num_edges = -1;
+    mesh2d_long.num_faces = -1;
+    mesh2d_long.connectivity_int64 = 1;
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_format = -1;
+    error_code = ugridapi::ug_file_netcdf4_format(file_format);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open_with_format(file_path.c_str(), file_mode, file_format, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d_long, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d_long);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // The counts are reported in both fields
+    ugridapi::Mesh2D mesh2d_api;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.mesh2d.num_faces, mesh2d_api.num_faces);
+    ASSERT_EQ(mesh2d.mesh2d.num_faces, mesh2d_api.num_faces_long);
+    ASSERT_EQ(mesh2d.mesh2d.num_edges, mesh2d_api.num_edges_long);
+    ASSERT_EQ(mesh2d.mesh2d.num_nodes, mesh2d_api.num_nodes_long);
+
+    std::vector<int64_t> dimensions(2);
+    auto const face_nodes_variable = std::string("mesh2d_face_nodes");
+    error_code = ugridapi::ug_variable_get_data_dimensions_long(file_id, face_nodes_variable.c_str(), dimensions.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.mesh2d.num_faces, dimensions[0]);
+
+    // 64-bit read, one-based
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<int64_t> read_face_nodes_long(face_nodes_long.size());
+    mesh2d_api.name = name.data();
+    mesh2d_api.face_nodes_long = read_face_nodes_long.data();
+    mesh2d_api.start_index = 1;
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (size_t i = 0; i < face_nodes_long.size(); ++i)
+    {
+        ASSERT_EQ(face_nodes_long[i] + 1, read_face_nodes_long[i]);
+    }
+
+    // 32-bit read of the 64-bit variables
+    std::vector<int> read_face_nodes(mesh2d.face_nodes.size());
+    std::vector<int> read_edge_nodes(mesh2d.edge_nodes.size());
+    mesh2d_api.face_nodes_long = nullptr;
+    mesh2d_api.face_nodes = read_face_nodes.data();
+    mesh2d_api.edge_nodes = read_edge_nodes.data();
+    mesh2d_api.start_index = 0;
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.face_nodes, read_face_nodes);
+    ASSERT_EQ(mesh2d.edge_nodes, read_edge_nodes);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // A struct reused after inquire keeps the inquired 64-bit counts, the smaller 32-bit counts set afterwards are used
+    std::string const reused_file_path = TEST_WRITE_FOLDER + "/Mesh2DReusedCounts.nc";
+    auto const small_mesh2d = generate_triangles("mesh2d", 4, 3, 5);
+    auto reused_mesh2d = small_mesh2d.mesh2d;
+    reused_mesh2d.num_nodes_long = mesh2d_api.num_nodes_long;
+    reused_mesh2d.num_edges_long = mesh2d_api.num_edges_long;
+    reused_mesh2d.num_faces_long = mesh2d_api.num_faces_long;
+
+    error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(reused_file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_def(file_id, reused_mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, reused_mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(reused_file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ugridapi::Mesh2D reused_mesh2d_api;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, reused_mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(small_mesh2d.mesh2d.num_nodes, reused_mesh2d_api.num_nodes);
+    ASSERT_EQ(small_mesh2d.mesh2d.num_edges, reused_mesh2d_api.num_edges);
+    ASSERT_EQ(small_mesh2d.mesh2d.num_faces, reused_mesh2d_api.num_faces);
+
+    std::vector<int> reused_face_nodes(small_mesh2d.face_nodes.size());
+    reused_mesh2d_api.name = name.data();
+    reused_mesh2d_api.face_nodes = reused_face_nodes.data();
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, reused_mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(small_mesh2d.face_nodes, reused_face_nodes);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, DeriveConnectivity_OnFacesOnly_ShouldMatchEdgesAndKeepFileEdgeNumbering)
+{
+    auto const mesh2d = generate_mixed_polygons("mesh2d", 31, 17, 6, 9);
+    auto const num_face_nodes_max = static_cast<size_t>(mesh2d.mesh2d.num_face_nodes_max);
+    auto const fill_value = mesh2d.mesh2d.int_fill_value;
+
+    // The edges listed in reverse order, to check that the numbering of stored edges is kept
+    std::vector<int> reversed_edge_nodes;
+    for (auto e = mesh2d.edge_nodes.size() / 2; e > 0; --e)
+    {
+        reversed_edge_nodes.push_back(mesh2d.edge_nodes[2 * e - 2]);
+        reversed_edge_nodes.push_back(mesh2d.edge_nodes[2 * e - 1]);
+    }
+
+    for (bool const store_edges : {false, true})
+    {
+        std::string const file_path = TEST_WRITE_FOLDER + (store_edges ? "/DeriveConnectivityWithEdges.nc" : "/DeriveConnectivity.nc");
+        auto mesh2d_def = mesh2d.mesh2d;
+        mesh2d_def.edge_nodes = store_edges ? reversed_edge_nodes.data() : nullptr;
+        mesh2d_def.num_edges = store_edges ? mesh2d.mesh2d.num_edges : 0;
+
+        int file_mode = -1;
+        auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        int file_id = -1;
+        error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        int topology_id = -1;
+        error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d_def, topology_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d_def);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        error_code = ugridapi::ug_file_close(file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+        error_code = ugridapi::ug_file_read_mode(file_mode);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        error_code = ugridapi::ug_mesh2d_derive_connectivity(file_id, 0, 4);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+        ugridapi::Mesh2D mesh2d_api;
+        error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d_api);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ASSERT_EQ(mesh2d.mesh2d.num_edges, mesh2d_api.num_edges);
+
+        std::vector<char> name(ugridapi::name_long_length);
+        std::vector<int> edge_nodes(mesh2d.edge_nodes.size());
+        std::vector<int> edge_faces(mesh2d.edge_nodes.size());
+        std::vector<int> face_edges(mesh2d.face_nodes.size());
+        std::vector<int> face_faces(mesh2d.face_nodes.size());
+        mesh2d_api.name = name.data();
+        mesh2d_api.edge_nodes = edge_nodes.data();
+        mesh2d_api.edge_faces = edge_faces.data();
+        mesh2d_api.face_edges = face_edges.data();
+        mesh2d_api.face_faces = face_faces.data();
+        error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+        if (store_edges)
+        {
+            ASSERT_EQ(reversed_edge_nodes, edge_nodes);
+        }
+        else
+        {
+            // Derived edges are numbered by sorted node pair, as the generated edges
+            for (size_t e = 0; e < edge_nodes.size() / 2; ++e)
+            {
+                ASSERT_EQ(mesh2d.edge_nodes[2 * e], std::min(edge_nodes[2 * e], edge_nodes[2 * e + 1]));
+                ASSERT_EQ(mesh2d.edge_nodes[2 * e + 1], std::max(edge_nodes[2 * e], edge_nodes[2 * e + 1]));
+            }
+        }
+
+        // Every face edge joins the face nodes it lies between, and lists the face and its neighbour
+        for (size_t position = 0; position < mesh2d.face_nodes.size(); ++position)
+        {
+            if (mesh2d.face_nodes[position] == fill_value)
+            {
+                ASSERT_EQ(fill_value, face_edges[position]);
+                continue;
+            }
+            auto const face = static_cast<int>(position / num_face_nodes_max);
+            auto next = position + 1;
+            if (next % num_face_nodes_max == 0 || mesh2d.face_nodes[next] == fill_value)
+            {
+                next = position - position % num_face_nodes_max;
+            }
+            auto const edge = static_cast<size_t>(face_edges[position]);
+            auto const first = std::min(mesh2d.face_nodes[position], mesh2d.face_nodes[next]);
+            auto const second = std::max(mesh2d.face_nodes[position], mesh2d.face_nodes[next]);
+            ASSERT_EQ(first, std::min(edge_nodes[2 * edge], edge_nodes[2 * edge + 1]));
+            ASSERT_EQ(second, std::max(edge_nodes[2 * edge], edge_nodes[2 * edge + 1]));
+
+            auto const neighbour = edge_faces[2 * edge] == face ? edge_faces[2 * edge + 1] : edge_faces[2 * edge];
+            ASSERT_TRUE(edge_faces[2 * edge] == face || edge_faces[2 * edge + 1] == face);
+            ASSERT_EQ(neighbour, face_faces[position]);
+        }
+
+        error_code = ugridapi::ug_file_close(file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+}
+
+TEST(ApiTest, BuildNodeFacesAndNodeEdges_OnMixedPolygons_ShouldInvertConnectivity)
+{
+    auto const mesh2d = generate_mixed_polygons("mesh2d", 19, 13, 6, 21);
+    auto const num_nodes = static_cast<size_t>(mesh2d.mesh2d.num_nodes);
+    auto const num_face_nodes_max = static_cast<size_t>(mesh2d.mesh2d.num_face_nodes_max);
+    auto const fill_value = mesh2d.mesh2d.int_fill_value;
+
+    // Brute force inverse connectivity, with the entities of each node in ascending order
+    std::vector<std::vector<int>> expected_node_faces(num_nodes);
+    for (size_t position = 0; position < mesh2d.face_nodes.size(); ++position)
+    {
+        if (mesh2d.face_nodes[position] != fill_value)
+        {
+            expected_node_faces[mesh2d.face_nodes[position]].push_back(static_cast<int>(position / num_face_nodes_max));
+        }
+    }
+    std::vector<std::vector<int>> expected_node_edges(num_nodes);
+    for (size_t position = 0; position < mesh2d.edge_nodes.size(); ++position)
+    {
+        expected_node_edges[mesh2d.edge_nodes[position]].push_back(static_cast<int>(position / 2));
+    }
+
+    std::vector<int> node_face_offsets(num_nodes + 1);
+    std::vector<int> node_faces(mesh2d.face_nodes.size());
+    auto error_code = ugridapi::ug_mesh2d_build_node_faces(mesh2d.mesh2d, 3, node_face_offsets.data(), node_faces.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<int> node_edge_offsets(num_nodes + 1);
+    std::vector<int> node_edges(mesh2d.edge_nodes.size());
+    error_code = ugridapi::ug_mesh2d_build_node_edges(mesh2d.mesh2d, 3, node_edge_offsets.data(), node_edges.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    for (size_t node = 0; node < num_nodes; ++node)
+    {
+        ASSERT_EQ(expected_node_faces[node], std::vector<int>(node_faces.begin() + node_face_offsets[node], node_faces.begin() + node_face_offsets[node + 1]));
+        ASSERT_EQ(expected_node_edges[node], std::vector<int>(node_edges.begin() + node_edge_offsets[node], node_edges.begin() + node_edge_offsets[node + 1]));
+    }
+    ASSERT_EQ(static_cast<int>(mesh2d.edge_nodes.size()), node_edge_offsets.back());
+
+    // The 64-bit counts and connectivity give the same result
+    std::vector<int64_t> face_nodes_long(mesh2d.face_nodes.begin(), mesh2d.face_nodes.end());
+    std::vector<int64_t> edge_nodes_long(mesh2d.edge_nodes.begin(), mesh2d.edge_nodes.end());
+    auto mesh2d_long = mesh2d.mesh2d;
+    mesh2d_long.face_nodes = nullptr;
+    mesh2d_long.edge_nodes = nullptr;
+    mesh2d_long.face_nodes_long = face_nodes_long.data();
+    mesh2d_long.edge_nodes_long = edge_nodes_long.data();
+    mesh2d_long.num_nodes = -1;
+    mesh2d_long.num_edges = -1;
+    mesh2d_long.num_faces = -1;
+    mesh2d_long.num_nodes_long = mesh2d.mesh2d.num_nodes;
+    mesh2d_long.num_edges_long = mesh2d.mesh2d.num_edges;
+    mesh2d_long.num_faces_long = mesh2d.mesh2d.num_faces;
+
+    std::vector<int> node_face_offsets_long(num_nodes + 1);
+    std::vector<int> node_faces_long(mesh2d.face_nodes.size());
+    error_code = ugridapi::ug_mesh2d_build_node_faces(mesh2d_long, 3, node_face_offsets_long.data(), node_faces_long.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(node_face_offsets, node_face_offsets_long);
+    ASSERT_EQ(node_faces, node_faces_long);
+
+    std::vector<int> node_edge_offsets_long(num_nodes + 1);
+    std::vector<int> node_edges_long(mesh2d.edge_nodes.size());
+    error_code = ugridapi::ug_mesh2d_build_node_edges(mesh2d_long, 3, node_edge_offsets_long.data(), node_edges_long.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(node_edge_offsets, node_edge_offsets_long);
+    ASSERT_EQ(node_edges, node_edges_long);
+
+    // 64-bit indices exceeding the int range are rejected
+    edge_nodes_long[0] = static_cast<int64_t>(std::numeric_limits<int>::max()) + 1;
+    error_code = ugridapi::ug_mesh2d_build_node_edges(mesh2d_long, 3, node_edge_offsets_long.data(), node_edges_long.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    // Indices outside the nodes are rejected
+    auto invalid_mesh2d = mesh2d.mesh2d;
+    invalid_mesh2d.num_nodes = 3;
+    std::vector<int> invalid_offsets(4);
+    error_code = ugridapi::ug_mesh2d_build_node_edges(invalid_mesh2d, 3, invalid_offsets.data(), node_edges.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+}
+
+TEST(ApiTest, FaceLocator_OnPlanarAndSphericalMeshes_ShouldFindContainingFaces)
+{
+    // Planar: every point lies strictly inside one quad
+    auto const mesh2d = generate_structured_quads("mesh2d", 40, 25);
+    auto const num_face_nodes_max = static_cast<size_t>(mesh2d.mesh2d.num_face_nodes_max);
+
+    int locator_id = -1;
+    auto error_code = ugridapi::ug_face_locator_create(mesh2d.mesh2d, 2, locator_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    std::vector<double> x{0.5, 39.25, 17.75, 3.125, -1.0, 41.0};
+    std::vector<double> y{0.5, 24.75, 11.5, 20.875, 3.0, 3.0};
+    std::vector<int> faces(x.size());
+    error_code = ugridapi::ug_face_locator_find_faces(locator_id, static_cast<int>(x.size()), x.data(), y.data(), 2, faces.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    for (size_t p = 0; p < 4; ++p)
+    {
+        ASSERT_NE(mesh2d.mesh2d.int_fill_value, faces[p]);
+        auto const face = static_cast<size_t>(faces[p]);
+        double min_x = std::numeric_limits<double>::max();
+        double max_x = std::numeric_limits<double>::lowest();
+        double min_y = std::numeric_limits<double>::max();
+        double max_y = std::numeric_limits<double>::lowest();
+        for (size_t k = 0; k < num_face_nodes_max; ++k)
+        {
+            auto const node = static_cast<size_t>(mesh2d.face_nodes[face * num_face_nodes_max + k]);
+            min_x = std::min(min_x, mesh2d.node_x[node]);
+            max_x = std::max(max_x, mesh2d.node_x[node]);
+            min_y = std::min(min_y, mesh2d.node_y[node]);
+            max_y = std::max(max_y, mesh2d.node_y[node]);
+        }
+        ASSERT_TRUE(x[p] > min_x && x[p] < max_x && y[p] > min_y && y[p] < max_y);
+    }
+    ASSERT_EQ(mesh2d.mesh2d.int_fill_value, faces[4]);
+    ASSERT_EQ(mesh2d.mesh2d.int_fill_value, faces[5]);
+
+    // A locator built from the 64-bit counts and face nodes finds the same faces
+    std::vector<int64_t> face_nodes_long(mesh2d.face_nodes.begin(), mesh2d.face_nodes.end());
+    auto mesh2d_long = mesh2d.mesh2d;
+    mesh2d_long.face_nodes = nullptr;
+    mesh2d_long.face_nodes_long = face_nodes_long.data();
+    mesh2d_long.num_nodes = -1;
+    mesh2d_long.num_faces = -1;
+    mesh2d_long.num_nodes_long = mesh2d.mesh2d.num_nodes;
+    mesh2d_long.num_faces_long = mesh2d.mesh2d.num_faces;
+
+    int locator_long_id = -1;
+    error_code = ugridapi::ug_face_locator_create(mesh2d_long, 2, locator_long_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<int> faces_long(x.size());
+    error_code = ugridapi::ug_face_locator_find_faces(locator_long_id, static_cast<int>(x.size()), x.data(), y.data(), 2, faces_long.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(faces, faces_long);
+    error_code = ugridapi::ug_face_locator_destroy(locator_long_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_face_locator_destroy(locator_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_face_locator_find_faces(locator_id, 1, x.data(), y.data(), 1, faces.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    // Spherical: a global band of 10 degree cells, the last column crossing the antimeridian
+    int const num_columns = 36;
+    int const num_rows = 4;
+    std::vector<double> node_x;
+    std::vector<double> node_y;
+    for (int j = 0; j <= num_rows; ++j)
+    {
+        for (int i = 0; i < num_columns; ++i)
+        {
+            node_x.push_back(-180.0 + 10.0 * i);
+            node_y.push_back(-20.0 + 10.0 * j);
+        }
+    }
+    std::vector<int> face_nodes;
+    for (int j = 0; j < num_rows; ++j)
+    {
+        for (int i = 0; i < num_columns; ++i)
+        {
+            auto const next = (i + 1) % num_columns;
+            face_nodes.insert(face_nodes.end(), {j * num_columns + i + 1, j * num_columns + next + 1, (j + 1) * num_columns + next + 1, (j + 1) * num_columns + i + 1});
+        }
+    }
+    ugridapi::Mesh2D spherical_mesh2d;
+    spherical_mesh2d.node_x = node_x.data();
+    spherical_mesh2d.node_y = node_y.data();
+    spherical_mesh2d.num_nodes = static_cast<int>(node_x.size());
+    spherical_mesh2d.face_nodes = face_nodes.data();
+    spherical_mesh2d.num_faces = num_columns * num_rows;
+    spherical_mesh2d.num_face_nodes_max = 4;
+    spherical_mesh2d.start_index = 1;
+    spherical_mesh2d.is_spherical = 1;
+
+    error_code = ugridapi::ug_face_locator_create(spherical_mesh2d, 2, locator_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // The same location as longitude 175, -185 and 535, the other side of the antimeridian, and outside the band
+    std::vector<double> longitudes{175.0, -185.0, 535.0, -175.0, 0.0};
+    std::vector<double> latitudes{5.0, 5.0, 5.0, 5.0, 45.0};
+    std::vector<int> spherical_faces(longitudes.size());
+    error_code = ugridapi::ug_face_locator_find_faces(locator_id,
+                                                      static_cast<int>(longitudes.size()),
+                                                      longitudes.data(),
+                                                      latitudes.data(),
+                                                      0,
+                                                      spherical_faces.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    auto const wrapping_face = 2 * num_columns + (num_columns - 1) + 1;
+    ASSERT_EQ(wrapping_face, spherical_faces[0]);
+    ASSERT_EQ(wrapping_face, spherical_faces[1]);
+    ASSERT_EQ(wrapping_face, spherical_faces[2]);
+    ASSERT_EQ(2 * num_columns + 1, spherical_faces[3]);
+    ASSERT_EQ(spherical_mesh2d.int_fill_value, spherical_faces[4]);
+
+    error_code = ugridapi::ug_face_locator_destroy(locator_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, ExtractBoundingBoxAndPolygon_OnStructuredQuads_ShouldCopySubsetAndData)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/ExtractSource.nc";
+    std::string const box_file_path = TEST_WRITE_FOLDER + "/ExtractBoundingBox.nc";
+    std::string const polygon_file_path = TEST_WRITE_FOLDER + "/ExtractPolygon.nc";
+    int const nx = 10;
+    int const ny = 8;
+    auto const mesh2d = generate_structured_quads("mesh2d", nx, ny);
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // A face variable with two time steps, the face dimension first
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_depth", ugridapi::name_long_length, variable_name.data());
+    std::vector<char> dimension_name(ugridapi::name_long_length);
+    string_to_char_array("time", ugridapi::name_long_length, dimension_name.data());
+    int const num_time_steps = 2;
+    error_code = ugridapi::ug_topology_define_double_variable_on_location(file_id,
+                                                                          ugridapi::TopologyType::Mesh2dTopology,
+                                                                          topology_id,
+                                                                          ugridapi::MeshLocations::Faces,
+                                                                          variable_name.data(),
+                                                                          dimension_name.data(),
+                                                                          num_time_steps);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<double> depth(static_cast<size_t>(mesh2d.mesh2d.num_faces) * num_time_steps);
+    for (size_t i = 0; i < depth.size(); ++i)
+    {
+        depth[i] = static_cast<double>(i / num_time_steps) + 1000.0 * static_cast<double>(i % num_time_steps);
+    }
+    error_code = ugridapi::ug_variable_put_data_double(file_id, variable_name.data(), depth.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // A face variable with three records, the face dimension last
+    std::vector<char> record_variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_water_level", ugridapi::name_long_length, record_variable_name.data());
+    std::vector<char> record_dimension_name(ugridapi::name_long_length);
+    string_to_char_array("record_time", ugridapi::name_long_length, record_dimension_name.data());
+    int const num_records = 3;
+    error_code = ugridapi::ug_topology_define_double_record_variable_on_location(file_id,
+                                                                                 ugridapi::TopologyType::Mesh2dTopology,
+                                                                                 topology_id,
+                                                                                 ugridapi::MeshLocations::Faces,
+                                                                                 record_variable_name.data(),
+                                                                                 record_dimension_name.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<double> water_level(static_cast<size_t>(mesh2d.mesh2d.num_faces) * num_records);
+    for (int r = 0; r < num_records; ++r)
+    {
+        auto* const record = water_level.data() + static_cast<size_t>(r) * mesh2d.mesh2d.num_faces;
+        for (int face = 0; face < mesh2d.mesh2d.num_faces; ++face)
+        {
+            record[face] = 100.0 * r + face;
+        }
+        int record_index = -1;
+        error_code = ugridapi::ug_variable_append_data_double(file_id, record_variable_name.data(), record, record_index);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+
+    // The box spans the nodes 2 <= x <= 7 and 1 <= y <= 5, hence 5 x 4 faces
+    int num_faces = 0;
+    error_code = ugridapi::ug_mesh2d_extract_bounding_box(file_id, topology_id, 1.5, 0.5, 7.25, 5.0, box_file_path.c_str(), num_faces);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(20, num_faces);
+
+    // The polygon contains the nodes 2 <= x <= 4 and 1 <= y <= 3, hence 2 x 2 faces
+    std::vector<double> polygon_x{1.5, 4.5, 4.5, 1.5};
+    std::vector<double> polygon_y{0.5, 0.5, 3.5, 3.5};
+    error_code = ugridapi::ug_mesh2d_extract_polygon(file_id, topology_id, 4, polygon_x.data(), polygon_y.data(), polygon_file_path.c_str(), num_faces);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(4, num_faces);
+
+    // A region without faces
+    error_code = ugridapi::ug_mesh2d_extract_bounding_box(file_id, topology_id, 20.0, 20.0, 30.0, 30.0, box_file_path.c_str(), num_faces);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+    error_code = ugridapi::ug_mesh2d_extract_bounding_box(file_id, topology_id, 1.5, 0.5, 7.25, 5.0, box_file_path.c_str(), num_faces);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Read back the extracted box
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open(box_file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    ugridapi::Mesh2D mesh2d_api;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(20, mesh2d_api.num_faces);
+    ASSERT_EQ(30, mesh2d_api.num_nodes);
+    ASSERT_EQ(5 * 5 + 6 * 4, mesh2d_api.num_edges);
+
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<double> node_x(mesh2d_api.num_nodes);
+    std::vector<double> node_y(mesh2d_api.num_nodes);
+    std::vector<int> face_nodes(static_cast<size_t>(mesh2d_api.num_faces) * mesh2d_api.num_face_nodes_max);
+    mesh2d_api.name = name.data();
+    mesh2d_api.node_x = node_x.data();
+    mesh2d_api.node_y = node_y.data();
+    mesh2d_api.face_nodes = face_nodes.data();
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (auto const node : face_nodes)
+    {
+        ASSERT_GE(node_x[node], 2.0);
+        ASSERT_LE(node_x[node], 7.0);
+        ASSERT_GE(node_y[node], 1.0);
+        ASSERT_LE(node_y[node], 5.0);
+    }
+
+    // The faces keep their order, and their data
+    std::vector<double> extracted_depth(static_cast<size_t>(mesh2d_api.num_faces) * num_time_steps);
+    error_code = ugridapi::ug_variable_get_data_double(file_id, variable_name.data(), extracted_depth.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (int k = 0; k < mesh2d_api.num_faces; ++k)
+    {
+        auto const face = (1 + k / 5) * nx + 2 + k % 5;
+        for (int t = 0; t < num_time_steps; ++t)
+        {
+            ASSERT_EQ(depth[static_cast<size_t>(face * num_time_steps + t)], extracted_depth[static_cast<size_t>(k * num_time_steps + t)]);
+        }
+    }
+
+    // Every record is extracted
+    std::vector<int64_t> dimensions(2);
+    error_code = ugridapi::ug_variable_get_data_dimensions_long(file_id, record_variable_name.data(), dimensions.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(num_records, dimensions[0]);
+    std::vector<double> extracted_water_level(static_cast<size_t>(mesh2d_api.num_faces) * num_records);
+    error_code = ugridapi::ug_variable_get_data_double(file_id, record_variable_name.data(), extracted_water_level.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (int r = 0; r < num_records; ++r)
+    {
+        for (int k = 0; k < mesh2d_api.num_faces; ++k)
+        {
+            auto const face = (1 + k / 5) * nx + 2 + k % 5;
+            ASSERT_EQ(100.0 * r + face, extracted_water_level[static_cast<size_t>(r * mesh2d_api.num_faces + k)]);
+        }
+    }
+
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+}
+
+TEST(ApiTest, PartitionAndWritePartitions_OnStructuredQuads_ShouldWriteDomainsWithGhostFaces)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/PartitionSource.nc";
+    std::string const partition_prefix = TEST_WRITE_FOLDER + "/Partition";
+    int const num_domains = 3;
+    auto const mesh2d = generate_structured_quads("mesh2d", 12, 6);
+    auto const num_faces = static_cast<size_t>(mesh2d.mesh2d.num_faces);
+
+    // The domains have equal sizes, whatever the number of threads
+    std::vector<int> face_domains(num_faces);
+    auto error_code = ugridapi::ug_mesh2d_partition_faces(mesh2d.mesh2d, num_domains, 1, face_domains.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<int> face_domains_threaded(num_faces);
+    error_code = ugridapi::ug_mesh2d_partition_faces(mesh2d.mesh2d, num_domains, 4, face_domains_threaded.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(face_domains, face_domains_threaded);
+    for (int domain = 0; domain < num_domains; ++domain)
+    {
+        ASSERT_EQ(24, std::count(face_domains.begin(), face_domains.end(), domain));
+    }
+
+    int file_mode = -1;
+    error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_mesh2d_write_partitions(file_id, topology_id, num_domains, 1, nullptr, partition_prefix.c_str(), 2);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<char> face_number_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_face_global_number", ugridapi::name_long_length, face_number_name.data());
+    std::vector<char> face_domain_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_face_domain_number", ugridapi::name_long_length, face_domain_name.data());
+    std::vector<char> node_number_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_node_global_number", ugridapi::name_long_length, node_number_name.data());
+    for (int domain = 0; domain < num_domains; ++domain)
+    {
+        std::string const domain_file_path = partition_prefix + "_000" + std::to_string(domain) + ".nc";
+        error_code = ugridapi::ug_file_open(domain_file_path.c_str(), file_mode, file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+        ugridapi::Mesh2D domain_mesh2d;
+        error_code = ugridapi::ug_mesh2d_inq(file_id, 0, domain_mesh2d);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<char> name(ugridapi::name_long_length);
+        std::vector<double> node_x(domain_mesh2d.num_nodes);
+        std::vector<double> node_y(domain_mesh2d.num_nodes);
+        std::vector<int> face_nodes(static_cast<size_t>(domain_mesh2d.num_faces) * domain_mesh2d.num_face_nodes_max);
+        domain_mesh2d.name = name.data();
+        domain_mesh2d.node_x = node_x.data();
+        domain_mesh2d.node_y = node_y.data();
+        domain_mesh2d.face_nodes = face_nodes.data();
+        error_code = ugridapi::ug_mesh2d_get(file_id, 0, domain_mesh2d);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+        std::vector<int> face_numbers(domain_mesh2d.num_faces);
+        error_code = ugridapi::ug_variable_get_data_int(file_id, face_number_name.data(), face_numbers.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<int> face_domain_numbers(domain_mesh2d.num_faces);
+        error_code = ugridapi::ug_variable_get_data_int(file_id, face_domain_name.data(), face_domain_numbers.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<int> node_numbers(domain_mesh2d.num_nodes);
+        error_code = ugridapi::ug_variable_get_data_int(file_id, node_number_name.data(), node_numbers.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+        // The owned faces are all there, the ghost faces belong to other domains
+        ASSERT_EQ(24, std::count(face_domain_numbers.begin(), face_domain_numbers.end(), domain));
+        ASSERT_GT(domain_mesh2d.num_faces, 24);
+        for (int face = 0; face < domain_mesh2d.num_faces; ++face)
+        {
+            auto const global_face = static_cast<size_t>(face_numbers[face] - 1);
+            ASSERT_EQ(face_domains[global_face], face_domain_numbers[face]);
+            for (int k = 0; k < domain_mesh2d.num_face_nodes_max; ++k)
+            {
+                auto const node = face_nodes[face * domain_mesh2d.num_face_nodes_max + k];
+                auto const global_node = static_cast<size_t>(node_numbers[node] - 1);
+                ASSERT_EQ(mesh2d.face_nodes[global_face * 4 + k], static_cast<int>(global_node));
+                ASSERT_EQ(mesh2d.node_x[global_node], node_x[node]);
+                ASSERT_EQ(mesh2d.node_y[global_node], node_y[node]);
+            }
+        }
+
+        error_code = ugridapi::ug_file_close(file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+}
+
+TEST(ApiTest, MergePartitions_ByGlobalNumbersAndByCoordinates_ShouldRestoreMeshAndData)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/MergeSource.nc";
+    std::string const partition_prefix = TEST_WRITE_FOLDER + "/MergePartition";
+    std::string const extraction_prefix = TEST_WRITE_FOLDER + "/MergeExtraction";
+    std::string const merged_file_path = TEST_WRITE_FOLDER + "/Merged.nc";
+    int const nx = 12;
+    int const ny = 6;
+    auto const mesh2d = generate_structured_quads("mesh2d", nx, ny);
+
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // A face variable with three time steps
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_s1", ugridapi::name_long_length, variable_name.data());
+    std::vector<char> dimension_name(ugridapi::name_long_length);
+    string_to_char_array("time", ugridapi::name_long_length, dimension_name.data());
+    int const num_time_steps = 3;
+    error_code = ugridapi::ug_topology_define_double_variable_on_location(file_id,
+                                                                          ugridapi::TopologyType::Mesh2dTopology,
+                                                                          topology_id,
+                                                                          ugridapi::MeshLocations::Faces,
+                                                                          variable_name.data(),
+                                                                          dimension_name.data(),
+                                                                          num_time_steps);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<double> s1(static_cast<size_t>(mesh2d.mesh2d.num_faces) * num_time_steps);
+    for (size_t i = 0; i < s1.size(); ++i)
+    {
+        s1[i] = 0.25 * static_cast<double>(i);
+    }
+    error_code = ugridapi::ug_variable_put_data_double(file_id, variable_name.data(), s1.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // A face variable with two records on a leading unlimited dimension
+    std::vector<char> record_variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_waterlevel", ugridapi::name_long_length, record_variable_name.data());
+    std::vector<char> record_dimension_name(ugridapi::name_long_length);
+    string_to_char_array("record_time", ugridapi::name_long_length, record_dimension_name.data());
+    int const num_records = 2;
+    error_code = ugridapi::ug_topology_define_double_record_variable_on_location(file_id,
+                                                                                 ugridapi::TopologyType::Mesh2dTopology,
+                                                                                 topology_id,
+                                                                                 ugridapi::MeshLocations::Faces,
+                                                                                 record_variable_name.data(),
+                                                                                 record_dimension_name.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<double> waterlevel(static_cast<size_t>(mesh2d.mesh2d.num_faces) * num_records);
+    for (size_t i = 0; i < waterlevel.size(); ++i)
+    {
+        waterlevel[i] = -0.5 * static_cast<double>(i);
+    }
+    for (int r = 0; r < num_records; ++r)
+    {
+        int record_index = -1;
+        error_code = ugridapi::ug_variable_append_data_double(file_id,
+                                                              record_variable_name.data(),
+                                                              waterlevel.data() + static_cast<size_t>(r) * mesh2d.mesh2d.num_faces,
+                                                              record_index);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+
+    // Domains with ghost faces and global numbers, and domains with only coordinates in common
+    error_code = ugridapi::ug_mesh2d_write_partitions(file_id, topology_id, 4, 2, nullptr, partition_prefix.c_str(), 0);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int num_faces = 0;
+    error_code = ugridapi::ug_mesh2d_extract_bounding_box(file_id, topology_id, 0.0, 0.0, 5.0, 6.0, (extraction_prefix + "_0000.nc").c_str(), num_faces);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_extract_bounding_box(file_id, topology_id, 5.0, 0.0, 12.0, 6.0, (extraction_prefix + "_0001.nc").c_str(), num_faces);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (auto const& [prefix, num_domains] : {std::make_pair(partition_prefix, 4), std::make_pair(extraction_prefix, 2)})
+    {
+        error_code = ugridapi::ug_mesh2d_merge_partitions(prefix.c_str(), ".nc", num_domains, 0, 1e-6, merged_file_path.c_str(), 2, num_faces);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ASSERT_EQ(mesh2d.mesh2d.num_faces, num_faces);
+
+        error_code = ugridapi::ug_file_open(merged_file_path.c_str(), file_mode, file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ugridapi::Mesh2D merged_mesh2d;
+        error_code = ugridapi::ug_mesh2d_inq(file_id, 0, merged_mesh2d);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ASSERT_EQ(mesh2d.mesh2d.num_nodes, merged_mesh2d.num_nodes);
+        ASSERT_EQ(mesh2d.mesh2d.num_edges, merged_mesh2d.num_edges);
+        ASSERT_EQ(mesh2d.mesh2d.num_faces, merged_mesh2d.num_faces);
+
+        std::vector<char> name(ugridapi::name_long_length);
+        std::vector<double> node_x(merged_mesh2d.num_nodes);
+        std::vector<double> node_y(merged_mesh2d.num_nodes);
+        std::vector<int> face_nodes(static_cast<size_t>(merged_mesh2d.num_faces) * merged_mesh2d.num_face_nodes_max);
+        merged_mesh2d.name = name.data();
+        merged_mesh2d.node_x = node_x.data();
+        merged_mesh2d.node_y = node_y.data();
+        merged_mesh2d.face_nodes = face_nodes.data();
+        error_code = ugridapi::ug_mesh2d_get(file_id, 0, merged_mesh2d);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<double> merged_s1(s1.size());
+        error_code = ugridapi::ug_variable_get_data_double(file_id, variable_name.data(), merged_s1.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        std::vector<int64_t> record_dimensions(2);
+        error_code = ugridapi::ug_variable_get_data_dimensions_long(file_id, record_variable_name.data(), record_dimensions.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+        ASSERT_EQ(num_records, record_dimensions[0]);
+        std::vector<double> merged_waterlevel(waterlevel.size());
+        error_code = ugridapi::ug_variable_get_data_double(file_id, record_variable_name.data(), merged_waterlevel.data());
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+        // Each merged face has the corners and the data of the source face at the same place
+        for (int face = 0; face < merged_mesh2d.num_faces; ++face)
+        {
+            auto const first_node = static_cast<size_t>(face_nodes[static_cast<size_t>(face) * 4]);
+            auto const source_face = static_cast<size_t>(node_y[first_node]) * nx + static_cast<size_t>(node_x[first_node]);
+            for (int k = 0; k < 4; ++k)
+            {
+                auto const node = static_cast<size_t>(face_nodes[static_cast<size_t>(face) * 4 + k]);
+                auto const source_node = static_cast<size_t>(mesh2d.face_nodes[source_face * 4 + k]);
+                ASSERT_EQ(mesh2d.node_x[source_node], node_x[node]);
+                ASSERT_EQ(mesh2d.node_y[source_node], node_y[node]);
+            }
+            for (int t = 0; t < num_time_steps; ++t)
+            {
+                ASSERT_EQ(s1[source_face * num_time_steps + t], merged_s1[static_cast<size_t>(face) * num_time_steps + t]);
+            }
+            for (int r = 0; r < num_records; ++r)
+            {
+                auto const record_offset = static_cast<size_t>(r) * mesh2d.mesh2d.num_faces;
+                ASSERT_EQ(waterlevel[record_offset + source_face], merged_waterlevel[record_offset + static_cast<size_t>(face)]);
+            }
+        }
+
+        error_code = ugridapi::ug_file_close(file_id);
+        ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    }
+}
+
+TEST(ApiTest, RenumberHilbert_OnShuffledMixedPolygons_ShouldKeepGeometryAndImproveLocality)
+{
+    auto mesh2d = generate_mixed_polygons("mesh2d", 23, 17, 5, 7);
+    shuffle_mesh2d(11, mesh2d);
+    auto const num_face_nodes_max = static_cast<size_t>(mesh2d.mesh2d.num_face_nodes_max);
+    auto const fill_value = mesh2d.mesh2d.int_fill_value;
+    auto const original_node_x = mesh2d.node_x;
+    auto const original_node_y = mesh2d.node_y;
+    auto const original_edge_nodes = mesh2d.edge_nodes;
+    auto const original_face_nodes = mesh2d.face_nodes;
+
+    // The sum of the node index jumps between consecutive faces, a measure of the spread of a face to node gather
+    auto const face_node_jumps = [&](std::vector<int> const& face_nodes)
+    {
+        int64_t jumps = 0;
+        for (size_t position = num_face_nodes_max; position < face_nodes.size(); position += num_face_nodes_max)
+        {
+            jumps += std::abs(face_nodes[position] - face_nodes[position - num_face_nodes_max]);
+        }
+        return jumps;
+    };
+
+    std::vector<int> node_permutation(mesh2d.node_x.size());
+    std::vector<int> edge_permutation(mesh2d.edge_nodes.size() / 2);
+    std::vector<int> face_permutation(static_cast<size_t>(mesh2d.mesh2d.num_faces));
+    auto error_code = ugridapi::ug_mesh2d_renumber_hilbert(mesh2d.mesh2d, 3, node_permutation.data(), edge_permutation.data(), face_permutation.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    for (auto const* permutation : {&node_permutation, &edge_permutation, &face_permutation})
+    {
+        auto sorted = *permutation;
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            ASSERT_EQ(static_cast<int>(i), sorted[i]);
+        }
+    }
+    for (size_t node = 0; node < node_permutation.size(); ++node)
+    {
+        ASSERT_EQ(original_node_x[node_permutation[node]], mesh2d.node_x[node]);
+        ASSERT_EQ(original_node_y[node_permutation[node]], mesh2d.node_y[node]);
+    }
+
+    // Every edge and face keeps the coordinates of its nodes
+    auto const same_node = [&](int original_node, int node)
+    {
+        return original_node == fill_value ? node == fill_value : original_node_x[original_node] == mesh2d.node_x[node] && original_node_y[original_node] == mesh2d.node_y[node];
+    };
+    for (size_t edge = 0; edge < edge_permutation.size(); ++edge)
+    {
+        for (size_t n = 0; n < 2; ++n)
+        {
+            ASSERT_TRUE(same_node(original_edge_nodes[edge_permutation[edge] * 2 + n], mesh2d.edge_nodes[edge * 2 + n]));
+        }
+    }
+    for (size_t face = 0; face < face_permutation.size(); ++face)
+    {
+        for (size_t n = 0; n < num_face_nodes_max; ++n)
+        {
+            ASSERT_TRUE(same_node(original_face_nodes[face_permutation[face] * num_face_nodes_max + n], mesh2d.face_nodes[face * num_face_nodes_max + n]));
+        }
+    }
+    ASSERT_LT(face_node_jumps(mesh2d.face_nodes) * 5, face_node_jumps(original_face_nodes));
+
+    // Face data follows the faces
+    std::vector<double> face_values(face_permutation.size());
+    for (size_t face = 0; face < face_values.size(); ++face)
+    {
+        face_values[face] = static_cast<double>(face);
+    }
+    error_code = ugridapi::ug_mesh2d_permute_data_double(face_permutation.data(), static_cast<int>(face_permutation.size()), 1, 0, face_values.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (size_t face = 0; face < face_values.size(); ++face)
+    {
+        ASSERT_EQ(static_cast<double>(face_permutation[face]), face_values[face]);
+    }
+
+    // A repeated index is not a permutation
+    face_permutation[1] = face_permutation[0];
+    error_code = ugridapi::ug_mesh2d_permute_data_double(face_permutation.data(), static_cast<int>(face_permutation.size()), 1, 0, face_values.data());
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+
+    // Indices outside the nodes are rejected before the mesh is modified
+    auto const renumbered_node_x = mesh2d.node_x;
+    mesh2d.face_nodes[0] = mesh2d.mesh2d.num_nodes;
+    error_code = ugridapi::ug_mesh2d_renumber_hilbert(mesh2d.mesh2d, 3, nullptr, nullptr, nullptr);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+    ASSERT_EQ(renumbered_node_x, mesh2d.node_x);
+}
+
+TEST(ApiTest, GetMapped_OnClassicFile_ShouldMatchCopiedMesh2D)
+{
+    std::string const file_path = TEST_FOLDER + "/AllUGridEntities.nc";
+
+    // The copied mesh, read through the netCDF library
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ugridapi::Mesh2D mesh2d;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    std::vector<double> node_x(mesh2d.num_nodes);
+    std::vector<double> node_y(mesh2d.num_nodes);
+    std::vector<int> edge_nodes(mesh2d.num_edges * 2);
+    std::vector<int> face_nodes(mesh2d.num_faces * mesh2d.num_face_nodes_max);
+    mesh2d.node_x = node_x.data();
+    mesh2d.node_y = node_y.data();
+    mesh2d.edge_nodes = edge_nodes.data();
+    mesh2d.face_nodes = face_nodes.data();
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Views need a mapped file
+    ugridapi::Mesh2D mapped_mesh2d;
+    error_code = ugridapi::ug_mesh2d_get_mapped(file_id, 0, mapped_mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    int mapped_file_id = -1;
+    error_code = ugridapi::ug_file_open_mapped(file_path.c_str(), mapped_file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_inq(mapped_file_id, 0, mapped_mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.num_faces, mapped_mesh2d.num_faces);
+    error_code = ugridapi::ug_mesh2d_get_mapped(mapped_file_id, 0, mapped_mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_NE(nullptr, mapped_mesh2d.node_x);
+    ASSERT_NE(nullptr, mapped_mesh2d.face_nodes);
+    ASSERT_EQ(node_x, std::vector<double>(mapped_mesh2d.node_x, mapped_mesh2d.node_x + node_x.size()));
+    ASSERT_EQ(node_y, std::vector<double>(mapped_mesh2d.node_y, mapped_mesh2d.node_y + node_y.size()));
+    ASSERT_EQ(edge_nodes, std::vector<int>(mapped_mesh2d.edge_nodes, mapped_mesh2d.edge_nodes + edge_nodes.size()));
+    ASSERT_EQ(face_nodes, std::vector<int>(mapped_mesh2d.face_nodes, mapped_mesh2d.face_nodes + face_nodes.size()));
+
+    // Another start index converts the view in place, leaving the fill values
+    mapped_mesh2d.start_index = 1;
+    error_code = ugridapi::ug_mesh2d_get_mapped(mapped_file_id, 0, mapped_mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    for (size_t i = 0; i < face_nodes.size(); ++i)
+    {
+        ASSERT_EQ(face_nodes[i] < 0 ? face_nodes[i] : face_nodes[i] + 1, mapped_mesh2d.face_nodes[i]);
+    }
+    error_code = ugridapi::ug_file_close(mapped_file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // NetCDF-4 files are not mapped
+    std::string const netcdf4_file_path = TEST_WRITE_FOLDER + "/MappedNetCDF4.nc";
+    int replace_mode = -1;
+    ugridapi::ug_file_replace_mode(replace_mode);
+    int netcdf4_format = -1;
+    ugridapi::ug_file_netcdf4_format(netcdf4_format);
+    error_code = ugridapi::ug_file_open_with_format(netcdf4_file_path.c_str(), replace_mode, netcdf4_format, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open_mapped(netcdf4_file_path.c_str(), mapped_file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+}
+
+TEST(ApiTest, OpenDisklessAndFromMemory_OnGeneratedMesh2D_ShouldWriteOnCloseAndReadBuffer)
+{
+    std::string const file_path = TEST_WRITE_FOLDER + "/DisklessMesh2D.nc";
+    auto const mesh2d = generate_mixed_polygons("mesh2d", 20, 10, 6, 7);
+
+    // The file is built in memory and written on close
+    int file_mode = -1;
+    auto error_code = ugridapi::ug_file_replace_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_format = -1;
+    error_code = ugridapi::ug_file_classic_format(file_format);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int file_id = -1;
+    error_code = ugridapi::ug_file_open_diskless(file_path.c_str(), file_mode, file_format, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int topology_id = -1;
+    error_code = ugridapi::ug_mesh2d_def(file_id, mesh2d.mesh2d, topology_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d.mesh2d);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // The written file is read from a buffer, as if received over a network
+    std::ifstream stream(file_path, std::ios::binary);
+    std::vector<char> const buffer((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    ASSERT_FALSE(buffer.empty());
+    error_code = ugridapi::ug_file_open_memory("DisklessMesh2D", buffer.data(), static_cast<int64_t>(buffer.size()), file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    ugridapi::Mesh2D mesh2d_api;
+    error_code = ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.mesh2d.num_faces, mesh2d_api.num_faces);
+    std::vector<double> node_x(mesh2d.node_x.size());
+    std::vector<int> face_nodes(mesh2d.face_nodes.size());
+    mesh2d_api.node_x = node_x.data();
+    mesh2d_api.face_nodes = face_nodes.data();
+    error_code = ugridapi::ug_mesh2d_get(file_id, 0, mesh2d_api);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(mesh2d.node_x, node_x);
+    ASSERT_EQ(mesh2d.face_nodes, face_nodes);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // An existing file is read into memory at once
+    error_code = ugridapi::ug_file_read_mode(file_mode);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    error_code = ugridapi::ug_file_open_diskless(file_path.c_str(), file_mode, file_format, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    int mesh2d_count = 0;
+    error_code = ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::Mesh2dTopology, mesh2d_count);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+    ASSERT_EQ(1, mesh2d_count);
+    error_code = ugridapi::ug_file_close(file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Success, error_code);
+
+    // Buffers that do not hold a netCDF file are rejected
+    std::vector<char> const invalid_buffer(1024, 'x');
+    error_code = ugridapi::ug_file_open_memory("Invalid", invalid_buffer.data(), static_cast<int64_t>(invalid_buffer.size()), file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+    error_code = ugridapi::ug_file_open_memory("Empty", nullptr, 0, file_id);
+    ASSERT_EQ(ugridapi::UGridioApiErrors::Exception, error_code);
+}
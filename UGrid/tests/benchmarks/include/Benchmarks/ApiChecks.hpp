@@ -0,0 +1,45 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <UGridAPI/UGrid.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// @brief Formats the failure of an api call with the latest error message raised on the calling thread
+/// @param call The name of the api call
+/// @return The message
+static std::string get_api_error(std::string const& call)
+{
+    std::vector<char> error_message(ugridapi::error_message_buffer_size);
+    ugridapi::ug_error_get(error_message.data());
+    return call + " failed: " + error_message.data();
+}
+
+/// @brief Throws if an api call failed, while preparing the files of a benchmark
+/// @param error_code The error code returned by the call
+/// @param call The name of the api call
+static void throw_on_api_error(int error_code, std::string const& call)
+{
+    if (error_code != ugridapi::UGridioApiErrors::Success)
+    {
+        throw std::runtime_error(get_api_error(call));
+    }
+}
+
+/// @brief Skips a benchmark if an api call failed
+/// @param state The benchmark state
+/// @param error_code The error code returned by the call
+/// @param call The name of the api call
+/// @return True if the call succeeded, false if the benchmark is skipped and should return
+static bool skip_on_api_error(benchmark::State& state, int error_code, std::string const& call)
+{
+    if (error_code == ugridapi::UGridioApiErrors::Success)
+    {
+        return true;
+    }
+    state.SkipWithError(get_api_error(call).c_str());
+    return false;
+}
@@ -0,0 +1,507 @@
+#include <benchmark/benchmark.h>
+
+#include <Benchmarks/ApiChecks.hpp>
+#include <TestUtils/Definitions.hpp>
+#include <TestUtils/MeshGenerator.hpp>
+#include <TestUtils/Utils.hpp>
+#include <UGridAPI/UGrid.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+/// @brief Opens a file
+/// @param file_path The path of the file
+/// @param replace If the file is created (or replaced), otherwise it is opened for reading
+/// @param file_id The file id
+/// @return The error code of the api calls
+static int open_file(std::string const& file_path, bool replace, int& file_id)
+{
+    int file_mode = -1;
+    auto const error_code = replace ? ugridapi::ug_file_replace_mode(file_mode) : ugridapi::ug_file_read_mode(file_mode);
+    if (error_code != ugridapi::UGridioApiErrors::Success)
+    {
+        return error_code;
+    }
+    return ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id);
+}
+
+/// @brief Generates a square-ish structured quad mesh2d
+/// @param min_num_faces The minimum number of faces
+/// @return The mesh
+static GeneratedMesh2D generate_mesh2d(int min_num_faces)
+{
+    int const nx = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(min_num_faces))));
+    int const ny = (min_num_faces + nx - 1) / nx;
+    return generate_structured_quads("mesh2d", nx, ny);
+}
+
+/// @brief Writes a structured mesh2d and a double variable on its faces
+/// @param file_path The path of the file to create
+/// @param mesh The mesh to write
+static void write_mesh2d_file(std::string const& file_path, GeneratedMesh2D const& mesh)
+{
+    int file_id = -1;
+    throw_on_api_error(open_file(file_path, true, file_id), "ug_file_open");
+
+    int topology_id = -1;
+    throw_on_api_error(ugridapi::ug_mesh2d_def(file_id, mesh.mesh2d, topology_id), "ug_mesh2d_def");
+
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_face_values", ugridapi::name_long_length, variable_name.data());
+    std::vector<char> dimension_name(ugridapi::name_long_length);
+    string_to_char_array("time", ugridapi::name_long_length, dimension_name.data());
+    throw_on_api_error(ugridapi::ug_topology_define_double_variable_on_location(file_id,
+                                                                                ugridapi::TopologyType::Mesh2dTopology,
+                                                                                topology_id,
+                                                                                ugridapi::MeshLocations::Faces,
+                                                                                variable_name.data(),
+                                                                                dimension_name.data(),
+                                                                                1),
+                       "ug_topology_define_double_variable_on_location");
+
+    throw_on_api_error(ugridapi::ug_mesh2d_put(file_id, topology_id, mesh.mesh2d), "ug_mesh2d_put");
+    std::vector<double> const face_values(mesh.mesh2d.num_faces, 1.0);
+    throw_on_api_error(ugridapi::ug_variable_put_data_double(file_id, variable_name.data(), face_values.data()), "ug_variable_put_data_double");
+
+    throw_on_api_error(ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+
+/// @brief Writes a file with a structured mesh2d of a given number of faces, shared by the read benchmarks.
+///        The benchmark is skipped if the file cannot be written
+class Mesh2DFileFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) override
+    {
+        auto const num_faces = static_cast<int>(state.range(0));
+        m_file_path = TEST_WRITE_FOLDER + "/BenchmarkMesh2D_" + std::to_string(num_faces) + ".nc";
+        m_mesh = std::make_unique<GeneratedMesh2D>(generate_mesh2d(num_faces));
+        try
+        {
+            write_mesh2d_file(m_file_path, *m_mesh);
+        }
+        catch (std::exception const& exception)
+        {
+            state.SkipWithError(exception.what());
+        }
+    }
+
+    void TearDown(benchmark::State const& /*state*/) override
+    {
+        m_mesh.reset();
+    }
+
+protected:
+    std::string m_file_path;
+    std::unique_ptr<GeneratedMesh2D> m_mesh;
+};
+
+/// @brief Registers a benchmark over synthetic mesh sizes, from 10^3 faces up to UGRID_BENCHMARKS_MAX_FACES
+static void mesh_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(10)->Range(1000, UGRID_BENCHMARKS_MAX_FACES)->Unit(benchmark::kMillisecond);
+}
+
+static void Mesh2DDefAndPut(benchmark::State& state)
+{
+    auto const mesh = generate_mesh2d(static_cast<int>(state.range(0)));
+    std::string const file_path = TEST_WRITE_FOLDER + "/BenchmarkMesh2DWrite_" + std::to_string(state.range(0)) + ".nc";
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        int topology_id = -1;
+        if (!skip_on_api_error(state, open_file(file_path, true, file_id), "ug_file_open") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_def(file_id, mesh.mesh2d, topology_id), "ug_mesh2d_def") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_put(file_id, topology_id, mesh.mesh2d), "ug_mesh2d_put") ||
+            !skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * mesh.num_bytes());
+    state.SetItemsProcessed(state.iterations() * mesh.mesh2d.num_faces);
+}
+BENCHMARK(Mesh2DDefAndPut)->Apply(mesh_sizes);
+
+static void Mesh2DDisklessDefAndPut(benchmark::State& state)
+{
+    auto const mesh = generate_mesh2d(static_cast<int>(state.range(0)));
+    std::string const file_path = TEST_WRITE_FOLDER + "/BenchmarkMesh2DDisklessWrite_" + std::to_string(state.range(0)) + ".nc";
+    int file_mode = -1;
+    int file_format = -1;
+    if (!skip_on_api_error(state, ugridapi::ug_file_replace_mode(file_mode), "ug_file_replace_mode") ||
+        !skip_on_api_error(state, ugridapi::ug_file_classic_format(file_format), "ug_file_classic_format"))
+    {
+        return;
+    }
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        int topology_id = -1;
+        if (!skip_on_api_error(state, ugridapi::ug_file_open_diskless(file_path.c_str(), file_mode, file_format, file_id), "ug_file_open_diskless") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_def(file_id, mesh.mesh2d, topology_id), "ug_mesh2d_def") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_put(file_id, topology_id, mesh.mesh2d), "ug_mesh2d_put") ||
+            !skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * mesh.num_bytes());
+    state.SetItemsProcessed(state.iterations() * mesh.mesh2d.num_faces);
+}
+BENCHMARK(Mesh2DDisklessDefAndPut)->Apply(mesh_sizes);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, Mesh2DGet)(benchmark::State& state)
+{
+    int file_id = -1;
+    if (!skip_on_api_error(state, open_file(m_file_path, false, file_id), "ug_file_open"))
+    {
+        return;
+    }
+
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<double> node_x(m_mesh->node_x.size());
+    std::vector<double> node_y(m_mesh->node_y.size());
+    std::vector<int> edge_nodes(m_mesh->edge_nodes.size());
+    std::vector<int> face_nodes(m_mesh->face_nodes.size());
+    ugridapi::Mesh2D mesh2d;
+    mesh2d.name = name.data();
+    mesh2d.node_x = node_x.data();
+    mesh2d.node_y = node_y.data();
+    mesh2d.edge_nodes = edge_nodes.data();
+    mesh2d.face_nodes = face_nodes.data();
+    if (skip_on_api_error(state, ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d), "ug_mesh2d_inq"))
+    {
+        for (auto _ : state)
+        {
+            if (!skip_on_api_error(state, ugridapi::ug_mesh2d_get(file_id, 0, mesh2d), "ug_mesh2d_get"))
+            {
+                break;
+            }
+            benchmark::DoNotOptimize(face_nodes.data());
+        }
+        state.SetBytesProcessed(state.iterations() * m_mesh->num_bytes());
+        state.SetItemsProcessed(state.iterations() * m_mesh->mesh2d.num_faces);
+    }
+
+    skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, Mesh2DGet)->Apply(mesh_sizes);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, VariableGetDataDouble)(benchmark::State& state)
+{
+    int file_id = -1;
+    if (!skip_on_api_error(state, open_file(m_file_path, false, file_id), "ug_file_open"))
+    {
+        return;
+    }
+
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d_face_values", ugridapi::name_long_length, variable_name.data());
+    std::vector<double> face_values(m_mesh->mesh2d.num_faces);
+
+    for (auto _ : state)
+    {
+        if (!skip_on_api_error(state, ugridapi::ug_variable_get_data_double(file_id, variable_name.data(), face_values.data()), "ug_variable_get_data_double"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(face_values.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(face_values.size() * sizeof(double)));
+    state.SetItemsProcessed(state.iterations() * m_mesh->mesh2d.num_faces);
+
+    skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, VariableGetDataDouble)->Apply(mesh_sizes);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, OpenAndInquireMesh2D)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        ugridapi::Mesh2D mesh2d;
+        if (!skip_on_api_error(state, open_file(m_file_path, false, file_id), "ug_file_open") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d), "ug_mesh2d_inq") ||
+            !skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(mesh2d.num_faces);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, OpenAndInquireMesh2D)->Apply(mesh_sizes);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, OpenAndGetMesh2D)(benchmark::State& state)
+{
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<double> node_x(m_mesh->node_x.size());
+    std::vector<double> node_y(m_mesh->node_y.size());
+    std::vector<int> edge_nodes(m_mesh->edge_nodes.size());
+    std::vector<int> face_nodes(m_mesh->face_nodes.size());
+
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        ugridapi::Mesh2D mesh2d;
+        mesh2d.name = name.data();
+        mesh2d.node_x = node_x.data();
+        mesh2d.node_y = node_y.data();
+        mesh2d.edge_nodes = edge_nodes.data();
+        mesh2d.face_nodes = face_nodes.data();
+        if (!skip_on_api_error(state, open_file(m_file_path, false, file_id), "ug_file_open") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d), "ug_mesh2d_inq") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_get(file_id, 0, mesh2d), "ug_mesh2d_get"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(mesh2d.face_nodes[mesh2d.num_faces - 1]);
+        if (!skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * m_mesh->num_bytes());
+    state.SetItemsProcessed(state.iterations() * m_mesh->mesh2d.num_faces);
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, OpenAndGetMesh2D)->Apply(mesh_sizes);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, OpenAndGetMappedMesh2D)(benchmark::State& state)
+{
+    std::vector<char> name(ugridapi::name_long_length);
+
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        ugridapi::Mesh2D mesh2d;
+        mesh2d.name = name.data();
+        if (!skip_on_api_error(state, ugridapi::ug_file_open_mapped(m_file_path.c_str(), file_id), "ug_file_open_mapped") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d), "ug_mesh2d_inq") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_get_mapped(file_id, 0, mesh2d), "ug_mesh2d_get_mapped"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(mesh2d.face_nodes[mesh2d.num_faces - 1]);
+        if (!skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * m_mesh->num_bytes());
+    state.SetItemsProcessed(state.iterations() * m_mesh->mesh2d.num_faces);
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, OpenAndGetMappedMesh2D)->Apply(mesh_sizes);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, OpenMemoryAndGetMesh2D)(benchmark::State& state)
+{
+    std::ifstream stream(m_file_path, std::ios::binary);
+    std::vector<char> const buffer((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<double> node_x(m_mesh->node_x.size());
+    std::vector<double> node_y(m_mesh->node_y.size());
+    std::vector<int> edge_nodes(m_mesh->edge_nodes.size());
+    std::vector<int> face_nodes(m_mesh->face_nodes.size());
+
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        ugridapi::Mesh2D mesh2d;
+        mesh2d.name = name.data();
+        mesh2d.node_x = node_x.data();
+        mesh2d.node_y = node_y.data();
+        mesh2d.edge_nodes = edge_nodes.data();
+        mesh2d.face_nodes = face_nodes.data();
+        if (!skip_on_api_error(state, ugridapi::ug_file_open_memory(m_file_path.c_str(), buffer.data(), static_cast<int64_t>(buffer.size()), file_id), "ug_file_open_memory") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_inq(file_id, 0, mesh2d), "ug_mesh2d_inq") ||
+            !skip_on_api_error(state, ugridapi::ug_mesh2d_get(file_id, 0, mesh2d), "ug_mesh2d_get"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(mesh2d.face_nodes[mesh2d.num_faces - 1]);
+        if (!skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * m_mesh->num_bytes());
+    state.SetItemsProcessed(state.iterations() * m_mesh->mesh2d.num_faces);
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, OpenMemoryAndGetMesh2D)->Apply(mesh_sizes);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, TopologyAttributesEnumeration)(benchmark::State& state)
+{
+    int file_id = -1;
+    if (!skip_on_api_error(state, open_file(m_file_path, false, file_id), "ug_file_open"))
+    {
+        return;
+    }
+
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    string_to_char_array("mesh2d", ugridapi::name_long_length, variable_name.data());
+
+    int attributes_count = 0;
+    if (skip_on_api_error(state, ugridapi::ug_variable_count_attributes(file_id, variable_name.data(), attributes_count), "ug_variable_count_attributes"))
+    {
+        std::vector<char> names(static_cast<size_t>(attributes_count) * ugridapi::name_long_length);
+        for (auto _ : state)
+        {
+            int max_length = 0;
+            if (!skip_on_api_error(state, ugridapi::ug_variable_get_attributes_max_length(file_id, variable_name.data(), max_length), "ug_variable_get_attributes_max_length"))
+            {
+                break;
+            }
+            std::vector<char> values(static_cast<size_t>(attributes_count) * max_length);
+            if (!skip_on_api_error(state, ugridapi::ug_variable_get_attributes_names(file_id, variable_name.data(), names.data()), "ug_variable_get_attributes_names") ||
+                !skip_on_api_error(state, ugridapi::ug_variable_get_attributes_values(file_id, variable_name.data(), max_length, values.data()), "ug_variable_get_attributes_values"))
+            {
+                break;
+            }
+            benchmark::DoNotOptimize(values.data());
+        }
+        state.SetItemsProcessed(state.iterations() * attributes_count);
+    }
+
+    skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, TopologyAttributesEnumeration)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(Mesh2DFileFixture, Mesh2DDeriveConnectivity)(benchmark::State& state)
+{
+    int file_id = -1;
+    if (!skip_on_api_error(state, open_file(m_file_path, false, file_id), "ug_file_open"))
+    {
+        return;
+    }
+    auto const num_threads = static_cast<int>(state.range(1));
+
+    for (auto _ : state)
+    {
+        if (!skip_on_api_error(state, ugridapi::ug_mesh2d_derive_connectivity(file_id, 0, num_threads), "ug_mesh2d_derive_connectivity"))
+        {
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * m_mesh->mesh2d.num_faces);
+
+    skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+BENCHMARK_REGISTER_F(Mesh2DFileFixture, Mesh2DDeriveConnectivity)
+    ->ArgsProduct({{100000, UGRID_BENCHMARKS_MAX_FACES}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond);
+
+static void FaceLocatorFindFaces(benchmark::State& state)
+{
+    auto const mesh = generate_mesh2d(static_cast<int>(state.range(0)));
+    int locator_id = -1;
+    if (!skip_on_api_error(state, ugridapi::ug_face_locator_create(mesh.mesh2d, 0, locator_id), "ug_face_locator_create"))
+    {
+        return;
+    }
+
+    // Points spread over the mesh, on a grid that does not align with the faces
+    size_t const num_points = 100000;
+    auto const max_x = mesh.node_x.back();
+    auto const max_y = mesh.node_y.back();
+    std::vector<double> x(num_points);
+    std::vector<double> y(num_points);
+    for (size_t i = 0; i < num_points; ++i)
+    {
+        x[i] = std::fmod(static_cast<double>(i) * 0.618034 * max_x, max_x);
+        y[i] = static_cast<double>(i) / static_cast<double>(num_points) * max_y;
+    }
+    std::vector<int> faces(num_points);
+
+    for (auto _ : state)
+    {
+        if (!skip_on_api_error(state, ugridapi::ug_face_locator_find_faces(locator_id, static_cast<int>(num_points), x.data(), y.data(), 1, faces.data()), "ug_face_locator_find_faces"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(faces.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_points));
+
+    skip_on_api_error(state, ugridapi::ug_face_locator_destroy(locator_id), "ug_face_locator_destroy");
+}
+BENCHMARK(FaceLocatorFindFaces)->Apply(mesh_sizes);
+
+static void Mesh2DPartitionFaces(benchmark::State& state)
+{
+    auto const mesh = generate_mesh2d(static_cast<int>(state.range(0)));
+    auto const num_threads = static_cast<int>(state.range(1));
+    std::vector<int> face_domains(static_cast<size_t>(mesh.mesh2d.num_faces));
+
+    for (auto _ : state)
+    {
+        if (!skip_on_api_error(state, ugridapi::ug_mesh2d_partition_faces(mesh.mesh2d, 16, num_threads, face_domains.data()), "ug_mesh2d_partition_faces"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(face_domains.data());
+    }
+    state.SetItemsProcessed(state.iterations() * mesh.mesh2d.num_faces);
+}
+BENCHMARK(Mesh2DPartitionFaces)
+    ->ArgsProduct({{100000, UGRID_BENCHMARKS_MAX_FACES}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond);
+
+/// @brief Gathers the node x coordinates of every face, the memory access pattern of face based discretisations
+/// @param mesh [in] The mesh
+/// @return The sum of the gathered coordinates
+static double gather_face_node_x(ugridapi::Mesh2D const& mesh)
+{
+    auto const num_face_nodes_max = static_cast<size_t>(mesh.num_face_nodes_max);
+    auto const size = static_cast<size_t>(mesh.num_faces) * num_face_nodes_max;
+    double sum = 0.0;
+    for (size_t position = 0; position < size; ++position)
+    {
+        if (auto const node = mesh.face_nodes[position]; node != mesh.int_fill_value)
+        {
+            sum += mesh.node_x[node];
+        }
+    }
+    return sum;
+}
+
+/// @brief Face to node gathers on a shuffled mesh (second argument 0) and on the same mesh renumbered along the Hilbert curve (1)
+static void Mesh2DFaceNodeGather(benchmark::State& state)
+{
+    auto mesh = generate_mesh2d(static_cast<int>(state.range(0)));
+    shuffle_mesh2d(42, mesh);
+    if (state.range(1) != 0 &&
+        !skip_on_api_error(state, ugridapi::ug_mesh2d_renumber_hilbert(mesh.mesh2d, 0, nullptr, nullptr, nullptr), "ug_mesh2d_renumber_hilbert"))
+    {
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(gather_face_node_x(mesh.mesh2d));
+    }
+    state.SetItemsProcessed(state.iterations() * mesh.mesh2d.num_faces);
+}
+BENCHMARK(Mesh2DFaceNodeGather)
+    ->ArgsProduct({{100000, UGRID_BENCHMARKS_MAX_FACES}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+static void Mesh2DRenumberHilbert(benchmark::State& state)
+{
+    auto const num_threads = static_cast<int>(state.range(1));
+    auto mesh = generate_mesh2d(static_cast<int>(state.range(0)));
+    shuffle_mesh2d(42, mesh);
+
+    for (auto _ : state)
+    {
+        if (!skip_on_api_error(state, ugridapi::ug_mesh2d_renumber_hilbert(mesh.mesh2d, num_threads, nullptr, nullptr, nullptr), "ug_mesh2d_renumber_hilbert"))
+        {
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * mesh.mesh2d.num_faces);
+}
+BENCHMARK(Mesh2DRenumberHilbert)
+    ->ArgsProduct({{100000, UGRID_BENCHMARKS_MAX_FACES}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <Benchmarks/ApiChecks.hpp>
+#include <TestUtils/Definitions.hpp>
+#include <TestUtils/MeshGenerator.hpp>
+#include <TestUtils/Utils.hpp>
+#include <UGridAPI/UGrid.hpp>
+
+/// @brief Writes a network1d to a new file
+/// @param file_path The path of the file to create
+/// @param network The network to write
+static void write_network1d_file(std::string const& file_path, GeneratedNetwork1D const& network)
+{
+    int file_mode = -1;
+    throw_on_api_error(ugridapi::ug_file_replace_mode(file_mode), "ug_file_replace_mode");
+    int file_id = -1;
+    throw_on_api_error(ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id), "ug_file_open");
+    int topology_id = -1;
+    throw_on_api_error(ugridapi::ug_network1d_def(file_id, network.network1d, topology_id), "ug_network1d_def");
+    throw_on_api_error(ugridapi::ug_network1d_put(file_id, topology_id, network.network1d), "ug_network1d_put");
+    throw_on_api_error(ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+
+/// @brief Writes a file with a dendritic network1d of a given number of branches.
+///        The benchmark is skipped if the file cannot be written
+class Network1DFileFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) override
+    {
+        auto const num_edges = static_cast<int>(state.range(0));
+        m_file_path = TEST_WRITE_FOLDER + "/BenchmarkNetwork1D_" + std::to_string(num_edges) + ".nc";
+        m_network = std::make_unique<GeneratedNetwork1D>(generate_dendritic_network1d("network1d", num_edges, 42));
+        try
+        {
+            write_network1d_file(m_file_path, *m_network);
+        }
+        catch (std::exception const& exception)
+        {
+            state.SkipWithError(exception.what());
+        }
+    }
+
+    void TearDown(benchmark::State const& /*state*/) override
+    {
+        m_network.reset();
+    }
+
+protected:
+    std::string m_file_path;
+    std::unique_ptr<GeneratedNetwork1D> m_network;
+};
+
+BENCHMARK_DEFINE_F(Network1DFileFixture, Network1DGet)(benchmark::State& state)
+{
+    int file_mode = -1;
+    int file_id = -1;
+    if (!skip_on_api_error(state, ugridapi::ug_file_read_mode(file_mode), "ug_file_read_mode") ||
+        !skip_on_api_error(state, ugridapi::ug_file_open(m_file_path.c_str(), file_mode, file_id), "ug_file_open"))
+    {
+        return;
+    }
+
+    std::vector<char> name(ugridapi::name_long_length);
+    std::vector<double> node_x(m_network->node_x.size());
+    std::vector<double> node_y(m_network->node_y.size());
+    std::vector<int> edge_nodes(m_network->edge_nodes.size());
+    std::vector<double> edge_length(m_network->edge_length.size());
+    std::vector<double> geometry_nodes_x(m_network->geometry_nodes_x.size());
+    std::vector<double> geometry_nodes_y(m_network->geometry_nodes_y.size());
+    std::vector<int> num_edge_geometry_nodes(m_network->num_edge_geometry_nodes.size());
+    ugridapi::Network1D network1d;
+    network1d.name = name.data();
+    network1d.node_x = node_x.data();
+    network1d.node_y = node_y.data();
+    network1d.edge_nodes = edge_nodes.data();
+    network1d.edge_length = edge_length.data();
+    network1d.geometry_nodes_x = geometry_nodes_x.data();
+    network1d.geometry_nodes_y = geometry_nodes_y.data();
+    network1d.num_edge_geometry_nodes = num_edge_geometry_nodes.data();
+    if (skip_on_api_error(state, ugridapi::ug_network1d_inq(file_id, 0, network1d), "ug_network1d_inq"))
+    {
+        for (auto _ : state)
+        {
+            if (!skip_on_api_error(state, ugridapi::ug_network1d_get(file_id, 0, network1d), "ug_network1d_get"))
+            {
+                break;
+            }
+            benchmark::DoNotOptimize(geometry_nodes_x.data());
+        }
+        state.SetBytesProcessed(state.iterations() * m_network->num_bytes());
+        state.SetItemsProcessed(state.iterations() * m_network->network1d.num_edges);
+    }
+
+    skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+BENCHMARK_REGISTER_F(Network1DFileFixture, Network1DGet)
+    ->RangeMultiplier(10)
+    ->Range(1000, UGRID_BENCHMARKS_MAX_FACES)
+    ->Unit(benchmark::kMillisecond);
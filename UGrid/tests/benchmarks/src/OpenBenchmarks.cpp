@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <Benchmarks/ApiChecks.hpp>
+#include <TestUtils/Definitions.hpp>
+#include <TestUtils/Utils.hpp>
+#include <UGridAPI/UGrid.hpp>
+
+/// @brief Creates a file with a single-face mesh2d followed by the given number of plain variables
+/// @param file_path The path of the file to create
+/// @param num_variables The number of variables not related to the topology
+static void create_file_with_mesh2d_and_variables(std::string const& file_path, int num_variables)
+{
+    int file_mode = -1;
+    throw_on_api_error(ugridapi::ug_file_replace_mode(file_mode), "ug_file_replace_mode");
+    int file_id = -1;
+    throw_on_api_error(ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id), "ug_file_open");
+
+    ugridapi::Mesh2D mesh2d;
+    std::vector<char> name(ugridapi::name_length);
+    string_to_char_array("mesh2d", ugridapi::name_length, name.data());
+    mesh2d.name = name.data();
+    std::vector<double> node_x{0.0, 1.0, 1.0, 0.0};
+    std::vector<double> node_y{0.0, 0.0, 1.0, 1.0};
+    mesh2d.node_x = node_x.data();
+    mesh2d.node_y = node_y.data();
+    mesh2d.num_nodes = 4;
+    std::vector<int> edge_nodes{0, 1, 1, 2, 2, 3, 3, 0};
+    mesh2d.edge_nodes = edge_nodes.data();
+    mesh2d.num_edges = 4;
+    std::vector<int> face_nodes{0, 1, 2, 3};
+    mesh2d.face_nodes = face_nodes.data();
+    mesh2d.num_faces = 1;
+    mesh2d.num_face_nodes_max = 4;
+
+    int topology_id = -1;
+    throw_on_api_error(ugridapi::ug_mesh2d_def(file_id, mesh2d, topology_id), "ug_mesh2d_def");
+
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    for (int i = 0; i < num_variables; ++i)
+    {
+        string_to_char_array("variable_" + std::to_string(i), ugridapi::name_long_length, variable_name.data());
+        throw_on_api_error(ugridapi::ug_variable_double_define(file_id, variable_name.data()), "ug_variable_double_define");
+    }
+
+    throw_on_api_error(ugridapi::ug_mesh2d_put(file_id, topology_id, mesh2d), "ug_mesh2d_put");
+    throw_on_api_error(ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+
+/// @brief Creates a file with a given number of variables, shared by the open benchmarks.
+///        The benchmark is skipped if the file cannot be created
+class OpenFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) override
+    {
+        auto const num_variables = static_cast<int>(state.range(0));
+        m_file_path = TEST_WRITE_FOLDER + "/BenchmarkOpen_" + std::to_string(num_variables) + ".nc";
+        try
+        {
+            create_file_with_mesh2d_and_variables(m_file_path, num_variables);
+            throw_on_api_error(ugridapi::ug_file_read_mode(m_file_mode), "ug_file_read_mode");
+        }
+        catch (std::exception const& exception)
+        {
+            state.SkipWithError(exception.what());
+        }
+    }
+
+protected:
+    std::string m_file_path;
+    int m_file_mode = -1;
+};
+
+BENCHMARK_DEFINE_F(OpenFixture, OpenAndDiscover)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        int topology_count = 0;
+        if (!skip_on_api_error(state, ugridapi::ug_file_open(m_file_path.c_str(), m_file_mode, file_id), "ug_file_open") ||
+            !skip_on_api_error(state, ugridapi::ug_topology_get_count(file_id, ugridapi::TopologyType::Mesh2dTopology, topology_count), "ug_topology_get_count") ||
+            !skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(topology_count);
+    }
+}
+BENCHMARK_REGISTER_F(OpenFixture, OpenAndDiscover)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(OpenFixture, OpenDeferred)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int file_id = -1;
+        if (!skip_on_api_error(state, ugridapi::ug_file_open_deferred(m_file_path.c_str(), m_file_mode, file_id), "ug_file_open_deferred") ||
+            !skip_on_api_error(state, ugridapi::ug_file_close(file_id), "ug_file_close"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(file_id);
+    }
+}
+BENCHMARK_REGISTER_F(OpenFixture, OpenDeferred)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMillisecond);
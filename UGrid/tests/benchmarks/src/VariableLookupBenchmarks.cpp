@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <Benchmarks/ApiChecks.hpp>
+#include <TestUtils/Definitions.hpp>
+#include <TestUtils/Utils.hpp>
+#include <UGridAPI/UGrid.hpp>
+
+/// @brief Creates a file with the given number of variables, each carrying a few attributes
+/// @param file_path The path of the file to create
+/// @param num_variables The number of variables
+static void create_file_with_variables(std::string const& file_path, int num_variables)
+{
+    int file_mode = -1;
+    throw_on_api_error(ugridapi::ug_file_replace_mode(file_mode), "ug_file_replace_mode");
+    int file_id = -1;
+    throw_on_api_error(ugridapi::ug_file_open(file_path.c_str(), file_mode, file_id), "ug_file_open");
+
+    std::vector<char> variable_name(ugridapi::name_long_length);
+    std::vector<char> attribute_name(ugridapi::name_long_length);
+    string_to_char_array("long_name", ugridapi::name_long_length, attribute_name.data());
+    for (int i = 0; i < num_variables; ++i)
+    {
+        string_to_char_array("variable_" + std::to_string(i), ugridapi::name_long_length, variable_name.data());
+        throw_on_api_error(ugridapi::ug_variable_double_define(file_id, variable_name.data()), "ug_variable_double_define");
+
+        std::string const long_name = "Variable number " + std::to_string(i);
+        throw_on_api_error(ugridapi::ug_attribute_char_define(file_id, variable_name.data(), attribute_name.data(), long_name.c_str(), static_cast<int>(long_name.size())),
+                           "ug_attribute_char_define");
+    }
+
+    throw_on_api_error(ugridapi::ug_file_close(file_id), "ug_file_close");
+}
+
+/// @brief Opens a file with a given number of variables, shared by the lookup benchmarks.
+///        The benchmark is skipped if the file cannot be created or opened
+class VariableLookupFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) override
+    {
+        auto const num_variables = static_cast<int>(state.range(0));
+        std::string const file_path = TEST_WRITE_FOLDER + "/BenchmarkVariables_" + std::to_string(num_variables) + ".nc";
+        try
+        {
+            create_file_with_variables(file_path, num_variables);
+
+            int file_mode = -1;
+            throw_on_api_error(ugridapi::ug_file_read_mode(file_mode), "ug_file_read_mode");
+            throw_on_api_error(ugridapi::ug_file_open(file_path.c_str(), file_mode, m_file_id), "ug_file_open");
+        }
+        catch (std::exception const& exception)
+        {
+            state.SkipWithError(exception.what());
+        }
+
+        // Look up a variable in the middle of the file
+        m_variable_name.resize(ugridapi::name_long_length);
+        string_to_char_array("variable_" + std::to_string(num_variables / 2), ugridapi::name_long_length, m_variable_name.data());
+    }
+
+    void TearDown(benchmark::State& state) override
+    {
+        if (m_file_id >= 0)
+        {
+            skip_on_api_error(state, ugridapi::ug_file_close(m_file_id), "ug_file_close");
+            m_file_id = -1;
+        }
+    }
+
+protected:
+    int m_file_id = -1;
+    std::vector<char> m_variable_name;
+};
+
+BENCHMARK_DEFINE_F(VariableLookupFixture, VariableInq)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int exists = 0;
+        if (!skip_on_api_error(state, ugridapi::ug_variable_inq(m_file_id, m_variable_name.data(), &exists), "ug_variable_inq"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(exists);
+    }
+}
+BENCHMARK_REGISTER_F(VariableLookupFixture, VariableInq)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(VariableLookupFixture, VariableCountAttributes)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        int attributes_count = 0;
+        if (!skip_on_api_error(state, ugridapi::ug_variable_count_attributes(m_file_id, m_variable_name.data(), attributes_count), "ug_variable_count_attributes"))
+        {
+            break;
+        }
+        benchmark::DoNotOptimize(attributes_count);
+    }
+}
+BENCHMARK_REGISTER_F(VariableLookupFixture, VariableCountAttributes)
+    ->RangeMultiplier(10)
+    ->Range(10, 10000)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,176 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <UGridAPI/Contacts.hpp>
+#include <UGridAPI/Mesh1D.hpp>
+#include <UGridAPI/Mesh2D.hpp>
+#include <UGridAPI/Network1D.hpp>
+
+#include <cstdint>
+
+/// @brief A generated mesh2d, owning the arrays referenced by the api structure.
+///        Moving keeps the arrays in place, so the api structure stays valid; copying is disabled
+struct GeneratedMesh2D
+{
+    GeneratedMesh2D() = default;
+    GeneratedMesh2D(GeneratedMesh2D const&) = delete;
+    GeneratedMesh2D& operator=(GeneratedMesh2D const&) = delete;
+    GeneratedMesh2D(GeneratedMesh2D&&) = default;
+    GeneratedMesh2D& operator=(GeneratedMesh2D&&) = default;
+
+    /// @brief Gets the number of bytes of the node coordinates and the connectivity arrays
+    /// @return The number of bytes
+    [[nodiscard]] int64_t num_bytes() const;
+
+    ugridapi::Mesh2D mesh2d;     ///< The api structure, referencing the arrays below
+    std::vector<char> name;      ///< The mesh name
+    std::vector<double> node_x;  ///< The node x coordinates
+    std::vector<double> node_y;  ///< The node y coordinates
+    std::vector<int> edge_nodes; ///< The edge node connectivity
+    std::vector<int> face_nodes; ///< The face node connectivity, padded with the int fill value
+};
+
+/// @brief A generated network1d, owning the arrays referenced by the api structure
+struct GeneratedNetwork1D
+{
+    GeneratedNetwork1D() = default;
+    GeneratedNetwork1D(GeneratedNetwork1D const&) = delete;
+    GeneratedNetwork1D& operator=(GeneratedNetwork1D const&) = delete;
+    GeneratedNetwork1D(GeneratedNetwork1D&&) = default;
+    GeneratedNetwork1D& operator=(GeneratedNetwork1D&&) = default;
+
+    /// @brief Gets the number of bytes of the numeric network arrays
+    /// @return The number of bytes
+    [[nodiscard]] int64_t num_bytes() const;
+
+    ugridapi::Network1D network1d;            ///< The api structure, referencing the arrays below
+    std::vector<char> name;                   ///< The network name
+    std::vector<double> node_x;               ///< The node x coordinates
+    std::vector<double> node_y;               ///< The node y coordinates
+    std::vector<int> edge_nodes;              ///< The edge node connectivity, from the upstream to the downstream node
+    std::vector<double> edge_length;          ///< The branch lengths, measured along the branch geometry
+    std::vector<double> geometry_nodes_x;     ///< The geometry node x coordinates
+    std::vector<double> geometry_nodes_y;     ///< The geometry node y coordinates
+    std::vector<int> num_edge_geometry_nodes; ///< The number of geometry nodes of each branch
+};
+
+/// @brief A generated mesh1d, owning the arrays referenced by the api structure
+struct GeneratedMesh1D
+{
+    GeneratedMesh1D() = default;
+    GeneratedMesh1D(GeneratedMesh1D const&) = delete;
+    GeneratedMesh1D& operator=(GeneratedMesh1D const&) = delete;
+    GeneratedMesh1D(GeneratedMesh1D&&) = default;
+    GeneratedMesh1D& operator=(GeneratedMesh1D&&) = default;
+
+    ugridapi::Mesh1D mesh1d;              ///< The api structure, referencing the arrays below
+    std::vector<char> name;               ///< The mesh name
+    std::vector<char> network_name;       ///< The name of the network the mesh is defined on
+    std::vector<double> node_x;           ///< The node x coordinates
+    std::vector<double> node_y;           ///< The node y coordinates
+    std::vector<int> node_edge_id;        ///< The network branch of each node
+    std::vector<double> node_edge_offset; ///< The offset of each node along its branch
+    std::vector<int> edge_nodes;          ///< The edge node connectivity
+};
+
+/// @brief Generated contacts, owning the arrays referenced by the api structure
+struct GeneratedContacts
+{
+    GeneratedContacts() = default;
+    GeneratedContacts(GeneratedContacts const&) = delete;
+    GeneratedContacts& operator=(GeneratedContacts const&) = delete;
+    GeneratedContacts(GeneratedContacts&&) = default;
+    GeneratedContacts& operator=(GeneratedContacts&&) = default;
+
+    ugridapi::Contacts contacts;      ///< The api structure, referencing the arrays below
+    std::vector<char> name;           ///< The contacts name
+    std::vector<char> mesh_from_name; ///< The name of the mesh1d the contacts start from
+    std::vector<char> mesh_to_name;   ///< The name of the mesh2d the contacts end on
+    std::vector<int> edges;           ///< The (mesh1d node, mesh2d face) pairs
+    std::vector<int> contact_type;    ///< The type of each contact
+};
+
+/// @brief Generates a structured grid of unit quads
+/// @param name [in] The mesh name
+/// @param nx [in] The number of faces along x
+/// @param ny [in] The number of faces along y
+/// @return The mesh, with nx * ny faces
+GeneratedMesh2D generate_structured_quads(std::string const& name, int nx, int ny);
+
+/// @brief Generates a triangulated grid: each cell of a structured grid with perturbed nodes is split along a random diagonal
+/// @param name [in] The mesh name
+/// @param nx [in] The number of cells along x
+/// @param ny [in] The number of cells along y
+/// @param seed [in] The random seed, the same seed always gives the same mesh
+/// @return The mesh, with 2 * nx * ny faces
+GeneratedMesh2D generate_triangles(std::string const& name, int nx, int ny, uint64_t seed);
+
+/// @brief Generates a grid of mixed polygons: the cells of a structured grid with perturbed nodes are randomly
+///        split into triangles, kept as quads or merged along x with their neighbours into polygons of up to num_face_nodes_max nodes
+/// @param name [in] The mesh name
+/// @param nx [in] The number of cells along x
+/// @param ny [in] The number of cells along y
+/// @param num_face_nodes_max [in] The maximum number of nodes of a face (at least 3)
+/// @param seed [in] The random seed, the same seed always gives the same mesh
+/// @return The mesh
+GeneratedMesh2D generate_mixed_polygons(std::string const& name, int nx, int ny, int num_face_nodes_max, uint64_t seed);
+
+/// @brief Shuffles the nodes, edges and faces of a generated mesh2d, as an unstructured mesh generator would leave them,
+///        keeping the connectivity consistent
+/// @param seed [in] The random seed, the same seed always gives the same order
+/// @param mesh [in,out] The mesh
+void shuffle_mesh2d(uint64_t seed, GeneratedMesh2D& mesh);
+
+/// @brief Generates a dendritic river network: each new branch grows from a random existing node,
+///        deviating from the direction of its parent branch
+/// @param name [in] The network name
+/// @param num_edges [in] The number of branches
+/// @param seed [in] The random seed, the same seed always gives the same network
+/// @return The network, with num_edges + 1 nodes and three geometry nodes per branch
+GeneratedNetwork1D generate_dendritic_network1d(std::string const& name, int num_edges, uint64_t seed);
+
+/// @brief Generates a mesh1d on a network, with nodes at equal offsets along each branch
+/// @param name [in] The mesh name
+/// @param network [in] The network, generated by \ref generate_dendritic_network1d
+/// @param nodes_per_edge [in] The number of mesh1d nodes per branch, excluding the branch start node
+/// @return The mesh, with 1 + nodes_per_edge * num_edges nodes
+GeneratedMesh1D generate_mesh1d(std::string const& name, GeneratedNetwork1D const& network, int nodes_per_edge);
+
+/// @brief Generates contacts from random mesh1d nodes to random mesh2d faces
+/// @param name [in] The contacts name
+/// @param mesh1d [in] The mesh1d the contacts start from
+/// @param mesh2d [in] The mesh2d the contacts end on
+/// @param num_contacts [in] The number of contacts
+/// @param seed [in] The random seed, the same seed always gives the same contacts
+/// @return The contacts
+GeneratedContacts generate_contacts(std::string const& name,
+                                    GeneratedMesh1D const& mesh1d,
+                                    GeneratedMesh2D const& mesh2d,
+                                    int num_contacts,
+                                    uint64_t seed);
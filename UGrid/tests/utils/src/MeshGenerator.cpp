@@ -0,0 +1,566 @@
+//---- GPL ---------------------------------------------------------------------
+//
+// Copyright (C)  Stichting Deltares, 2011-2021.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation version 3.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// contact: delft3d.support@deltares.nl
+// Stichting Deltares
+// P.O. Box 177
+// 2600 MH Delft, The Netherlands
+//
+// All indications and logos of, and references to, "Delft3D" and "Deltares"
+// are registered trademarks of Stichting Deltares, and remain the property of
+// Stichting Deltares. All rights reserved.
+//
+//------------------------------------------------------------------------------
+
+#include <TestUtils/MeshGenerator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    /// @brief A small random generator (splitmix64) giving the same sequence on every platform and standard library
+    class RandomGenerator
+    {
+    public:
+        /// @brief Constructor
+        /// @param seed [in] The seed
+        explicit RandomGenerator(uint64_t seed) : m_state(seed)
+        {
+        }
+
+        /// @brief Gets the next random number
+        /// @return A uniformly distributed 64 bit number
+        uint64_t next()
+        {
+            uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        /// @brief Gets a random real number
+        /// @param min [in] The lower bound
+        /// @param max [in] The upper bound (excluded)
+        /// @return A uniformly distributed number in [min, max)
+        double uniform(double min, double max)
+        {
+            return min + (max - min) * static_cast<double>(next() >> 11) * 0x1.0p-53;
+        }
+
+        /// @brief Gets a random index
+        /// @param size [in] The number of indices
+        /// @return A uniformly distributed index in [0, size)
+        int index(int size)
+        {
+            return static_cast<int>(next() % static_cast<uint64_t>(size));
+        }
+
+    private:
+        uint64_t m_state; ///< The generator state
+    };
+
+    /// @brief Converts a name to a space padded, null terminated char array
+    /// @param name [in] The name
+    /// @param length [in] The length of the char array
+    /// @return The char array
+    std::vector<char> make_name(std::string const& name, size_t length)
+    {
+        if (name.empty() || name.size() >= length)
+        {
+            throw std::invalid_argument("make_name: The name " + name + " is empty or too long.");
+        }
+        std::vector<char> result(length, ' ');
+        std::copy(name.begin(), name.end(), result.begin());
+        result.back() = '\0';
+        return result;
+    }
+
+    /// @brief Adds the nodes of a structured grid, with the interior nodes optionally perturbed by up to a quarter of a cell
+    /// @param mesh [in,out] The mesh
+    /// @param nx [in] The number of cells along x
+    /// @param ny [in] The number of cells along y
+    /// @param random [in,out] The random generator used for the perturbation, or nullptr for a regular grid
+    void add_grid_nodes(GeneratedMesh2D& mesh, int nx, int ny, RandomGenerator* random)
+    {
+        if (nx < 1 || ny < 1)
+        {
+            throw std::invalid_argument("add_grid_nodes: The number of cells must be positive.");
+        }
+
+        auto const num_nodes = static_cast<size_t>(nx + 1) * static_cast<size_t>(ny + 1);
+        mesh.node_x.reserve(num_nodes);
+        mesh.node_y.reserve(num_nodes);
+        for (int j = 0; j <= ny; ++j)
+        {
+            for (int i = 0; i <= nx; ++i)
+            {
+                double x = static_cast<double>(i);
+                double y = static_cast<double>(j);
+                if (random != nullptr && i > 0 && i < nx && j > 0 && j < ny)
+                {
+                    x += random->uniform(-0.25, 0.25);
+                    y += random->uniform(-0.25, 0.25);
+                }
+                mesh.node_x.emplace_back(x);
+                mesh.node_y.emplace_back(y);
+            }
+        }
+    }
+
+    /// @brief Derives the edges from the face node connectivity, as the sorted unique node pairs of the face boundaries
+    /// @param mesh [in,out] The mesh
+    /// @param num_face_nodes_max [in] The maximum number of nodes of a face
+    void derive_edges(GeneratedMesh2D& mesh, int num_face_nodes_max)
+    {
+        auto const fill_value = mesh.mesh2d.int_fill_value;
+
+        std::vector<uint64_t> keys;
+        keys.reserve(mesh.face_nodes.size());
+        for (size_t face_start = 0; face_start < mesh.face_nodes.size(); face_start += num_face_nodes_max)
+        {
+            int num_nodes = 0;
+            while (num_nodes < num_face_nodes_max && mesh.face_nodes[face_start + num_nodes] != fill_value)
+            {
+                ++num_nodes;
+            }
+            for (int k = 0; k < num_nodes; ++k)
+            {
+                auto const first = static_cast<uint32_t>(mesh.face_nodes[face_start + k]);
+                auto const second = static_cast<uint32_t>(mesh.face_nodes[face_start + (k + 1) % num_nodes]);
+                keys.emplace_back(static_cast<uint64_t>(std::min(first, second)) << 32 | std::max(first, second));
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        mesh.edge_nodes.reserve(2 * keys.size());
+        for (auto const key : keys)
+        {
+            mesh.edge_nodes.emplace_back(static_cast<int>(key >> 32));
+            mesh.edge_nodes.emplace_back(static_cast<int>(key & 0xffffffffULL));
+        }
+    }
+
+    /// @brief Points the api structure to the arrays of a generated mesh2d
+    /// @param mesh [in,out] The mesh
+    /// @param num_face_nodes_max [in] The maximum number of nodes of a face
+    void set_mesh2d_arrays(GeneratedMesh2D& mesh, int num_face_nodes_max)
+    {
+        mesh.mesh2d.name = mesh.name.data();
+        mesh.mesh2d.node_x = mesh.node_x.data();
+        mesh.mesh2d.node_y = mesh.node_y.data();
+        mesh.mesh2d.num_nodes = static_cast<int>(mesh.node_x.size());
+        mesh.mesh2d.edge_nodes = mesh.edge_nodes.data();
+        mesh.mesh2d.num_edges = static_cast<int>(mesh.edge_nodes.size() / 2);
+        mesh.mesh2d.face_nodes = mesh.face_nodes.data();
+        mesh.mesh2d.num_faces = static_cast<int>(mesh.face_nodes.size() / num_face_nodes_max);
+        mesh.mesh2d.num_face_nodes_max = num_face_nodes_max;
+    }
+
+    /// @brief Gets the node index in a structured grid
+    /// @param nx [in] The number of cells along x
+    /// @param i [in] The node column
+    /// @param j [in] The node row
+    /// @return The node index
+    int grid_node(int nx, int i, int j)
+    {
+        return j * (nx + 1) + i;
+    }
+} // namespace
+
+int64_t GeneratedMesh2D::num_bytes() const
+{
+    return static_cast<int64_t>((node_x.size() + node_y.size()) * sizeof(double) +
+                                (edge_nodes.size() + face_nodes.size()) * sizeof(int));
+}
+
+int64_t GeneratedNetwork1D::num_bytes() const
+{
+    return static_cast<int64_t>((node_x.size() + node_y.size() + edge_length.size() + geometry_nodes_x.size() + geometry_nodes_y.size()) * sizeof(double) +
+                                (edge_nodes.size() + num_edge_geometry_nodes.size()) * sizeof(int));
+}
+
+GeneratedMesh2D generate_structured_quads(std::string const& name, int nx, int ny)
+{
+    GeneratedMesh2D mesh;
+    mesh.name = make_name(name, ugrid::name_length);
+    add_grid_nodes(mesh, nx, ny, nullptr);
+
+    // Horizontal edges, then vertical edges
+    mesh.edge_nodes.reserve(2 * (static_cast<size_t>(nx) * (ny + 1) + static_cast<size_t>(nx + 1) * ny));
+    for (int j = 0; j <= ny; ++j)
+    {
+        for (int i = 0; i < nx; ++i)
+        {
+            mesh.edge_nodes.emplace_back(grid_node(nx, i, j));
+            mesh.edge_nodes.emplace_back(grid_node(nx, i + 1, j));
+        }
+    }
+    for (int j = 0; j < ny; ++j)
+    {
+        for (int i = 0; i <= nx; ++i)
+        {
+            mesh.edge_nodes.emplace_back(grid_node(nx, i, j));
+            mesh.edge_nodes.emplace_back(grid_node(nx, i, j + 1));
+        }
+    }
+
+    mesh.face_nodes.reserve(4 * static_cast<size_t>(nx) * ny);
+    for (int j = 0; j < ny; ++j)
+    {
+        for (int i = 0; i < nx; ++i)
+        {
+            mesh.face_nodes.insert(mesh.face_nodes.end(),
+                                   {grid_node(nx, i, j), grid_node(nx, i + 1, j), grid_node(nx, i + 1, j + 1), grid_node(nx, i, j + 1)});
+        }
+    }
+
+    set_mesh2d_arrays(mesh, 4);
+    return mesh;
+}
+
+GeneratedMesh2D generate_triangles(std::string const& name, int nx, int ny, uint64_t seed)
+{
+    RandomGenerator random(seed);
+
+    GeneratedMesh2D mesh;
+    mesh.name = make_name(name, ugrid::name_length);
+    add_grid_nodes(mesh, nx, ny, &random);
+
+    mesh.face_nodes.reserve(6 * static_cast<size_t>(nx) * ny);
+    for (int j = 0; j < ny; ++j)
+    {
+        for (int i = 0; i < nx; ++i)
+        {
+            auto const a = grid_node(nx, i, j);
+            auto const b = grid_node(nx, i + 1, j);
+            auto const c = grid_node(nx, i + 1, j + 1);
+            auto const d = grid_node(nx, i, j + 1);
+            if (random.next() & 1)
+            {
+                mesh.face_nodes.insert(mesh.face_nodes.end(), {a, b, c, a, c, d});
+            }
+            else
+            {
+                mesh.face_nodes.insert(mesh.face_nodes.end(), {a, b, d, b, c, d});
+            }
+        }
+    }
+
+    derive_edges(mesh, 3);
+    set_mesh2d_arrays(mesh, 3);
+    return mesh;
+}
+
+GeneratedMesh2D generate_mixed_polygons(std::string const& name, int nx, int ny, int num_face_nodes_max, uint64_t seed)
+{
+    if (num_face_nodes_max < 3)
+    {
+        throw std::invalid_argument("generate_mixed_polygons: A face has at least 3 nodes.");
+    }
+
+    RandomGenerator random(seed);
+
+    GeneratedMesh2D mesh;
+    mesh.name = make_name(name, ugrid::name_length);
+    add_grid_nodes(mesh, nx, ny, &random);
+
+    auto const fill_value = mesh.mesh2d.int_fill_value;
+    auto const add_face = [&mesh, num_face_nodes_max, fill_value](std::vector<int> const& nodes)
+    {
+        mesh.face_nodes.insert(mesh.face_nodes.end(), nodes.begin(), nodes.end());
+        mesh.face_nodes.insert(mesh.face_nodes.end(), num_face_nodes_max - nodes.size(), fill_value);
+    };
+
+    // A polygon merging k cells along x has 2 * k + 2 nodes
+    int const max_merged_cells = (num_face_nodes_max - 2) / 2;
+    std::vector<int> nodes;
+    for (int j = 0; j < ny; ++j)
+    {
+        int i = 0;
+        while (i < nx)
+        {
+            auto const choice = random.uniform(0.0, 1.0);
+            int const mergeable_cells = std::min(max_merged_cells, nx - i);
+            if (max_merged_cells < 1 || choice < 0.25)
+            {
+                add_face({grid_node(nx, i, j), grid_node(nx, i + 1, j), grid_node(nx, i + 1, j + 1)});
+                add_face({grid_node(nx, i, j), grid_node(nx, i + 1, j + 1), grid_node(nx, i, j + 1)});
+                i += 1;
+                continue;
+            }
+
+            int const num_cells = choice < 0.5 && mergeable_cells >= 2 ? 2 + random.index(mergeable_cells - 1) : 1;
+            nodes.clear();
+            for (int k = 0; k <= num_cells; ++k)
+            {
+                nodes.emplace_back(grid_node(nx, i + k, j));
+            }
+            for (int k = num_cells; k >= 0; --k)
+            {
+                nodes.emplace_back(grid_node(nx, i + k, j + 1));
+            }
+            add_face(nodes);
+            i += num_cells;
+        }
+    }
+
+    derive_edges(mesh, num_face_nodes_max);
+    set_mesh2d_arrays(mesh, num_face_nodes_max);
+    return mesh;
+}
+
+void shuffle_mesh2d(uint64_t seed, GeneratedMesh2D& mesh)
+{
+    RandomGenerator random(seed);
+    auto const shuffled_indices = [&random](size_t size)
+    {
+        std::vector<int> indices(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            indices[i] = static_cast<int>(i);
+        }
+        for (auto i = static_cast<int>(size) - 1; i > 0; --i)
+        {
+            std::swap(indices[i], indices[random.index(i + 1)]);
+        }
+        return indices;
+    };
+    auto const num_face_nodes_max = static_cast<size_t>(mesh.mesh2d.num_face_nodes_max);
+    auto const fill_value = mesh.mesh2d.int_fill_value;
+
+    // The new index of each old node
+    auto const node_order = shuffled_indices(mesh.node_x.size());
+    std::vector<double> node_x(mesh.node_x.size());
+    std::vector<double> node_y(mesh.node_y.size());
+    for (size_t i = 0; i < node_order.size(); ++i)
+    {
+        node_x[node_order[i]] = mesh.node_x[i];
+        node_y[node_order[i]] = mesh.node_y[i];
+    }
+    std::copy(node_x.begin(), node_x.end(), mesh.node_x.begin());
+    std::copy(node_y.begin(), node_y.end(), mesh.node_y.begin());
+
+    auto const shuffle_rows = [&](std::vector<int>& values, size_t num_columns)
+    {
+        auto const row_order = shuffled_indices(values.size() / num_columns);
+        std::vector<int> shuffled(values.size());
+        for (size_t row = 0; row < row_order.size(); ++row)
+        {
+            for (size_t column = 0; column < num_columns; ++column)
+            {
+                auto const node = values[row * num_columns + column];
+                shuffled[row_order[row] * num_columns + column] = node == fill_value ? fill_value : node_order[node];
+            }
+        }
+        std::copy(shuffled.begin(), shuffled.end(), values.begin());
+    };
+    shuffle_rows(mesh.edge_nodes, 2);
+    shuffle_rows(mesh.face_nodes, num_face_nodes_max);
+}
+
+GeneratedNetwork1D generate_dendritic_network1d(std::string const& name, int num_edges, uint64_t seed)
+{
+    if (num_edges < 1)
+    {
+        throw std::invalid_argument("generate_dendritic_network1d: The number of branches must be positive.");
+    }
+
+    RandomGenerator random(seed);
+
+    GeneratedNetwork1D network;
+    network.name = make_name(name, ugrid::name_length);
+
+    auto const num_nodes = static_cast<size_t>(num_edges) + 1;
+    network.node_x.reserve(num_nodes);
+    network.node_y.reserve(num_nodes);
+    network.edge_nodes.reserve(2 * static_cast<size_t>(num_edges));
+    network.edge_length.reserve(num_edges);
+    network.geometry_nodes_x.reserve(3 * static_cast<size_t>(num_edges));
+    network.geometry_nodes_y.reserve(3 * static_cast<size_t>(num_edges));
+    network.num_edge_geometry_nodes.reserve(num_edges);
+
+    // The outlet, from which the branches grow upstream
+    std::vector<double> node_direction{std::numbers::pi / 2.0};
+    node_direction.reserve(num_nodes);
+    network.node_x.emplace_back(0.0);
+    network.node_y.emplace_back(0.0);
+
+    constexpr double max_deviation = std::numbers::pi / 3.0;
+    for (int e = 0; e < num_edges; ++e)
+    {
+        auto const parent = random.index(static_cast<int>(network.node_x.size()));
+        auto const direction = node_direction[parent] + random.uniform(-max_deviation, max_deviation);
+        auto const length = random.uniform(0.5, 1.5);
+
+        auto const start_x = network.node_x[parent];
+        auto const start_y = network.node_y[parent];
+        auto const end_x = start_x + length * std::cos(direction);
+        auto const end_y = start_y + length * std::sin(direction);
+
+        // A meander: the middle geometry node is shifted perpendicular to the branch
+        auto const shift = random.uniform(-0.2, 0.2) * length;
+        auto const middle_x = 0.5 * (start_x + end_x) - shift * std::sin(direction);
+        auto const middle_y = 0.5 * (start_y + end_y) + shift * std::cos(direction);
+
+        auto const child = static_cast<int>(network.node_x.size());
+        network.node_x.emplace_back(end_x);
+        network.node_y.emplace_back(end_y);
+        node_direction.emplace_back(direction);
+
+        network.edge_nodes.emplace_back(parent);
+        network.edge_nodes.emplace_back(child);
+        network.edge_length.emplace_back(std::hypot(middle_x - start_x, middle_y - start_y) +
+                                         std::hypot(end_x - middle_x, end_y - middle_y));
+        network.geometry_nodes_x.insert(network.geometry_nodes_x.end(), {start_x, middle_x, end_x});
+        network.geometry_nodes_y.insert(network.geometry_nodes_y.end(), {start_y, middle_y, end_y});
+        network.num_edge_geometry_nodes.emplace_back(3);
+    }
+
+    network.network1d.name = network.name.data();
+    network.network1d.node_x = network.node_x.data();
+    network.network1d.node_y = network.node_y.data();
+    network.network1d.num_nodes = static_cast<int>(network.node_x.size());
+    network.network1d.edge_nodes = network.edge_nodes.data();
+    network.network1d.edge_length = network.edge_length.data();
+    network.network1d.num_edges = num_edges;
+    network.network1d.geometry_nodes_x = network.geometry_nodes_x.data();
+    network.network1d.geometry_nodes_y = network.geometry_nodes_y.data();
+    network.network1d.num_edge_geometry_nodes = network.num_edge_geometry_nodes.data();
+    network.network1d.num_geometry_nodes = static_cast<int>(network.geometry_nodes_x.size());
+    return network;
+}
+
+GeneratedMesh1D generate_mesh1d(std::string const& name, GeneratedNetwork1D const& network, int nodes_per_edge)
+{
+    if (nodes_per_edge < 1)
+    {
+        throw std::invalid_argument("generate_mesh1d: The number of nodes per branch must be positive.");
+    }
+
+    GeneratedMesh1D mesh;
+    mesh.name = make_name(name, ugrid::name_length);
+    // The network name is stored as an attribute value, so it is not padded
+    std::string const network_name(network.name.data());
+    mesh.network_name.assign(network_name.begin(), network_name.begin() + static_cast<std::ptrdiff_t>(network_name.find_last_not_of(' ') + 1));
+    mesh.network_name.emplace_back('\0');
+
+    auto const num_edges = network.network1d.num_edges;
+    auto const num_nodes = 1 + static_cast<size_t>(nodes_per_edge) * num_edges;
+    mesh.node_x.reserve(num_nodes);
+    mesh.node_y.reserve(num_nodes);
+    mesh.node_edge_id.reserve(num_nodes);
+    mesh.node_edge_offset.reserve(num_nodes);
+    mesh.edge_nodes.reserve(2 * (num_nodes - 1));
+
+    // The outlet is the start of the first branch
+    std::vector<int> network_node_mesh_node(network.node_x.size(), -1);
+    network_node_mesh_node[0] = 0;
+    mesh.node_x.emplace_back(network.node_x[0]);
+    mesh.node_y.emplace_back(network.node_y[0]);
+    mesh.node_edge_id.emplace_back(0);
+    mesh.node_edge_offset.emplace_back(0.0);
+
+    for (int e = 0; e < num_edges; ++e)
+    {
+        // The three geometry nodes of the branch
+        auto const* const x = &network.geometry_nodes_x[3 * static_cast<size_t>(e)];
+        auto const* const y = &network.geometry_nodes_y[3 * static_cast<size_t>(e)];
+        auto const first_length = std::hypot(x[1] - x[0], y[1] - y[0]);
+        auto const second_length = std::hypot(x[2] - x[1], y[2] - y[1]);
+        auto const length = network.edge_length[e];
+
+        // Branches grow from nodes created earlier, so the start node already has a mesh node
+        auto previous = network_node_mesh_node[network.edge_nodes[2 * e]];
+        for (int k = 1; k <= nodes_per_edge; ++k)
+        {
+            auto const offset = length * k / nodes_per_edge;
+            if (offset <= first_length)
+            {
+                auto const t = offset / first_length;
+                mesh.node_x.emplace_back(x[0] + t * (x[1] - x[0]));
+                mesh.node_y.emplace_back(y[0] + t * (y[1] - y[0]));
+            }
+            else
+            {
+                auto const t = std::min(1.0, (offset - first_length) / second_length);
+                mesh.node_x.emplace_back(x[1] + t * (x[2] - x[1]));
+                mesh.node_y.emplace_back(y[1] + t * (y[2] - y[1]));
+            }
+            mesh.node_edge_id.emplace_back(e);
+            mesh.node_edge_offset.emplace_back(offset);
+
+            auto const node = static_cast<int>(mesh.node_x.size()) - 1;
+            mesh.edge_nodes.emplace_back(previous);
+            mesh.edge_nodes.emplace_back(node);
+            previous = node;
+        }
+        network_node_mesh_node[network.edge_nodes[2 * e + 1]] = previous;
+    }
+
+    mesh.mesh1d.name = mesh.name.data();
+    mesh.mesh1d.network_name = mesh.network_name.data();
+    mesh.mesh1d.node_x = mesh.node_x.data();
+    mesh.mesh1d.node_y = mesh.node_y.data();
+    mesh.mesh1d.node_edge_id = mesh.node_edge_id.data();
+    mesh.mesh1d.node_edge_offset = mesh.node_edge_offset.data();
+    mesh.mesh1d.num_nodes = static_cast<int>(mesh.node_x.size());
+    mesh.mesh1d.edge_nodes = mesh.edge_nodes.data();
+    mesh.mesh1d.num_edges = static_cast<int>(mesh.edge_nodes.size() / 2);
+    return mesh;
+}
+
+GeneratedContacts generate_contacts(std::string const& name,
+                                    GeneratedMesh1D const& mesh1d,
+                                    GeneratedMesh2D const& mesh2d,
+                                    int num_contacts,
+                                    uint64_t seed)
+{
+    if (num_contacts < 1)
+    {
+        throw std::invalid_argument("generate_contacts: The number of contacts must be positive.");
+    }
+
+    RandomGenerator random(seed);
+
+    GeneratedContacts contacts;
+    contacts.name = make_name(name, ugrid::name_length);
+    contacts.mesh_from_name = mesh1d.name;
+    contacts.mesh_to_name = mesh2d.name;
+
+    contacts.edges.reserve(2 * static_cast<size_t>(num_contacts));
+    for (int c = 0; c < num_contacts; ++c)
+    {
+        contacts.edges.emplace_back(random.index(mesh1d.mesh1d.num_nodes));
+        contacts.edges.emplace_back(random.index(mesh2d.mesh2d.num_faces));
+    }
+    // Lateral contacts
+    contacts.contact_type.assign(num_contacts, 3);
+
+    contacts.contacts.name = contacts.name.data();
+    contacts.contacts.mesh_from_name = contacts.mesh_from_name.data();
+    contacts.contacts.mesh_to_name = contacts.mesh_to_name.data();
+    contacts.contacts.mesh_from_location = ugridapi::MeshLocations::Nodes;
+    contacts.contacts.mesh_to_location = ugridapi::MeshLocations::Faces;
+    contacts.contacts.edges = contacts.edges.data();
+    contacts.contacts.contact_type = contacts.contact_type.data();
+    contacts.contacts.num_contacts = num_contacts;
+    return contacts;
+}